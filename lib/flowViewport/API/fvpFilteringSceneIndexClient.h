@@ -90,6 +90,17 @@ namespace FVP_NS_DEF
         */
         virtual PXR_NS::HdSceneIndexBaseRefPtr appendSceneIndex(const PXR_NS::HdSceneIndexBaseRefPtr& inputSceneIndex, const PXR_NS::HdContainerDataSourceHandle& inputArgs) = 0;
 
+        /**
+        *  @brief      Get the roots of the subtrees your scene indices can change.
+        *
+        *               When your filtering scene indices are hidden or shown, the scenes with and without them are compared under these paths only,
+        *               to notify the prims which differ. Prims outside of these subtrees must be passed through unchanged by your scene indices.
+        *               The default is the absolute root path, meaning the whole scene is compared, which costs a traversal of the scene.
+        * 
+        *  @return     The roots of the subtrees your scene indices can change.
+        */
+        virtual PXR_NS::SdfPathVector getAffectedPaths() const { return {PXR_NS::SdfPath::AbsoluteRootPath()}; }
+
         /// Destructor
         virtual ~FilteringSceneIndexClient() = default;
 
@@ -20,6 +20,7 @@
 #include <flowViewport/fvpUtils.h>
 #endif
 #include "flowViewport/sceneIndex/fvpRenderIndexProxy.h"
+#include "flowViewport/sceneIndex/fvpBypassSceneIndex.h"
 #include "flowViewport/API/interfacesImp/fvpFilteringSceneIndexInterfaceImp.h"
 #include "flowViewport/API/perViewportSceneIndicesData/fvpViewportInformationAndSceneIndicesPerViewportDataManager.h"
 
@@ -92,9 +93,21 @@ void FilteringSceneIndicesChainManager::destroyFilteringSceneIndicesChain(Viewpo
 #ifdef CODE_COVERAGE_WORKAROUND
     Fvp::leakSceneIndex(lastSceneIndex);
 #endif
+    viewportInformationAndSceneIndicesPerViewportData.GetFilteringSceneIndicesBypass().clear();
     lastSceneIndex.Reset();
 }
 
+bool FilteringSceneIndicesChainManager::_IsViewportUsingRenderers(  const ViewportInformationAndSceneIndicesPerViewportData& viewportInformationAndSceneIndicesPerViewportData,
+                                                                    const std::string& rendererDisplayNames)
+{
+    const std::string& rendererDisplayName = viewportInformationAndSceneIndicesPerViewportData.GetViewportInformation()._rendererName;
+    if ( (FvpViewportAPITokens->allRenderers != rendererDisplayNames) && (! rendererDisplayName.empty()) ){
+        //Filtering per renderer is applied
+        return std::string::npos != rendererDisplayNames.find(rendererDisplayName);
+    }
+    return true;
+}
+
 void FilteringSceneIndicesChainManager::updateFilteringSceneIndicesChain(const std::string& rendererDisplayNames)
 {
     /*  rendererDisplayName is a string containing either FvpViewportAPITokens->allRenderers meaning this should apply to all renderers 
@@ -108,12 +121,8 @@ void FilteringSceneIndicesChainManager::updateFilteringSceneIndicesChain(const s
     for (auto& viewportInformationAndSceneIndicesPerViewportData : allViewportInformationAndSceneIndicesPerViewport){
         
         //Check the renderer name
-        const std::string& rendererDisplayName = viewportInformationAndSceneIndicesPerViewportData.GetViewportInformation()._rendererName;
-        if ( (FvpViewportAPITokens->allRenderers != rendererDisplayNames) && (! rendererDisplayName.empty()) ){
-            //Filtering per renderer is applied
-            if (std::string::npos == rendererDisplayNames.find(rendererDisplayName)){
-                continue; //Ignore this filtering scene indices chain since the renderer is different
-            }
+        if (! _IsViewportUsingRenderers(viewportInformationAndSceneIndicesPerViewportData, rendererDisplayNames)){
+            continue; //Ignore this filtering scene indices chain since the renderer is different
         }
 
         const auto& renderIndexProxy = viewportInformationAndSceneIndicesPerViewportData.GetRenderIndexProxy();
@@ -125,6 +134,27 @@ void FilteringSceneIndicesChainManager::updateFilteringSceneIndicesChain(const s
     }
 }
 
+void FilteringSceneIndicesChainManager::updateFilteringSceneIndicesVisibility(const std::string& rendererDisplayNames)
+{
+    ViewportInformationAndSceneIndicesPerViewportDataVector& allViewportInformationAndSceneIndicesPerViewport =
+            ViewportInformationAndSceneIndicesPerViewportDataManager::Get().GetAllViewportInfoAndData();
+
+    const auto& viewportFilteringSceneIndicesData = FilteringSceneIndexInterfaceImp::get().getSceneFilteringSceneIndicesData();
+    for (auto& viewportInformationAndSceneIndicesPerViewportData : allViewportInformationAndSceneIndicesPerViewport){
+        if (! _IsViewportUsingRenderers(viewportInformationAndSceneIndicesPerViewportData, rendererDisplayNames)){
+            continue; //Ignore this filtering scene indices chain since the renderer is different
+        }
+
+        auto& filteringSceneIndicesBypass = viewportInformationAndSceneIndicesPerViewportData.GetFilteringSceneIndicesBypass();
+        for (const auto& filteringSceneIndexData : viewportFilteringSceneIndicesData) {
+            auto findResult = filteringSceneIndicesBypass.find(get_pointer(filteringSceneIndexData));
+            if (findResult != filteringSceneIndicesBypass.end()){
+                findResult->second->SetBypassed(! filteringSceneIndexData->GetVisibility());
+            }
+        }
+    }
+}
+
 void FilteringSceneIndicesChainManager::_AppendFilteringSceneIndicesChain(  ViewportInformationAndSceneIndicesPerViewportData& viewportInformationAndSceneIndicesPerViewportData, 
                                                                             const HdSceneIndexBaseRefPtr& inputScene)
 {
@@ -138,6 +168,9 @@ void FilteringSceneIndicesChainManager::_AppendFilteringSceneIndicesChain(  View
     //Set the merging scene index as the last element to use this scene index as the input scene index of filtering scene indices
     lastSceneIndex                            = inputScene;
 
+    auto& filteringSceneIndicesBypass = viewportInformationAndSceneIndicesPerViewportData.GetFilteringSceneIndicesBypass();
+    filteringSceneIndicesBypass.clear();
+
     //Call our Hydra viewport API mechanism for custom filtering scene index clients
     const auto& viewportFilteringSceneIndicesData = FilteringSceneIndexInterfaceImp::get().getSceneFilteringSceneIndicesData();
     for (const auto& filteringSceneIndexData : viewportFilteringSceneIndicesData) {
@@ -149,15 +182,16 @@ void FilteringSceneIndicesChainManager::_AppendFilteringSceneIndicesChain(  View
             continue;
         }
 
+        //Not visible filtering scene indices are appended as well but bypassed, so that changing their visibility 
+        //does not require to re-create the chain
         const bool isVisible = filteringSceneIndexData->GetVisibility();
-        if (! isVisible){
-            continue; //We should not append not visible filtering scene indices
-        }
 
         auto tempAppendedSceneIndex = client->appendSceneIndex(lastSceneIndex, _inputArgs);
         if ((lastSceneIndex != tempAppendedSceneIndex)){
             //A new scene index was appended, it can also be a chain of scene indices but we need only the last element
-            lastSceneIndex = tempAppendedSceneIndex;
+            auto bypassSceneIndex = BypassSceneIndex::New(tempAppendedSceneIndex, lastSceneIndex, ! isVisible, client->getAffectedPaths());
+            filteringSceneIndicesBypass[get_pointer(filteringSceneIndexData)] = bypassSceneIndex;
+            lastSceneIndex = bypassSceneIndex;
         }
     }
 }
@@ -72,11 +72,28 @@ public:
     */
     void updateFilteringSceneIndicesChain(const std::string& rendererDisplayNames);
 
+    /**
+    *  @brief       Update the filtering scene indices chains after the visibility of some FilteringSceneIndexClients changed.
+    *
+    *               Hidden filtering scene indices are bypassed rather than removed from the chain, so only the prims 
+    *               which differ between the filtered and unfiltered scenes are notified to the render index.
+    *               The chains are not re-created, as opposed to updateFilteringSceneIndicesChain.
+    * 
+    *  @param[in]   rendererDisplayNames is a string containing either nothing ("") meaning this should apply to all renderers 
+    *               or it contains one or more renderers display names such as ("GL, Arnold") and in this case we must update 
+    *               only the viewports filtering scene indices chain which are using this renderer.
+    */
+    void updateFilteringSceneIndicesVisibility(const std::string& rendererDisplayNames);
+
     // For debugging purpose : enable/disable the filtering scene indices chain as a global switch.
     void setEnabled(bool enabled);
     bool getEnabled()const {return _enabled;}
 
 private:
+    /// Return true if the viewport uses one of the renderers from rendererDisplayNames.
+    static bool _IsViewportUsingRenderers(  const ViewportInformationAndSceneIndicesPerViewportData& viewportInformationAndSceneIndicesPerViewportData,
+                                            const std::string& rendererDisplayNames);
+
     /**
     *   @brief  Create the filtering scene indices chain for this viewport. 
     *   @param[in] viewportInformationAndSceneIndicesPerViewportData is the ViewportInformationAndSceneIndicesPerViewportData from the hydra viewport.
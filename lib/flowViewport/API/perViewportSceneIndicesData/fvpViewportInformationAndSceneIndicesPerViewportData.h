@@ -21,7 +21,12 @@
 #include "flowViewport/api.h"
 #include "flowViewport/API/fvpInformationInterface.h"
 #include "flowViewport/sceneIndex/fvpRenderIndexProxyFwd.h"
+#include "flowViewport/sceneIndex/fvpBypassSceneIndex.h"
 #include "fvpDataProducerSceneIndexDataBase.h"
+#include "fvpFilteringSceneIndexDataBase.h"
+
+//Std headers
+#include <map>
 
 namespace FVP_NS_DEF {
 
@@ -32,6 +37,9 @@ namespace FVP_NS_DEF {
 class ViewportInformationAndSceneIndicesPerViewportData
 {
 public:
+    ///Bypass scene index appended after each custom filtering scene index of the chain, per filtering scene index data
+    using FilteringSceneIndicesBypass = std::map<const PXR_NS::FVP_NS_DEF::FilteringSceneIndexDataBase*, BypassSceneIndexRefPtr>;
+
     ViewportInformationAndSceneIndicesPerViewportData(const InformationInterface::ViewportInformation& viewportInformation, 
                                                       const Fvp::RenderIndexProxyPtr& renderIndexProxy);
     ~ViewportInformationAndSceneIndicesPerViewportData();
@@ -39,6 +47,7 @@ public:
     const InformationInterface::ViewportInformation& GetViewportInformation()const { return _viewportInformation;}
     PXR_NS::HdSceneIndexBaseRefPtr& GetLastFilteringSceneIndex() {return _lastFilteringSceneIndex;}
     const PXR_NS::HdSceneIndexBaseRefPtr& GetLastFilteringSceneIndex() const {return _lastFilteringSceneIndex;}
+    FilteringSceneIndicesBypass& GetFilteringSceneIndicesBypass() {return _filteringSceneIndicesBypass;}
     const Fvp::RenderIndexProxyPtr GetRenderIndexProxy() const {return _renderIndexProxy;}
     void SetInputSceneIndex(const PXR_NS::HdSceneIndexBaseRefPtr& inputSceneIndex) {_inputSceneIndex = inputSceneIndex;}
     const PXR_NS::HdSceneIndexBaseRefPtr&   GetInputSceneIndex() const {return _inputSceneIndex;}
@@ -52,6 +61,7 @@ public:
         _dataProducerSceneIndicesData = other._dataProducerSceneIndicesData;
         _inputSceneIndex = other._inputSceneIndex;
         _lastFilteringSceneIndex = other._lastFilteringSceneIndex;
+        _filteringSceneIndicesBypass = other._filteringSceneIndicesBypass;
         _renderIndexProxy = other._renderIndexProxy;
         return *this;
     }
@@ -68,6 +78,9 @@ private:
 
     /// The last scene index of the custom filtering scene indices chain for this viewport
     PXR_NS::HdSceneIndexBaseRefPtr                                          _lastFilteringSceneIndex {nullptr};
+
+    ///Lets the custom filtering scene indices be hidden or shown without re-creating the chain
+    FilteringSceneIndicesBypass                                             _filteringSceneIndicesBypass;
     
     ///Is a render index proxy per viewport to avoid accessing directly the render index
     Fvp::RenderIndexProxyPtr                                                _renderIndexProxy {nullptr};
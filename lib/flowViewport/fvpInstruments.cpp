@@ -17,12 +17,92 @@
 
 #include <pxr/base/vt/dictionary.h>
 
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <sstream>
+
 namespace {
+
+using Counter = FVP_NS_DEF::Instruments::Counter;
+using Clock = std::chrono::steady_clock;
+
+constexpr size_t kNbFramesHistory = FVP_NS_DEF::Instruments::kNbFramesHistory;
+
+std::mutex           instrumentsMutex;
 PXR_NS::VtDictionary instruments;
+
+// Counters are never destroyed, so that references to them remain valid.
+std::mutex                                      countersMutex;
+std::map<std::string, std::unique_ptr<Counter>> allCounters;
+
+std::atomic<size_t> nbCompletedFrames { 0 };
+
+struct TraceEvent
+{
+    const Counter* counter;
+    int            threadId;
+    Clock::time_point start;
+    Clock::time_point end;
+};
+
+std::atomic_bool                                  tracing { false };
+std::mutex                                        traceMutex;
+// Trace events of the last frames, indexed by frame number modulo the history size.
+std::array<std::vector<TraceEvent>, kNbFramesHistory> traceFrames;
+const Clock::time_point                           traceOrigin = Clock::now();
+
+// Small consecutive thread identifiers are easier to read in trace viewers.
+int traceThreadId()
+{
+    static std::atomic_int nextThreadId { 1 };
+    thread_local const int threadId = nextThreadId++;
+    return threadId;
+}
+
+double toMicroseconds(Clock::duration duration)
+{
+    return std::chrono::duration<double, std::micro>(duration).count();
+}
+
+std::string jsonEscape(const std::string& str)
+{
+    std::string escaped;
+    escaped.reserve(str.size());
+    for (const char c : str) {
+        if (c == '"' || c == '\\') {
+            escaped += '\\';
+        }
+        escaped += c;
+    }
+    return escaped;
 }
 
+} // namespace
+
 namespace FVP_NS_DEF {
 
+int64_t Instruments::Counter::frameValue(size_t age) const
+{
+    const size_t nbFrames = nbCompletedFrames.load();
+    if (age >= nbFrames || age >= kNbFramesHistory) {
+        return 0;
+    }
+    return _history[(nbFrames - 1 - age) % kNbFramesHistory];
+}
+
+Instruments::ScopedTimer::~ScopedTimer()
+{
+    const auto end = std::chrono::steady_clock::now();
+    _counter.add(std::chrono::duration_cast<std::chrono::nanoseconds>(end - _start).count());
+    if (tracing.load(std::memory_order_relaxed)) {
+        Instruments::instance()._addTraceEvent(_counter, _start, end);
+    }
+}
+
 /* static */
 Instruments& Instruments::instance()
 {
@@ -32,13 +112,157 @@ Instruments& Instruments::instance()
 
 PXR_NS::VtValue Instruments::get(const std::string& key) const
 {
+    std::lock_guard<std::mutex> lock(instrumentsMutex);
     auto found = instruments.find(key);
     return (found != instruments.end()) ? found->second : PXR_NS::VtValue();
 }
 
 void Instruments::set(const std::string& key, const PXR_NS::VtValue& v)
 {
+    std::lock_guard<std::mutex> lock(instrumentsMutex);
     instruments[key] = v;
 }
 
+Instruments::Counter& Instruments::counter(const std::string& name, Counter::Unit unit)
+{
+    std::lock_guard<std::mutex> lock(countersMutex);
+    auto& counter = allCounters[name];
+    if (!counter) {
+        counter.reset(new Counter(name, unit));
+    }
+    return *counter;
+}
+
+const Instruments::Counter* Instruments::findCounter(const std::string& name) const
+{
+    std::lock_guard<std::mutex> lock(countersMutex);
+    auto found = allCounters.find(name);
+    return (found != allCounters.end()) ? found->second.get() : nullptr;
+}
+
+std::vector<const Instruments::Counter*> Instruments::counters() const
+{
+    std::lock_guard<std::mutex>  lock(countersMutex);
+    std::vector<const Counter*> result;
+    result.reserve(allCounters.size());
+    for (const auto& entry : allCounters) {
+        result.push_back(entry.second.get());
+    }
+    return result;
+}
+
+void Instruments::endFrame()
+{
+    const size_t frame = nbCompletedFrames.load();
+    {
+        std::lock_guard<std::mutex> lock(countersMutex);
+        for (auto& entry : allCounters) {
+            Counter& counter = *entry.second;
+            counter._history[frame % kNbFramesHistory] = counter._current.exchange(0);
+        }
+    }
+    nbCompletedFrames = frame + 1;
+
+    // Make room for the trace events of the new frame.
+    std::lock_guard<std::mutex> lock(traceMutex);
+    traceFrames[(frame + 1) % kNbFramesHistory].clear();
+}
+
+size_t Instruments::nbFrames() const
+{
+    return nbCompletedFrames.load();
+}
+
+std::string Instruments::report() const
+{
+    const size_t nbHistoryFrames = std::min(nbFrames(), kNbFramesHistory);
+
+    std::ostringstream out;
+    out << "Last " << nbHistoryFrames << " frames : last / average / min / max\n";
+    out << std::fixed;
+    for (const Counter* counter : counters()) {
+        int64_t total = 0;
+        int64_t minValue = 0;
+        int64_t maxValue = 0;
+        for (size_t age = 0; age < nbHistoryFrames; ++age) {
+            const int64_t value = counter->frameValue(age);
+            total += value;
+            minValue = (age == 0) ? value : std::min(minValue, value);
+            maxValue = (age == 0) ? value : std::max(maxValue, value);
+        }
+        const double average = nbHistoryFrames ? double(total) / nbHistoryFrames : 0.0;
+
+        out << counter->name() << " : ";
+        if (counter->unit() == Counter::Unit::Nanoseconds) {
+            // Times are reported in ms.
+            constexpr double nsToMs = 1e-6;
+            out << std::setprecision(3) << counter->frameValue(0) * nsToMs << " / "
+                << average * nsToMs << " / " << minValue * nsToMs << " / " << maxValue * nsToMs
+                << " ms\n";
+        } else {
+            out << counter->frameValue(0) << " / " << std::setprecision(1) << average << " / "
+                << minValue << " / " << maxValue << "\n";
+        }
+    }
+    return out.str();
+}
+
+void Instruments::setTracing(bool enable)
+{
+    if (enable && !tracing) {
+        std::lock_guard<std::mutex> lock(traceMutex);
+        for (auto& events : traceFrames) {
+            events.clear();
+        }
+    }
+    tracing = enable;
+}
+
+bool Instruments::isTracing() const
+{
+    return tracing;
+}
+
+void Instruments::_addTraceEvent(
+    const Counter&                        counter,
+    std::chrono::steady_clock::time_point start,
+    std::chrono::steady_clock::time_point end)
+{
+    const int                   threadId = traceThreadId();
+    std::lock_guard<std::mutex> lock(traceMutex);
+    traceFrames[nbCompletedFrames.load() % kNbFramesHistory].push_back({ &counter, threadId, start, end });
+}
+
+bool Instruments::writeChromeTrace(const std::string& filePath) const
+{
+    std::ofstream file(filePath);
+    if (!file) {
+        return false;
+    }
+
+    // Complete events ("ph":"X"), with times in microseconds. Frames are
+    // written from the oldest one, the current one being the newest.
+    file << "{\"traceEvents\":[";
+    bool first = true;
+    {
+        std::lock_guard<std::mutex> lock(traceMutex);
+        const size_t                currentFrame = nbCompletedFrames.load();
+        for (size_t i = 0; i < kNbFramesHistory; ++i) {
+            const auto& events = traceFrames[(currentFrame + 1 + i) % kNbFramesHistory];
+            for (const auto& event : events) {
+                file << (first ? "\n" : ",\n") << "{\"name\":\""
+                     << jsonEscape(event.counter->name())
+                     << "\",\"cat\":\"flowViewport\",\"ph\":\"X\",\"pid\":1,\"tid\":"
+                     << event.threadId << std::fixed << std::setprecision(3)
+                     << ",\"ts\":" << toMicroseconds(event.start - traceOrigin)
+                     << ",\"dur\":" << toMicroseconds(event.end - event.start) << "}";
+                first = false;
+            }
+        }
+    }
+    file << "\n],\"displayTimeUnit\":\"ms\"}\n";
+
+    return bool(file);
+}
+
 } // namespace FVP_NS_DEF
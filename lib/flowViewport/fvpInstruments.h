@@ -19,7 +19,12 @@
 
 #include <pxr/base/vt/value.h>
 
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
 #include <string>
+#include <vector>
 
 namespace FVP_NS_DEF {
 
@@ -27,10 +32,81 @@ namespace FVP_NS_DEF {
 ///
 /// A registry to measure Flow Viewport processing.
 ///
+/// Besides named values (get() / set()), it provides counters and scoped
+/// timers which can be updated from any thread without locking. Their values
+/// are accumulated during a frame, and kept for the last kNbFramesHistory
+/// frames when endFrame() is called. Scoped timers can also record trace
+/// events, which can be exported in the Chrome trace event format
+/// (chrome://tracing, or https://ui.perfetto.dev).
+///
 class Instruments
 {
 public:
 
+    /// Number of frames for which counter values are kept.
+    static constexpr size_t kNbFramesHistory = 128;
+
+    /// \class Counter
+    ///
+    /// A value accumulated during a frame. Timers are counters of nanoseconds.
+    ///
+    class Counter
+    {
+    public:
+        enum class Unit { Count, Nanoseconds };
+
+        const std::string& name() const { return _name; }
+        Unit unit() const { return _unit; }
+
+        /// Add to the value of the current frame. Lock-free, thread safe.
+        void add(int64_t value = 1) { _current.fetch_add(value, std::memory_order_relaxed); }
+
+        /// Value accumulated so far during the current frame.
+        int64_t current() const { return _current.load(std::memory_order_relaxed); }
+
+        /// Value of a completed frame, age 0 being the last completed frame.
+        /// Returns 0 for frames older than the history.
+        FVP_API
+        int64_t frameValue(size_t age) const;
+
+    private:
+        friend class Instruments;
+
+        Counter(const std::string& name, Unit unit) : _name(name), _unit(unit) {}
+
+        const std::string                    _name;
+        const Unit                           _unit;
+        std::atomic<int64_t>                 _current { 0 };
+        // Values of the last completed frames, indexed by frame number modulo
+        // the history size. Only written by endFrame().
+        std::array<int64_t, kNbFramesHistory> _history {};
+    };
+
+    /// \class ScopedTimer
+    ///
+    /// Adds the time spent in its scope to a counter, and records a trace
+    /// event if tracing is enabled. Use the FVP_INSTRUMENTS_SCOPED_TIMER macro
+    /// to only look the counter up once.
+    ///
+    class ScopedTimer
+    {
+    public:
+        explicit ScopedTimer(Counter& counter)
+            : _counter(counter), _start(std::chrono::steady_clock::now())
+        {
+        }
+
+        FVP_API
+        ~ScopedTimer();
+
+        ScopedTimer(const ScopedTimer&) = delete;
+        ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+    private:
+        Counter&                                    _counter;
+        const std::chrono::steady_clock::time_point _start;
+    };
+
     FVP_API
     static Instruments& instance();
 
@@ -39,11 +115,69 @@ public:
     FVP_API
     void set(const std::string& key, const PXR_NS::VtValue& v);
 
+    /// Return the counter with the given name, creating it if needed. The
+    /// counter lives until the end of the process, so the returned reference
+    /// can be kept.
+    FVP_API
+    Counter& counter(const std::string& name, Counter::Unit unit = Counter::Unit::Count);
+
+    /// Return the counter with the given name, or nullptr if it does not exist.
+    FVP_API
+    const Counter* findCounter(const std::string& name) const;
+
+    /// Return all the counters, sorted by name.
+    FVP_API
+    std::vector<const Counter*> counters() const;
+
+    /// Complete the current frame : counter values are moved to their history.
+    /// Must be called from the main thread.
+    FVP_API
+    void endFrame();
+
+    /// Number of completed frames.
+    FVP_API
+    size_t nbFrames() const;
+
+    /// Human readable summary of the counters over the frames history : value
+    /// of the last frame, average, minimum and maximum. Times are in ms.
+    FVP_API
+    std::string report() const;
+
+    /// Enable or disable the recording of trace events by scoped timers.
+    /// Enabling tracing clears the previously recorded events. Events are
+    /// kept for the last kNbFramesHistory frames.
+    FVP_API
+    void setTracing(bool enable);
+    FVP_API
+    bool isTracing() const;
+
+    /// Write the recorded trace events to a Chrome trace event format JSON
+    /// file. Returns false if the file could not be written.
+    FVP_API
+    bool writeChromeTrace(const std::string& filePath) const;
+
 private:
 
     Instruments() = default;
+
+    friend class ScopedTimer;
+    void _addTraceEvent(
+        const Counter&                        counter,
+        std::chrono::steady_clock::time_point start,
+        std::chrono::steady_clock::time_point end);
 };
 
 } // namespace FVP_NS_DEF
 
+// Time the rest of the enclosing scope into the named counter.
+#define FVP_INSTRUMENTS_SCOPED_TIMER(name) FVP_INSTRUMENTS_SCOPED_TIMER_IMPL(name, __LINE__)
+#define FVP_INSTRUMENTS_SCOPED_TIMER_IMPL(name, line)                                   \
+    static FVP_NS::Instruments::Counter& FVP_INSTRUMENTS_CONCAT(_fvpTimerCounter, line) \
+        = FVP_NS::Instruments::instance().counter(                                      \
+            name, FVP_NS::Instruments::Counter::Unit::Nanoseconds);                     \
+    FVP_NS::Instruments::ScopedTimer FVP_INSTRUMENTS_CONCAT(_fvpTimer, line)(            \
+        FVP_INSTRUMENTS_CONCAT(_fvpTimerCounter, line))
+#define FVP_INSTRUMENTS_CONCAT(a, b) FVP_INSTRUMENTS_CONCAT_IMPL(a, b)
+#define FVP_INSTRUMENTS_CONCAT_IMPL(a, b) a##b
+
 #endif // FVP_INSTRUMENTS
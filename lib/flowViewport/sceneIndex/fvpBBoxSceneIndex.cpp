@@ -16,6 +16,7 @@
 
 //Local headers
 #include "fvpBBoxSceneIndex.h"
+#include "flowViewport/fvpInstruments.h"
 #include "flowViewport/fvpUtils.h"
 
 //USD/Hydra headers
@@ -370,6 +371,7 @@ HdSceneIndexPrim BboxSceneIndex::GetPrim(const SdfPath& primPath) const
 
 void BboxSceneIndex::_PrimsAdded(const HdSceneIndexBase& sender, const HdSceneIndexObserver::AddedPrimEntries& entries)
 {
+    FVP_INSTRUMENTS_SCOPED_TIMER("BboxSceneIndex:_PrimsAdded");
     if (!_IsObserved())return;
 
     HdSceneIndexObserver::AddedPrimEntries newEntries;
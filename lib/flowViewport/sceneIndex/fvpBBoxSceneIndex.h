@@ -18,6 +18,7 @@
 
 //Local headers
 #include "flowViewport/api.h"
+#include "flowViewport/fvpInstruments.h"
 #include "flowViewport/sceneIndex/fvpSceneIndexUtils.h"
 #include "flowViewport/fvpWireframeColorInterface.h"
 
@@ -76,6 +77,7 @@ protected:
         _SendPrimsRemoved(entries);
     }
     void _PrimsDirtied(const PXR_NS::HdSceneIndexBase& sender, const PXR_NS::HdSceneIndexObserver::DirtiedPrimEntries& entries)override{
+        FVP_INSTRUMENTS_SCOPED_TIMER("BboxSceneIndex:_PrimsDirtied");
         if (!_IsObserved())return;
         _SendPrimsDirtied(entries);
     }
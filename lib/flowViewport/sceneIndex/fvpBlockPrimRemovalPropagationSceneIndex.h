@@ -18,6 +18,7 @@
 
 //Local headers
 #include "flowViewport/api.h"
+#include "flowViewport/fvpInstruments.h"
 #include "flowViewport/sceneIndex/fvpSceneIndexUtils.h"
 #include "flowViewport/selection/fvpSelectionFwd.h"
 #include "flowViewport/sceneIndex/fvpPathInterface.h"
@@ -80,11 +81,13 @@ protected:
 
     //From HdSingleInputFilteringSceneIndexBase
     void _PrimsAdded(const PXR_NS::HdSceneIndexBase& sender, const PXR_NS::HdSceneIndexObserver::AddedPrimEntries& entries) override{
+        FVP_INSTRUMENTS_SCOPED_TIMER("BlockPrimRemovalPropagationSceneIndex:_PrimsAdded");
         if (!_IsObserved())return;
         _SendPrimsAdded(entries);
     }
     
     void _PrimsDirtied(const PXR_NS::HdSceneIndexBase& sender, const PXR_NS::HdSceneIndexObserver::DirtiedPrimEntries& entries)override{
+        FVP_INSTRUMENTS_SCOPED_TIMER("BlockPrimRemovalPropagationSceneIndex:_PrimsDirtied");
         if (!_IsObserved())return;
         _SendPrimsDirtied(entries);
     }
@@ -0,0 +1,209 @@
+//
+// Copyright 2024 Autodesk
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+//Local headers
+#include "fvpBypassSceneIndex.h"
+#include "flowViewport/fvpInstruments.h"
+
+//Hydra headers
+#include <pxr/imaging/hd/sceneIndexPrimView.h>
+
+//Std headers
+#include <algorithm>
+
+PXR_NAMESPACE_USING_DIRECTIVE
+
+namespace {
+
+using AddedPrimEntries = HdSceneIndexObserver::AddedPrimEntries;
+using RemovedPrimEntries = HdSceneIndexObserver::RemovedPrimEntries;
+using DirtiedPrimEntries = HdSceneIndexObserver::DirtiedPrimEntries;
+
+void _AddSubtree(const HdSceneIndexBaseRefPtr& sceneIndex, const SdfPath& path, AddedPrimEntries& added)
+{
+    for (const SdfPath& primPath : HdSceneIndexPrimView(sceneIndex, path)) {
+        added.emplace_back(primPath, sceneIndex->GetPrim(primPath).primType);
+    }
+}
+
+// Compare the subtrees at path in the previous and current scenes, and record the notices which
+// bring an observer of the previous scene up to date with the current one. Prims whose type and
+// data source are unchanged (the filtering scene index passed them through) are not notified.
+void _DiffSubtrees(
+    const HdSceneIndexBaseRefPtr& previous,
+    const HdSceneIndexBaseRefPtr& current,
+    const SdfPath&                path,
+    AddedPrimEntries&             added,
+    RemovedPrimEntries&           removed,
+    DirtiedPrimEntries&           dirtied,
+    size_t&                       nbComparedPrims)
+{
+    ++nbComparedPrims;
+    const HdSceneIndexPrim previousPrim = previous->GetPrim(path);
+    const HdSceneIndexPrim currentPrim = current->GetPrim(path);
+    if (previousPrim.primType != currentPrim.primType) {
+        added.emplace_back(path, currentPrim.primType);
+    } else if (previousPrim.dataSource != currentPrim.dataSource) {
+        dirtied.emplace_back(path, HdDataSourceLocatorSet::UniversalSet());
+    }
+
+    SdfPathVector previousChildren = previous->GetChildPrimPaths(path);
+    SdfPathVector currentChildren = current->GetChildPrimPaths(path);
+    std::sort(previousChildren.begin(), previousChildren.end());
+    std::sort(currentChildren.begin(), currentChildren.end());
+
+    for (const SdfPath& child : currentChildren) {
+        if (std::binary_search(previousChildren.begin(), previousChildren.end(), child)) {
+            _DiffSubtrees(previous, current, child, added, removed, dirtied, nbComparedPrims);
+        } else {
+            _AddSubtree(current, child, added);
+        }
+    }
+    for (const SdfPath& child : previousChildren) {
+        if (!std::binary_search(currentChildren.begin(), currentChildren.end(), child)) {
+            removed.emplace_back(child);
+        }
+    }
+}
+
+bool _PrimExists(const HdSceneIndexBaseRefPtr& sceneIndex, const SdfPath& path)
+{
+    const HdSceneIndexPrim prim = sceneIndex->GetPrim(path);
+    return prim.dataSource || !prim.primType.IsEmpty() || !sceneIndex->GetChildPrimPaths(path).empty();
+}
+
+// Same as _DiffSubtrees, for a subtree root which may exist in only one of the scenes.
+void _DiffAffectedSubtree(
+    const HdSceneIndexBaseRefPtr& previous,
+    const HdSceneIndexBaseRefPtr& current,
+    const SdfPath&                path,
+    AddedPrimEntries&             added,
+    RemovedPrimEntries&           removed,
+    DirtiedPrimEntries&           dirtied,
+    size_t&                       nbComparedPrims)
+{
+    if (!path.IsAbsoluteRootPath()) {
+        const bool existed = _PrimExists(previous, path);
+        const bool exists = _PrimExists(current, path);
+        if (existed != exists) {
+            ++nbComparedPrims;
+            if (exists) {
+                _AddSubtree(current, path, added);
+            } else {
+                removed.emplace_back(path);
+            }
+            return;
+        }
+    }
+    _DiffSubtrees(previous, current, path, added, removed, dirtied, nbComparedPrims);
+}
+
+} // namespace
+
+namespace FVP_NS_DEF {
+
+BypassSceneIndex::BypassSceneIndex(const HdSceneIndexBaseRefPtr& filteredSceneIndex,
+                                   const HdSceneIndexBaseRefPtr& bypassSceneIndex,
+                                   bool bypassed,
+                                   const SdfPathVector& affectedPaths)
+    : _filteredSceneIndex(filteredSceneIndex)
+    , _bypassSceneIndex(bypassSceneIndex)
+    , _bypassed(bypassed)
+    , _affectedPaths(affectedPaths)
+    , _filteredSceneObserver(*this, false)
+    , _bypassSceneObserver(*this, true)
+{
+    TF_AXIOM(_filteredSceneIndex && _bypassSceneIndex);
+
+    // A path nested in another affected path is compared with it.
+    SdfPath::RemoveDescendentPaths(&_affectedPaths);
+    _filteredSceneIndex->AddObserver(HdSceneIndexObserverPtr(&_filteredSceneObserver));
+    _bypassSceneIndex->AddObserver(HdSceneIndexObserverPtr(&_bypassSceneObserver));
+}
+
+BypassSceneIndex::~BypassSceneIndex()
+{
+    _filteredSceneIndex->RemoveObserver(HdSceneIndexObserverPtr(&_filteredSceneObserver));
+    _bypassSceneIndex->RemoveObserver(HdSceneIndexObserverPtr(&_bypassSceneObserver));
+}
+
+void BypassSceneIndex::SetBypassed(bool bypassed)
+{
+    if (_bypassed == bypassed) {
+        return;
+    }
+
+    FVP_INSTRUMENTS_SCOPED_TIMER("BypassSceneIndex:SetBypassed");
+
+    const HdSceneIndexBaseRefPtr previousSceneIndex = _GetActiveSceneIndex();
+    _bypassed = bypassed;
+    if (!_IsObserved()) {
+        return;
+    }
+
+    AddedPrimEntries   added;
+    RemovedPrimEntries removed;
+    DirtiedPrimEntries dirtied;
+    size_t             nbComparedPrims = 0;
+    for (const SdfPath& affectedPath : _affectedPaths) {
+        _DiffAffectedSubtree(previousSceneIndex, _GetActiveSceneIndex(), affectedPath, added, removed, dirtied, nbComparedPrims);
+    }
+
+    static auto& nbComparedPrimsCounter = Fvp::Instruments::instance().counter("BypassSceneIndex:NbComparedPrims");
+    nbComparedPrimsCounter.add(nbComparedPrims);
+    static auto& nbNotifiedPrims = Fvp::Instruments::instance().counter("BypassSceneIndex:NbNotifiedPrims");
+    nbNotifiedPrims.add(added.size() + removed.size() + dirtied.size());
+
+    if (!removed.empty()) {
+        _SendPrimsRemoved(removed);
+    }
+    if (!added.empty()) {
+        _SendPrimsAdded(added);
+    }
+    if (!dirtied.empty()) {
+        _SendPrimsDirtied(dirtied);
+    }
+}
+
+void BypassSceneIndex::_Observer::PrimsAdded(const HdSceneIndexBase& sender, const AddedPrimEntries& entries)
+{
+    if (_IsActive() && _owner._IsObserved()) {
+        _owner._SendPrimsAdded(entries);
+    }
+}
+
+void BypassSceneIndex::_Observer::PrimsRemoved(const HdSceneIndexBase& sender, const RemovedPrimEntries& entries)
+{
+    if (_IsActive() && _owner._IsObserved()) {
+        _owner._SendPrimsRemoved(entries);
+    }
+}
+
+void BypassSceneIndex::_Observer::PrimsDirtied(const HdSceneIndexBase& sender, const DirtiedPrimEntries& entries)
+{
+    if (_IsActive() && _owner._IsObserved()) {
+        _owner._SendPrimsDirtied(entries);
+    }
+}
+
+void BypassSceneIndex::_Observer::PrimsRenamed(const HdSceneIndexBase& sender, const RenamedPrimEntries& entries)
+{
+    if (_IsActive() && _owner._IsObserved()) {
+        _owner._SendPrimsRenamed(entries);
+    }
+}
+
+}//end of namespace FVP_NS_DEF
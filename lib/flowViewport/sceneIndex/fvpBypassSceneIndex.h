@@ -0,0 +1,131 @@
+//
+// Copyright 2024 Autodesk
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#ifndef FLOW_VIEWPORT_SCENEINDEX_FVP_BYPASS_SCENE_INDEX_H
+#define FLOW_VIEWPORT_SCENEINDEX_FVP_BYPASS_SCENE_INDEX_H
+
+//Local headers
+#include "flowViewport/api.h"
+
+//Hydra headers
+#include <pxr/imaging/hd/filteringSceneIndex.h>
+
+namespace FVP_NS_DEF {
+
+class BypassSceneIndex;
+typedef PXR_NS::TfRefPtr<BypassSceneIndex> BypassSceneIndexRefPtr;
+typedef PXR_NS::TfRefPtr<const BypassSceneIndex> BypassSceneIndexConstRefPtr;
+
+/// \class BypassSceneIndex
+///
+/// A scene index placed after a custom filtering scene index, which outputs either the filtered
+/// scene (the output of the filtering scene index) or the bypass scene (the input of the filtering
+/// scene index). When bypassed, the filtering scene index acts as an identity node.
+/// Toggling the bypass compares both scenes and only notifies the prims which differ, so hiding or
+/// showing a filter does not require removing and re-inserting the whole chain in the render index.
+///
+/// Cost : a toggle calls GetPrim and GetChildPrimPaths on both scenes for every prim under the
+/// affected paths, the roots of the subtrees the filter can change. They default to the absolute
+/// root, i.e. the whole scene is compared, so filters which only change a part of the scene should
+/// declare it (see FilteringSceneIndexClient::getAffectedPaths). While bypassed, the filtering
+/// scene index still observes and processes the notices of its input, this scene index only
+/// ignores its output.
+class BypassSceneIndex : public PXR_NS::HdFilteringSceneIndexBase
+{
+public:
+    FVP_API
+    static BypassSceneIndexRefPtr New(const PXR_NS::HdSceneIndexBaseRefPtr& filteredSceneIndex,
+                                      const PXR_NS::HdSceneIndexBaseRefPtr& bypassSceneIndex,
+                                      bool bypassed,
+                                      const PXR_NS::SdfPathVector& affectedPaths = {PXR_NS::SdfPath::AbsoluteRootPath()}){
+        return PXR_NS::TfCreateRefPtr(new BypassSceneIndex(filteredSceneIndex, bypassSceneIndex, bypassed, affectedPaths));
+    }
+
+    FVP_API
+    ~BypassSceneIndex() override;
+
+    // From HdSceneIndexBase
+    FVP_API
+    PXR_NS::HdSceneIndexPrim GetPrim(const PXR_NS::SdfPath& primPath) const override{
+        return _GetActiveSceneIndex()->GetPrim(primPath);
+    }
+
+    FVP_API
+    PXR_NS::SdfPathVector GetChildPrimPaths(const PXR_NS::SdfPath& primPath) const override{
+        return _GetActiveSceneIndex()->GetChildPrimPaths(primPath);
+    }
+
+    // From HdFilteringSceneIndexBase
+    FVP_API
+    std::vector<PXR_NS::HdSceneIndexBaseRefPtr> GetInputScenes() const override{
+        return {_filteredSceneIndex, _bypassSceneIndex};
+    }
+
+    FVP_API
+    bool IsBypassed() const { return _bypassed; }
+
+    /// Switch between the filtered and the bypass scenes, notifying only the prims that differ
+    /// under the affected paths.
+    FVP_API
+    void SetBypassed(bool bypassed);
+
+    /// Roots of the subtrees compared when toggling the bypass.
+    FVP_API
+    const PXR_NS::SdfPathVector& GetAffectedPaths() const { return _affectedPaths; }
+
+protected:
+    FVP_API
+    BypassSceneIndex(const PXR_NS::HdSceneIndexBaseRefPtr& filteredSceneIndex,
+                     const PXR_NS::HdSceneIndexBaseRefPtr& bypassSceneIndex,
+                     bool bypassed,
+                     const PXR_NS::SdfPathVector& affectedPaths);
+
+private:
+    /// Forwards the notices of one of the inputs, when that input is the active one.
+    class _Observer : public PXR_NS::HdSceneIndexObserver
+    {
+    public:
+        _Observer(BypassSceneIndex& owner, bool observesBypassScene)
+            : _owner(owner), _observesBypassScene(observesBypassScene) {}
+
+        void PrimsAdded(const PXR_NS::HdSceneIndexBase& sender, const AddedPrimEntries& entries) override;
+        void PrimsRemoved(const PXR_NS::HdSceneIndexBase& sender, const RemovedPrimEntries& entries) override;
+        void PrimsDirtied(const PXR_NS::HdSceneIndexBase& sender, const DirtiedPrimEntries& entries) override;
+        void PrimsRenamed(const PXR_NS::HdSceneIndexBase& sender, const RenamedPrimEntries& entries) override;
+
+    private:
+        bool _IsActive() const { return _owner._bypassed == _observesBypassScene; }
+
+        BypassSceneIndex& _owner;
+        const bool        _observesBypassScene;
+    };
+
+    const PXR_NS::HdSceneIndexBaseRefPtr& _GetActiveSceneIndex() const {
+        return _bypassed ? _bypassSceneIndex : _filteredSceneIndex;
+    }
+
+    PXR_NS::HdSceneIndexBaseRefPtr _filteredSceneIndex;
+    PXR_NS::HdSceneIndexBaseRefPtr _bypassSceneIndex;
+    bool                           _bypassed {false};
+    // Sorted, without nested paths.
+    PXR_NS::SdfPathVector          _affectedPaths;
+
+    _Observer _filteredSceneObserver;
+    _Observer _bypassSceneObserver;
+};
+
+}//end of namespace FVP_NS_DEF
+
+#endif //FLOW_VIEWPORT_SCENEINDEX_FVP_BYPASS_SCENE_INDEX_H
@@ -16,7 +16,6 @@
 #include "flowViewport/sceneIndex/fvpDefaultMaterialSceneIndex.h"
 
 #include <pxr/imaging/hd/tokens.h>
-#include <pxr/imaging/hd/sceneIndexPrimView.h>
 #include <pxr/imaging/hd/materialSchema.h>
 #include <pxr/imaging/hd/materialBindingSchema.h>
 #include <pxr/imaging/hd/materialBindingsSchema.h>
@@ -68,7 +67,8 @@ DefaultMaterialSceneIndex::DefaultMaterialSceneIndex(
   : HdSingleInputFilteringSceneIndexBase(inputSceneIndex), 
     InputSceneIndexUtils(inputSceneIndex),
     _defaultMaterialPath(defaultMaterialPath),
-    _defaultMaterialExclusionList(defaultMaterialExclusionList)
+    _defaultMaterialExclusionList(defaultMaterialExclusionList),
+    _compliantPrimsIndex(_IsDefaultMaterialCompliantPrimitive)
 {   
 }
 
@@ -139,15 +139,11 @@ void DefaultMaterialSceneIndex::_MarkMaterialsDirty()
 { 
     static const auto locator = HdMaterialBindingsSchema::GetDefaultLocator();
 
-    HdSceneIndexObserver::DirtiedPrimEntries entries;
-    for (const SdfPath& primPath : HdSceneIndexPrimView(GetInputSceneIndex())) {
-        HdSceneIndexPrim prim = GetInputSceneIndex()->GetPrim(primPath);
-        // Dirty only prims where we should apply the default material
-        if (_ShouldWeApplyTheDefaultMaterial(prim)) {
-            entries.push_back({ primPath, locator });
-        }
-    }
-    _SendPrimsDirtied(entries);
+    // Dirty only prims where we should apply the default material
+    _SendPrimsDirtied(_compliantPrimsIndex.GetDirtiedEntries(
+        GetInputSceneIndex(), HdDataSourceLocatorSet { locator }, [this](const SdfPath& primPath) {
+            return _ShouldWeApplyTheDefaultMaterial(GetInputSceneIndex()->GetPrim(primPath));
+        }));
 }
 
 } //end of namespace FVP_NS_DEF
@@ -16,7 +16,9 @@
 #define FVP_DEFAULT_MATERIAL_SCENE_INDEX_H
 
 #include "flowViewport/api.h"
+#include "flowViewport/fvpInstruments.h"
 #include "flowViewport/sceneIndex/fvpSceneIndexUtils.h"
+#include "flowViewport/sceneIndex/fvpPrimTypeIndex.h"
 
 #include <pxr/imaging/hd/filteringSceneIndex.h>
 
@@ -59,6 +61,8 @@ protected:
     void _PrimsAdded(
         const PXR_NS::HdSceneIndexBase&                       sender,
         const PXR_NS::HdSceneIndexObserver::AddedPrimEntries& entries) override{
+        FVP_INSTRUMENTS_SCOPED_TIMER("DefaultMaterialSceneIndex:_PrimsAdded");
+        _compliantPrimsIndex.PrimsAdded(entries);
         if (!_IsObserved())
             return;
         _SendPrimsAdded(entries);
@@ -68,6 +72,7 @@ protected:
         const PXR_NS::HdSceneIndexBase&                         sender,
         const PXR_NS::HdSceneIndexObserver::RemovedPrimEntries& entries) override
     {
+        _compliantPrimsIndex.PrimsRemoved(entries);
         if (!_IsObserved())
             return;
         _SendPrimsRemoved(entries);
@@ -76,6 +81,7 @@ protected:
         const PXR_NS::HdSceneIndexBase&                         sender,
         const PXR_NS::HdSceneIndexObserver::DirtiedPrimEntries& entries) override
     {
+        FVP_INSTRUMENTS_SCOPED_TIMER("DefaultMaterialSceneIndex:_PrimsDirtied");
         if (!_IsObserved())
             return;
         _SendPrimsDirtied(entries);
@@ -88,6 +94,7 @@ private:
     bool _isEnabled = false;
     const PXR_NS::SdfPath  _defaultMaterialPath;
     PXR_NS::SdfPathVector  _defaultMaterialExclusionList;//These are the materials that should not be affected by the default material, they should be skipped
+    PrimTypeIndex          _compliantPrimsIndex;//Prims whose type supports the default material
     
     DefaultMaterialSceneIndex(
         PXR_NS::HdSceneIndexBaseRefPtr const &inputSceneIndex, const PXR_NS::SdfPath& defaultMaterialPath, const PXR_NS::SdfPathVector& defaultMaterialExclusionList);
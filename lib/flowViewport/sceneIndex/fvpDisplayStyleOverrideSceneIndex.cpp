@@ -14,11 +14,11 @@
 //
 
 #include "flowViewport/sceneIndex/fvpDisplayStyleOverrideSceneIndex.h"
+#include "flowViewport/fvpInstruments.h"
 
 #include "pxr/imaging/hd/tokens.h"
 #include "pxr/imaging/hd/legacyDisplayStyleSchema.h"
 #include "pxr/imaging/hd/overlayContainerDataSource.h"
-#include "pxr/imaging/hd/sceneIndexPrimView.h"
 #include "pxr/imaging/hd/retainedDataSource.h"
 
 namespace FVP_NS_DEF {
@@ -93,6 +93,7 @@ DisplayStyleOverrideSceneIndex(
       HdRetainedContainerDataSource::New(
           HdLegacyDisplayStyleSchemaTokens->displayStyle,
           _DisplayStyleDataSource::New(_styleInfo)))
+  , _meshesIndex([](const TfToken &primType) { return primType == HdPrimTypeTokens->mesh; })
 {
 }
 
@@ -147,12 +148,9 @@ DisplayStyleOverrideSceneIndex::_DirtyAllPrims(
         return;
     }
 
-    HdSceneIndexObserver::DirtiedPrimEntries entries;
-    for (const SdfPath &path : HdSceneIndexPrimView(GetInputSceneIndex())) {
-        entries.push_back({path, locators});
-    }
-
-    _SendPrimsDirtied(entries);
+    _SendPrimsDirtied(_meshesIndex.GetDirtiedEntries(
+        GetInputSceneIndex(), locators,
+        [this](const SdfPath &path) { return !isExcluded(path); }));
 }
 
 void
@@ -160,6 +158,8 @@ DisplayStyleOverrideSceneIndex::_PrimsAdded(
     const HdSceneIndexBase &sender,
     const HdSceneIndexObserver::AddedPrimEntries &entries)
 {
+    FVP_INSTRUMENTS_SCOPED_TIMER("DisplayStyleOverrideSceneIndex:_PrimsAdded");
+    _meshesIndex.PrimsAdded(entries);
     if (!_IsObserved()) {
         return;
     }
@@ -172,6 +172,7 @@ DisplayStyleOverrideSceneIndex::_PrimsRemoved(
     const HdSceneIndexBase &sender,
     const HdSceneIndexObserver::RemovedPrimEntries &entries)
 {
+    _meshesIndex.PrimsRemoved(entries);
     if (!_IsObserved()) {
         return;
     }
@@ -184,6 +185,7 @@ DisplayStyleOverrideSceneIndex::_PrimsDirtied(
     const HdSceneIndexBase &sender,
     const HdSceneIndexObserver::DirtiedPrimEntries &entries)
 {
+    FVP_INSTRUMENTS_SCOPED_TIMER("DisplayStyleOverrideSceneIndex:_PrimsDirtied");
     if (!_IsObserved()) {
         return;
     }
@@ -17,6 +17,7 @@
 
 #include "flowViewport/api.h"
 #include "flowViewport/sceneIndex/fvpSceneIndexUtils.h"
+#include "flowViewport/sceneIndex/fvpPrimTypeIndex.h"
 
 #include "pxr/imaging/hdsi/api.h"
 #include "pxr/imaging/hd/filteringSceneIndex.h"
@@ -111,6 +112,9 @@ private:
 
     /// Prim overlay data source.
     PXR_NS::HdContainerDataSourceHandle const _overlayDs;
+
+    /// Only meshes get the display style override.
+    PrimTypeIndex _meshesIndex;
 };
 
 HDSI_API
@@ -15,6 +15,7 @@
 //
 
 #include <flowViewport/sceneIndex/fvpIsolateSelectSceneIndex.h>
+#include <flowViewport/fvpInstruments.h>
 #include <flowViewport/selection/fvpSelection.h>
 #include <flowViewport/selection/fvpPathMapper.h>
 #include <flowViewport/selection/fvpPathMapperRegistry.h>
@@ -182,6 +183,7 @@ void IsolateSelectSceneIndex::_PrimsAdded(
     const HdSceneIndexBase&                       ,
     const HdSceneIndexObserver::AddedPrimEntries& entries)
 {
+    FVP_INSTRUMENTS_SCOPED_TIMER("IsolateSelectSceneIndex:_PrimsAdded");
     // Prims outside the isolate select set will be hidden in GetPrim().
     _SendPrimsAdded(entries);
 }
@@ -199,6 +201,7 @@ void IsolateSelectSceneIndex::_PrimsDirtied(
     const HdSceneIndexBase&                         ,
     const HdSceneIndexObserver::DirtiedPrimEntries& entries)
 {
+    FVP_INSTRUMENTS_SCOPED_TIMER("IsolateSelectSceneIndex:_PrimsDirtied");
     _SendPrimsDirtied(entries);
 }
 
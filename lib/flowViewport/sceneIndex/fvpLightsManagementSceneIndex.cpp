@@ -22,7 +22,6 @@
 #include <pxr/imaging/hd/retainedDataSource.h>
 #include <pxr/imaging/hd/overlayContainerDataSource.h>
 #include <pxr/imaging/hd/containerDataSourceEditor.h>
-#include <pxr/imaging/hd/sceneIndexPrimView.h>
 #include <pxr/imaging/hd/light.h>
 #include <pxr/imaging/hd/lightSchema.h>
 #include <pxr/imaging/glf/simpleLight.h>
@@ -30,6 +29,8 @@
 //ufe
 #include <ufe/globalSelection.h>
 #include <ufe/observableSelection.h>
+#include <ufe/scene.h>
+#include <ufe/sceneNotification.h>
 
 
 PXR_NAMESPACE_USING_DIRECTIVE
@@ -55,12 +56,72 @@ void _DisableLight(HdSceneIndexPrim& prim)
 
 namespace FVP_NS_DEF {
 
+class LightsManagementSceneIndex::_UfeSelectionObserver : public Ufe::Observer
+{
+public:
+    _UfeSelectionObserver(LightsManagementSceneIndex& lightsManagementSceneIndex)
+        : _lightsManagementSceneIndex(lightsManagementSceneIndex) {}
+
+    void operator()(const Ufe::Notification&) override {
+        if (LightingMode::kSelectedLightsOnly == _lightsManagementSceneIndex._lightingMode) {
+            _lightsManagementSceneIndex._UpdateSelectedPaths(true);
+        }
+    }
+
+private:
+    LightsManagementSceneIndex& _lightsManagementSceneIndex;
+};
+
+class LightsManagementSceneIndex::_UfeSceneObserver : public Ufe::Observer
+{
+public:
+    _UfeSceneObserver(LightsManagementSceneIndex& lightsManagementSceneIndex)
+        : _lightsManagementSceneIndex(lightsManagementSceneIndex) {}
+
+    void operator()(const Ufe::Notification& notification) override {
+        if (LightingMode::kSelectedLightsOnly != _lightsManagementSceneIndex._lightingMode) {
+            return;
+        }
+        const auto& sceneChanged = notification.staticCast<Ufe::SceneChanged>();
+        if (_HasPathChange(sceneChanged)) {
+            _lightsManagementSceneIndex._UpdateSelectedPaths(true);
+        }
+    }
+
+private:
+    static bool _HasPathChange(const Ufe::SceneChanged& sceneChanged) {
+        if (sceneChanged.opType() == Ufe::SceneChanged::SceneCompositeNotification) {
+            const auto& compositeNotification = sceneChanged.staticCast<Ufe::SceneCompositeNotification>();
+            for (const auto& operation : compositeNotification) {
+                if (operation.opType == Ufe::SceneChanged::ObjectPathChange) {
+                    return true;
+                }
+            }
+            return false;
+        }
+        return sceneChanged.opType() == Ufe::SceneChanged::ObjectPathChange;
+    }
+
+    LightsManagementSceneIndex& _lightsManagementSceneIndex;
+};
+
 LightsManagementSceneIndex::LightsManagementSceneIndex(const HdSceneIndexBaseRefPtr& inputSceneIndex, const PathInterface& pathInterface, const SdfPath& defaultLightPath) 
     : ParentClass(inputSceneIndex), 
     InputSceneIndexUtils(inputSceneIndex)
     ,_defaultLightPath(defaultLightPath)
     , _pathInterface(pathInterface)
+    , _lightsIndex(HdPrimTypeIsLight)
 {
+    _ufeSelectionObserver = std::make_shared<_UfeSelectionObserver>(*this);
+    Ufe::GlobalSelection::get()->addObserver(_ufeSelectionObserver);
+    _ufeSceneObserver = std::make_shared<_UfeSceneObserver>(*this);
+    Ufe::Scene::instance().addObserver(_ufeSceneObserver);
+}
+
+LightsManagementSceneIndex::~LightsManagementSceneIndex()
+{
+    Ufe::Scene::instance().removeObserver(_ufeSceneObserver);
+    Ufe::GlobalSelection::get()->removeObserver(_ufeSelectionObserver);
 }
 
 void LightsManagementSceneIndex::SetLightingMode(LightingMode lightingMode) 
@@ -70,19 +131,60 @@ void LightsManagementSceneIndex::SetLightingMode(LightingMode lightingMode)
     }
 
     _lightingMode = lightingMode;
+    if (LightingMode::kSelectedLightsOnly == _lightingMode) {
+        _UpdateSelectedPaths(false);
+    } else {
+        _selectedPaths.clear();
+    }
     _DirtyAllLightsPrims();
 }
 
-void LightsManagementSceneIndex::_DirtyAllLightsPrims()
+void LightsManagementSceneIndex::_UpdateSelectedPaths(bool dirtyChangedLights)
 {
-    HdSceneIndexObserver::DirtiedPrimEntries entries;
-    for (const SdfPath& path : HdSceneIndexPrimView(GetInputSceneIndex())) {
-        auto primType = GetInputSceneIndex()->GetPrim(path).primType;
-        if (HdPrimTypeIsLight(primType)) {
-            entries.push_back({ path, HdLightSchema::GetDefaultLocator() });
+    FVP_INSTRUMENTS_SCOPED_TIMER("LightsManagementSceneIndex:_UpdateSelectedPaths");
+
+    //Convert ufe selection to SdfPath
+    _SdfPathSet selectedPaths;
+    for (const auto& snItem : *Ufe::GlobalSelection::get()) {
+        for (const auto& primSelection : _pathInterface.UfePathToPrimSelections(snItem->path())) {
+            selectedPaths.insert(primSelection.primPath);
         }
     }
-    _SendPrimsDirtied(entries);
+    std::swap(_selectedPaths, selectedPaths);
+
+    if (!dirtyChangedLights || !_IsObserved()) {
+        return;
+    }
+
+    // Only dirty the lights which were selected and are no longer, or the reverse.
+    static const HdDataSourceLocatorSet locators { HdLightSchema::GetDefaultLocator() };
+    const auto& previouslySelectedPaths = selectedPaths;
+    auto dirtiedEntries = _lightsIndex.GetDirtiedEntries(GetInputSceneIndex(), locators,
+        [this, &previouslySelectedPaths](const SdfPath& primPath) {
+            return (_selectedPaths.count(primPath) > 0) != (previouslySelectedPaths.count(primPath) > 0);
+        });
+    if (!dirtiedEntries.empty()) {
+        _SendPrimsDirtied(dirtiedEntries);
+    }
+}
+
+void LightsManagementSceneIndex::_UpdateSelectedPathsOnLightsAdded(const HdSceneIndexObserver::AddedPrimEntries& entries)
+{
+    if (LightingMode::kSelectedLightsOnly != _lightingMode) {
+        return;
+    }
+    for (const auto& entry : entries) {
+        if (HdPrimTypeIsLight(entry.primType)) {
+            _UpdateSelectedPaths(true);
+            return;
+        }
+    }
+}
+
+void LightsManagementSceneIndex::_DirtyAllLightsPrims()
+{
+    static const HdDataSourceLocatorSet locators { HdLightSchema::GetDefaultLocator() };
+    _SendPrimsDirtied(_lightsIndex.GetDirtiedEntries(GetInputSceneIndex(), locators));
 }
 
 bool LightsManagementSceneIndex::_IsDefaultLight(const SdfPath& primPath)const
@@ -115,26 +217,8 @@ HdSceneIndexPrim LightsManagementSceneIndex::GetPrim(const SdfPath& primPath) co
              return prim;
          } break;
          case LightingMode::kSelectedLightsOnly: {
-             const Ufe::Selection& ufeSelection = *Ufe::GlobalSelection::get();
-             if (ufeSelection.empty()) {
-                 // Nothing is selected
-                 _DisableLight(prim);
-                 return prim;
-             }
-             
-             //Convert ufe selection to SdfPath
-             SdfPathVector selectedLightsSdfPath;
-             for (const auto& snItem : ufeSelection) {
-                 auto primSelections = _pathInterface.UfePathToPrimSelections(snItem->path());
-                 for (const auto& primSelection : primSelections) {
-                     selectedLightsSdfPath.push_back(primSelection.primPath);
-                 }
-             }
-             const bool isSelected = selectedLightsSdfPath.end()
-                 != std::find(selectedLightsSdfPath.begin(),
-                              selectedLightsSdfPath.end(),
-                              primPath);
-
+             //The selected paths are updated on UFE selection changes
+             const bool isSelected = _selectedPaths.count(primPath) > 0;
              if (! isSelected) {
                  _DisableLight(prim);
              }
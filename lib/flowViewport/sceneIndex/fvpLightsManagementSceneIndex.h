@@ -18,13 +18,21 @@
 
 //Local headers
 #include "flowViewport/api.h"
+#include "flowViewport/fvpInstruments.h"
 #include "flowViewport/sceneIndex/fvpSceneIndexUtils.h"
 #include "flowViewport/sceneIndex/fvpPathInterface.h"
+#include "flowViewport/sceneIndex/fvpPrimTypeIndex.h"
 
 //Hydra headers
 #include <pxr/base/tf/declarePtrs.h>
 #include <pxr/imaging/hd/filteringSceneIndex.h>
 
+//ufe
+#include <ufe/observer.h>
+
+//Std headers
+#include <unordered_set>
+
 namespace FVP_NS_DEF {
 
 class LightsManagementSceneIndex;
@@ -57,7 +65,7 @@ public:
     }
     
     FVP_API
-    ~LightsManagementSceneIndex() override = default;
+    ~LightsManagementSceneIndex() override;
 
     enum class LightingMode{
         kNoLighting,
@@ -78,14 +86,20 @@ protected:
 
     //From HdSingleInputFilteringSceneIndexBase
     void _PrimsAdded(const PXR_NS::HdSceneIndexBase& sender, const PXR_NS::HdSceneIndexObserver::AddedPrimEntries& entries) override{
-        if (!_IsObserved())return;
-        _SendPrimsAdded(entries);
+        FVP_INSTRUMENTS_SCOPED_TIMER("LightsManagementSceneIndex:_PrimsAdded");
+        _lightsIndex.PrimsAdded(entries);
+        if (_IsObserved()) {
+            _SendPrimsAdded(entries);
+        }
+        _UpdateSelectedPathsOnLightsAdded(entries);
     }
     void _PrimsRemoved(const PXR_NS::HdSceneIndexBase& sender, const PXR_NS::HdSceneIndexObserver::RemovedPrimEntries& entries)override{
+        _lightsIndex.PrimsRemoved(entries);
         if (!_IsObserved())return;
         _SendPrimsRemoved(entries);
     }
     void _PrimsDirtied(const PXR_NS::HdSceneIndexBase& sender, const PXR_NS::HdSceneIndexObserver::DirtiedPrimEntries& entries)override{
+        FVP_INSTRUMENTS_SCOPED_TIMER("LightsManagementSceneIndex:_PrimsDirtied");
         if (!_IsObserved())return;
         _SendPrimsDirtied(entries);
     }
@@ -93,9 +107,27 @@ protected:
     void _DirtyAllLightsPrims();
     bool _IsDefaultLight(const PXR_NS::SdfPath& primPath)const;
 
+    /// Recompute the selected paths from the UFE selection and dirty the lights whose selection state changed.
+    void _UpdateSelectedPaths(bool dirtyChangedLights);
+
+    /// A renamed or reparented light is added again under its new path : its scene index path
+    /// must be refreshed in the selected paths.
+    void _UpdateSelectedPathsOnLightsAdded(const PXR_NS::HdSceneIndexObserver::AddedPrimEntries& entries);
+
+    class _UfeSelectionObserver;
+    class _UfeSceneObserver;
+    using _SdfPathSet = std::unordered_set<PXR_NS::SdfPath, PXR_NS::SdfPath::Hash>;
+
     LightingMode _lightingMode = LightingMode::kSceneLighting;
     PXR_NS::SdfPath _defaultLightPath;
     const PathInterface& _pathInterface;
+    PrimTypeIndex _lightsIndex;
+    /// Scene index paths of the UFE selection, only kept up to date in kSelectedLightsOnly mode.
+    /// They are refreshed on UFE selection changes and on UFE path changes (rename, reparent),
+    /// which change the scene index paths of the selected items.
+    _SdfPathSet _selectedPaths;
+    Ufe::Observer::Ptr _ufeSelectionObserver;
+    Ufe::Observer::Ptr _ufeSceneObserver;
 };
 
 }//end of namespace FVP_NS_DEF
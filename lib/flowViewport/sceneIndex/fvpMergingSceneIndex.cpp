@@ -16,6 +16,7 @@
 #include "flowViewport/sceneIndex/fvpMergingSceneIndex.h"
 
 #include "flowViewport/debugCodes.h"
+#include "flowViewport/fvpInstruments.h"
 
 PXR_NAMESPACE_USING_DIRECTIVE
 
@@ -34,26 +35,80 @@ MergingSceneIndex::MergingSceneIndex() : HdMergingSceneIndex()
         .Msg("MergingSceneIndex::MergingSceneIndex() called.\n");
 }
 
+void MergingSceneIndex::AddInputScene(
+    const HdSceneIndexBaseRefPtr& inputScene,
+    const SdfPath&                activeInputSceneRoot)
+{
+    HdMergingSceneIndex::AddInputScene(inputScene, activeInputSceneRoot);
+    _UpdatePathInterfaceInputs();
+}
+
+void MergingSceneIndex::RemoveInputScene(const HdSceneIndexBaseRefPtr& inputScene)
+{
+    HdMergingSceneIndex::RemoveInputScene(inputScene);
+    _UpdatePathInterfaceInputs();
+}
+
+void MergingSceneIndex::_UpdatePathInterfaceInputs()
+{
+    // Only dynamic cast once, when the inputs change.
+    _PathInterfaceInputs pathInterfaceInputs;
+    for (const auto& inputScene : GetInputScenes()) {
+        if (auto pathInterface = dynamic_cast<const PathInterface*>(&*inputScene)) {
+            pathInterfaceInputs.push_back({inputScene, pathInterface});
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(_inputsMutex);
+    _pathInterfaceInputs.swap(pathInterfaceInputs);
+    _lastInputByKey.clear();
+}
+
 PrimSelections MergingSceneIndex::UfePathToPrimSelections(const Ufe::Path& appPath) const
 {
-    // FLOW_VIEWPORT_TODO  May be able to use a caching scheme for app path to
-    // scene index path conversion using the run-time ID of the UFE path, as it
-    // is likely that the input scene index that provided a previous answer
-    // will do so again.  To be determined if the following direct approach has
-    // a measurable performance impact.  PPT, 18-Sep-2023.
-
-    // Iterate over input scene indices and ask them to convert the path if
-    // they support the path interface.
-    auto inputScenes = GetInputScenes();
-    for (const auto& inputScene : inputScenes) {
-        // Unfortunate that we have to dynamic cast, as soon as we add an input
-        // scene we know whether it supports the PathInterface or not.
-        auto pathInterface = dynamic_cast<const PathInterface*>(&*inputScene);
-        if (pathInterface) {
-            auto primSelections = pathInterface->UfePathToPrimSelections(appPath);
-            if (!primSelections.empty()) {
-                return primSelections;
+    static auto& nbLastInputHits = Instruments::instance().counter("MergingSceneIndex:NbLastInputHits");
+
+    // Path conversions by the inputs are done without holding the lock. The
+    // copied inputs keep their scene index alive during the conversion.
+    const PathInterface* lastInput = nullptr;
+    _PathInterfaceInputs pathInterfaceInputs;
+    const _InputKey key(appPath.runTimeId(),
+        appPath.nbSegments() > 1 ? appPath.getSegments().front().string() : std::string());
+    {
+        std::lock_guard<std::mutex> lock(_inputsMutex);
+
+        // It is likely that the input scene index that provided the previous
+        // answer for the same run-time and gateway will do so again, so try it
+        // first, then the other inputs in turn.
+        auto foundInput = _lastInputByKey.find(key);
+        if (foundInput != _lastInputByKey.end()) {
+            lastInput = foundInput->second;
+        }
+        pathInterfaceInputs = _pathInterfaceInputs;
+    }
+
+    if (lastInput) {
+        auto primSelections = lastInput->UfePathToPrimSelections(appPath);
+        if (!primSelections.empty()) {
+            nbLastInputHits.add();
+            return primSelections;
+        }
+    }
+    for (const auto& input : pathInterfaceInputs) {
+        if (input.pathInterface == lastInput) {
+            continue;
+        }
+        auto primSelections = input.pathInterface->UfePathToPrimSelections(appPath);
+        if (!primSelections.empty()) {
+            std::lock_guard<std::mutex> lock(_inputsMutex);
+            // Only remember the input if it was not removed during the conversion.
+            for (const auto& currentInput : _pathInterfaceInputs) {
+                if (currentInput.pathInterface == input.pathInterface) {
+                    _lastInputByKey[key] = input.pathInterface;
+                    break;
+                }
             }
+            return primSelections;
         }
     }
     return PrimSelections();
@@ -20,6 +20,13 @@
 
 #include <pxr/imaging/hd/mergingSceneIndex.h>
 
+#include <ufe/path.h>
+#include <ufe/rtid.h>
+
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
 namespace FVP_NS_DEF {
 
 // Pixar declarePtrs.h TF_DECLARE_REF_PTRS macro unusable, places resulting
@@ -33,6 +40,14 @@ typedef PXR_NS::TfRefPtr<const MergingSceneIndex> MergingSceneIndexConstRefPtr;
 /// A merging scene index that delegates conversion of application paths to
 /// scene index paths to its inputs.
 ///
+/// The input which converted a path is tried first for the next paths of the
+/// same run-time and gateway. Conversion results are not cached here : inputs
+/// which need it cache them with their own invalidation rules.
+///
+/// The path interface inputs are kept with a reference to their scene index,
+/// so that they stay valid even if an input is removed through the
+/// HdMergingSceneIndex base class, which bypasses the methods below.
+///
 class MergingSceneIndex 
     : public PXR_NS::HdMergingSceneIndex, public PathInterface
 {
@@ -40,11 +55,46 @@ public:
     FVP_API
     static MergingSceneIndexRefPtr New();
 
+    // Hide the HdMergingSceneIndex methods to keep the path interface inputs
+    // up to date.
+    FVP_API
+    void AddInputScene(
+        const PXR_NS::HdSceneIndexBaseRefPtr& inputScene,
+        const PXR_NS::SdfPath&                activeInputSceneRoot);
+
+    FVP_API
+    void RemoveInputScene(const PXR_NS::HdSceneIndexBaseRefPtr& inputScene);
+
     FVP_API
     PrimSelections UfePathToPrimSelections(const Ufe::Path& appPath) const override;
 
 private:
     MergingSceneIndex();
+
+    void _UpdatePathInterfaceInputs();
+
+    // Key of the input which last converted a path : run-time ID and, for
+    // paths with several segments, the gateway node path.
+    using _InputKey = std::pair<Ufe::Rtid, std::string>;
+    struct _InputKeyHash {
+        size_t operator()(const _InputKey& key) const {
+            return std::hash<std::string>()(key.second) ^ std::hash<Ufe::Rtid>()(key.first);
+        }
+    };
+
+    // Input scene supporting the path interface, and the reference keeping
+    // it alive.
+    struct _PathInterfaceInput {
+        PXR_NS::HdSceneIndexBaseRefPtr sceneIndex;
+        const PathInterface*           pathInterface;
+    };
+    using _PathInterfaceInputs = std::vector<_PathInterfaceInput>;
+
+    // Input scenes supporting the path interface, in input order.
+    _PathInterfaceInputs                                  _pathInterfaceInputs;
+
+    mutable std::mutex                                    _inputsMutex;
+    mutable std::unordered_map<_InputKey, const PathInterface*, _InputKeyHash> _lastInputByKey;
 };
 
 }
@@ -15,6 +15,7 @@
 //
 
 #include "flowViewport/sceneIndex/fvpPathInterfaceSceneIndex.h"
+#include "flowViewport/fvpInstruments.h"
 
 PXR_NAMESPACE_USING_DIRECTIVE
 
@@ -43,6 +44,7 @@ PathInterfaceSceneIndexBase::_PrimsAdded(
     const HdSceneIndexBase &sender,
     const HdSceneIndexObserver::AddedPrimEntries &entries)
 {
+    FVP_INSTRUMENTS_SCOPED_TIMER("PathInterfaceSceneIndexBase:_PrimsAdded");
     _SendPrimsAdded(entries);
 }
 
@@ -51,6 +53,7 @@ PathInterfaceSceneIndexBase::_PrimsDirtied(
     const HdSceneIndexBase &sender,
     const HdSceneIndexObserver::DirtiedPrimEntries &entries)
 {
+    FVP_INSTRUMENTS_SCOPED_TIMER("PathInterfaceSceneIndexBase:_PrimsDirtied");
     _SendPrimsDirtied(entries);
 }
 
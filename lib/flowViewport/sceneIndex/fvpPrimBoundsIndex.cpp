@@ -0,0 +1,357 @@
+//
+// Copyright 2024 Autodesk
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+//Local headers
+#include "fvpPrimBoundsIndex.h"
+#include "flowViewport/fvpInstruments.h"
+
+//Hydra headers
+#include <pxr/base/gf/bbox3d.h>
+#include <pxr/base/gf/vec4d.h>
+#include <pxr/base/tf/envSetting.h>
+#include <pxr/imaging/hd/extentSchema.h>
+#include <pxr/imaging/hd/instancedBySchema.h>
+#include <pxr/imaging/hd/sceneIndexPrimView.h>
+#include <pxr/imaging/hd/xformSchema.h>
+
+//Std headers
+#include <algorithm>
+#include <atomic>
+
+PXR_NAMESPACE_USING_DIRECTIVE
+
+TF_DEFINE_ENV_SETTING(FVP_PICK_MAX_CANDIDATES_RATIO, 0.5,
+    "Ratio of the pickable prims above which picking does not restrict the pick collection to the candidate prims.");
+
+namespace {
+
+std::atomic<double>& _MaxCandidatesRatio()
+{
+    static std::atomic<double> ratio(TfGetEnvSetting(FVP_PICK_MAX_CANDIDATES_RATIO));
+    return ratio;
+}
+
+// Number of prims below which a hierarchy node is not split.
+constexpr size_t kMaxPrimsPerLeaf = 8;
+
+const SdfPath& _GetPath(const SdfPath& path) { return path; }
+
+template <typename T>
+const SdfPath& _GetPath(const std::pair<const SdfPath, T>& entry) { return entry.first; }
+
+// Descendants immediately follow their ancestor in path order.
+template <typename Container>
+void _EraseSubtree(Container& container, const SdfPath& root)
+{
+    auto it = container.lower_bound(root);
+    while (it != container.end() && _GetPath(*it).HasPrefix(root)) {
+        it = container.erase(it);
+    }
+}
+
+bool _AffectsBounds(const HdDataSourceLocatorSet& locators)
+{
+    static const HdDataSourceLocatorSet boundsLocators {
+        HdXformSchema::GetDefaultLocator(),
+        HdExtentSchema::GetDefaultLocator(),
+        HdInstancedBySchema::GetDefaultLocator()
+    };
+    return locators.Intersects(boundsLocators);
+}
+
+} // namespace
+
+namespace FVP_NS_DEF {
+
+PrimBoundsIndex::PrimBoundsIndex(const HdSceneIndexBaseRefPtr& sceneIndex, const TypePredicate& isIndexedType)
+    : _sceneIndex(sceneIndex)
+    , _isIndexedType(isIndexedType)
+{
+    TF_AXIOM(_sceneIndex);
+    _sceneIndex->AddObserver(HdSceneIndexObserverPtr(this));
+}
+
+PrimBoundsIndex::~PrimBoundsIndex()
+{
+    _sceneIndex->RemoveObserver(HdSceneIndexObserverPtr(this));
+}
+
+bool PrimBoundsIndex::BoundsMayIntersectFrustum(const GfRange3d& worldBounds, const GfMatrix4d& worldToClip)
+{
+    if (worldBounds.IsEmpty()) {
+        return false;
+    }
+
+    // Each frustum plane is a half-space in homogeneous clip space, as is the
+    // convex hull of the transformed corners : the bounds are outside of the
+    // frustum if all their corners are outside of the same plane.
+    // Outcode bits : x < -w, x > w, y < -w, y > w, z < -w, z > w.
+    int outsideAll = 0x3F;
+    for (size_t i = 0; i < 8; ++i) {
+        const GfVec3d corner = worldBounds.GetCorner(i);
+        const GfVec4d clip = GfVec4d(corner[0], corner[1], corner[2], 1.0) * worldToClip;
+        const double  w = clip[3];
+        int outside = 0;
+        outside |= (clip[0] < -w) ? 0x01 : 0;
+        outside |= (clip[0] >  w) ? 0x02 : 0;
+        outside |= (clip[1] < -w) ? 0x04 : 0;
+        outside |= (clip[1] >  w) ? 0x08 : 0;
+        outside |= (clip[2] < -w) ? 0x10 : 0;
+        outside |= (clip[2] >  w) ? 0x20 : 0;
+        outsideAll &= outside;
+        if (0 == outsideAll) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool PrimBoundsIndex::GetCandidatePrims(const GfMatrix4d& worldToClip, SdfPathVector& candidates)
+{
+    FVP_INSTRUMENTS_SCOPED_TIMER("PrimBoundsIndex:GetCandidatePrims");
+
+    candidates.clear();
+    _Populate();
+    _UpdateDirtyPrims();
+    if (!_isHierarchyValid) {
+        _BuildHierarchy();
+    }
+
+    candidates = _unknownBoundsPrims;
+    if (!_nodes.empty()) {
+        std::vector<int> stack { 0 };
+        while (!stack.empty()) {
+            const _Node& node = _nodes[stack.back()];
+            stack.pop_back();
+            if (!BoundsMayIntersectFrustum(node.bounds, worldToClip)) {
+                continue;
+            }
+            if (node.left < 0) {
+                for (size_t i = node.begin; i < node.end; ++i) {
+                    if (BoundsMayIntersectFrustum(_leaves[i].second, worldToClip)) {
+                        candidates.push_back(_leaves[i].first);
+                    }
+                }
+            } else {
+                stack.push_back(node.left);
+                stack.push_back(node.right);
+            }
+        }
+    }
+
+    static auto& nbCandidates = Instruments::instance().counter("PrimBoundsIndex:NbCandidatePrims");
+    nbCandidates.add(candidates.size());
+
+    if (candidates.size() == _prims.size()
+        || candidates.size() > _MaxCandidatesRatio().load() * _prims.size()) {
+        candidates.clear();
+        return false;
+    }
+    return true;
+}
+
+/* static */
+double PrimBoundsIndex::GetMaxCandidatesRatio()
+{
+    return _MaxCandidatesRatio().load();
+}
+
+/* static */
+void PrimBoundsIndex::SetMaxCandidatesRatio(double ratio)
+{
+    _MaxCandidatesRatio().store(ratio);
+}
+
+void PrimBoundsIndex::_Populate()
+{
+    if (_isPopulated) {
+        return;
+    }
+
+    FVP_INSTRUMENTS_SCOPED_TIMER("PrimBoundsIndex:Populate");
+    for (const SdfPath& path : HdSceneIndexPrimView(_sceneIndex)) {
+        if (_isIndexedType(_sceneIndex->GetPrim(path).primType)) {
+            _prims.emplace_hint(_prims.end(), path, _PrimBounds());
+            _dirtyPrims.emplace_hint(_dirtyPrims.end(), path);
+        }
+    }
+    _isPopulated = true;
+    _isHierarchyValid = false;
+}
+
+void PrimBoundsIndex::_UpdateDirtyPrims()
+{
+    if (_dirtyPrims.empty()) {
+        return;
+    }
+
+    for (const SdfPath& path : _dirtyPrims) {
+        auto found = _prims.find(path);
+        if (found == _prims.end()) {
+            continue;
+        }
+
+        _PrimBounds& primBounds = found->second;
+        primBounds = _PrimBounds();
+
+        const HdSceneIndexPrim prim = _sceneIndex->GetPrim(path);
+        // The instances of instanced prims are placed by their instancer.
+        HdInstancedBySchema instancedBy = HdInstancedBySchema::GetFromParent(prim.dataSource);
+        if (instancedBy) {
+            if (auto paths = instancedBy.GetPaths()) {
+                if (!paths->GetTypedValue(0.0f).empty()) {
+                    continue;
+                }
+            }
+        }
+
+        HdExtentSchema extent = HdExtentSchema::GetFromParent(prim.dataSource);
+        if (!extent || !extent.GetMin() || !extent.GetMax()) {
+            continue;
+        }
+        const GfRange3d localBounds(extent.GetMin()->GetTypedValue(0.0f), extent.GetMax()->GetTypedValue(0.0f));
+        if (localBounds.IsEmpty()) {
+            continue;
+        }
+
+        GfMatrix4d matrix(1.0);
+        HdXformSchema xform = HdXformSchema::GetFromParent(prim.dataSource);
+        if (xform) {
+            if (auto matrixDataSource = xform.GetMatrix()) {
+                matrix = matrixDataSource->GetTypedValue(0.0f);
+            }
+        }
+
+        primBounds.bounds = GfBBox3d(localBounds, matrix).ComputeAlignedRange();
+        primBounds.isKnown = true;
+    }
+    _dirtyPrims.clear();
+    _isHierarchyValid = false;
+}
+
+void PrimBoundsIndex::_BuildHierarchy()
+{
+    FVP_INSTRUMENTS_SCOPED_TIMER("PrimBoundsIndex:BuildHierarchy");
+
+    _leaves.clear();
+    _nodes.clear();
+    _unknownBoundsPrims.clear();
+    for (const auto& prim : _prims) {
+        if (prim.second.isKnown) {
+            _leaves.emplace_back(prim.first, prim.second.bounds);
+        } else {
+            _unknownBoundsPrims.push_back(prim.first);
+        }
+    }
+
+    if (!_leaves.empty()) {
+        _nodes.reserve(2 * _leaves.size() / kMaxPrimsPerLeaf + 1);
+        _BuildNode(0, _leaves.size());
+    }
+    _isHierarchyValid = true;
+}
+
+int PrimBoundsIndex::_BuildNode(size_t begin, size_t end)
+{
+    const int nodeIndex = static_cast<int>(_nodes.size());
+    _nodes.emplace_back();
+
+    GfRange3d bounds;
+    GfRange3d centers;
+    for (size_t i = begin; i < end; ++i) {
+        bounds.UnionWith(_leaves[i].second);
+        centers.UnionWith(_leaves[i].second.GetMidpoint());
+    }
+    _nodes[nodeIndex].bounds = bounds;
+
+    if (end - begin <= kMaxPrimsPerLeaf) {
+        _nodes[nodeIndex].begin = begin;
+        _nodes[nodeIndex].end = end;
+        return nodeIndex;
+    }
+
+    // Median split along the largest extent of the bounds centers.
+    const GfVec3d size = centers.GetSize();
+    const int axis = (size[0] >= size[1] && size[0] >= size[2]) ? 0 : (size[1] >= size[2] ? 1 : 2);
+    const size_t middle = begin + (end - begin) / 2;
+    std::nth_element(_leaves.begin() + begin, _leaves.begin() + middle, _leaves.begin() + end,
+        [axis](const auto& a, const auto& b) {
+            return a.second.GetMidpoint()[axis] < b.second.GetMidpoint()[axis];
+        });
+
+    // Children are built before being assigned, as building reallocates _nodes.
+    const int left = _BuildNode(begin, middle);
+    const int right = _BuildNode(middle, end);
+    _nodes[nodeIndex].left = left;
+    _nodes[nodeIndex].right = right;
+    return nodeIndex;
+}
+
+void PrimBoundsIndex::PrimsAdded(const HdSceneIndexBase&, const AddedPrimEntries& entries)
+{
+    // Before population, the traversal will find the added prims.
+    if (!_isPopulated) {
+        return;
+    }
+
+    // Prims can be added again with a different type.
+    for (const auto& entry : entries) {
+        if (_isIndexedType(entry.primType)) {
+            _prims[entry.primPath];
+            _dirtyPrims.insert(entry.primPath);
+        } else if (_prims.erase(entry.primPath)) {
+            _dirtyPrims.erase(entry.primPath);
+            _isHierarchyValid = false;
+        }
+    }
+}
+
+void PrimBoundsIndex::PrimsRemoved(const HdSceneIndexBase&, const RemovedPrimEntries& entries)
+{
+    if (!_isPopulated) {
+        return;
+    }
+
+    for (const auto& entry : entries) {
+        _EraseSubtree(_prims, entry.primPath);
+        _EraseSubtree(_dirtyPrims, entry.primPath);
+    }
+    _isHierarchyValid = false;
+}
+
+void PrimBoundsIndex::PrimsDirtied(const HdSceneIndexBase&, const DirtiedPrimEntries& entries)
+{
+    if (!_isPopulated) {
+        return;
+    }
+
+    for (const auto& entry : entries) {
+        if (_AffectsBounds(entry.dirtyLocators) && _prims.count(entry.primPath)) {
+            _dirtyPrims.insert(entry.primPath);
+        }
+    }
+}
+
+void PrimBoundsIndex::PrimsRenamed(const HdSceneIndexBase& sender, const RenamedPrimEntries& entries)
+{
+    RemovedPrimEntries removed;
+    AddedPrimEntries   added;
+    ConvertPrimsRenamedToRemovedAndAdded(sender, entries, &removed, &added);
+    PrimsRemoved(sender, removed);
+    PrimsAdded(sender, added);
+}
+
+}//end of namespace FVP_NS_DEF
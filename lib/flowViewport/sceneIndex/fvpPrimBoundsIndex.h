@@ -0,0 +1,141 @@
+//
+// Copyright 2024 Autodesk
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#ifndef FLOW_VIEWPORT_SCENEINDEX_FVP_PRIM_BOUNDS_INDEX_H
+#define FLOW_VIEWPORT_SCENEINDEX_FVP_PRIM_BOUNDS_INDEX_H
+
+//Local headers
+#include "flowViewport/api.h"
+
+//Hydra headers
+#include <pxr/base/gf/matrix4d.h>
+#include <pxr/base/gf/range3d.h>
+#include <pxr/imaging/hd/sceneIndex.h>
+#include <pxr/imaging/hd/sceneIndexObserver.h>
+
+//Std headers
+#include <functional>
+#include <map>
+#include <set>
+#include <vector>
+
+namespace FVP_NS_DEF {
+
+class PrimBoundsIndex;
+typedef PXR_NS::TfRefPtr<PrimBoundsIndex> PrimBoundsIndexRefPtr;
+
+/// \class PrimBoundsIndex
+///
+/// Observes a scene index and keeps a bounding volume hierarchy of the world
+/// space bounds (extent transformed by xform) of the prims of the indexed types.
+/// It is used to find the prims which may be under a pick region before running
+/// the GPU picking.
+///
+/// Like PrimTypeIndex, it is populated by a traversal of the scene on first
+/// use, then kept up to date from the observed notifications : added prims and
+/// prims with dirtied xform or extent are recomputed, and the hierarchy
+/// rebuilt, on the next query.
+///
+/// Prims whose bounds are unknown (no extent, or instanced prims whose
+/// instances are elsewhere) are always returned as candidates.
+class PrimBoundsIndex : public PXR_NS::HdSceneIndexObserver
+{
+public:
+    using TypePredicate = std::function<bool(const PXR_NS::TfToken& primType)>;
+
+    FVP_API
+    static PrimBoundsIndexRefPtr New(const PXR_NS::HdSceneIndexBaseRefPtr& sceneIndex, const TypePredicate& isIndexedType){
+        return PXR_NS::TfCreateRefPtr(new PrimBoundsIndex(sceneIndex, isIndexedType));
+    }
+
+    FVP_API
+    ~PrimBoundsIndex() override;
+
+    /// Fill candidates with the indexed prims whose bounds may intersect the
+    /// frustum defined by the world to clip space matrix (row vectors, clip
+    /// space is the [-w, w] cube), and the indexed prims with unknown bounds.
+    /// Return false if the candidates are more than the maximum candidates
+    /// ratio of the indexed prims, in which case candidates is left empty and
+    /// all the indexed prims should be used.
+    FVP_API
+    bool GetCandidatePrims(const PXR_NS::GfMatrix4d& worldToClip, PXR_NS::SdfPathVector& candidates);
+
+    /// Restricting a pick collection to the candidates makes Hydra gather its
+    /// draw items again. Above this ratio of the indexed prims, picking all
+    /// the prims with the unchanged full collection is cheaper. A ratio of 1
+    /// always restricts to the candidates.
+    FVP_API
+    static double GetMaxCandidatesRatio();
+    FVP_API
+    static void SetMaxCandidatesRatio(double ratio);
+
+    /// Conservative test : return false only if the bounds are entirely
+    /// outside of one of the planes of the frustum.
+    FVP_API
+    static bool BoundsMayIntersectFrustum(const PXR_NS::GfRange3d& worldBounds, const PXR_NS::GfMatrix4d& worldToClip);
+
+    // From HdSceneIndexObserver
+    FVP_API
+    void PrimsAdded(const PXR_NS::HdSceneIndexBase& sender, const AddedPrimEntries& entries) override;
+    FVP_API
+    void PrimsRemoved(const PXR_NS::HdSceneIndexBase& sender, const RemovedPrimEntries& entries) override;
+    FVP_API
+    void PrimsDirtied(const PXR_NS::HdSceneIndexBase& sender, const DirtiedPrimEntries& entries) override;
+    FVP_API
+    void PrimsRenamed(const PXR_NS::HdSceneIndexBase& sender, const RenamedPrimEntries& entries) override;
+
+private:
+    PrimBoundsIndex(const PXR_NS::HdSceneIndexBaseRefPtr& sceneIndex, const TypePredicate& isIndexedType);
+
+    void _Populate();
+    void _UpdateDirtyPrims();
+    void _BuildHierarchy();
+    int  _BuildNode(size_t begin, size_t end);
+
+    struct _PrimBounds
+    {
+        PXR_NS::GfRange3d bounds;
+        bool              isKnown = false;
+    };
+
+    struct _Node
+    {
+        PXR_NS::GfRange3d bounds;
+        // Children node indices, -1 for leaves.
+        int               left = -1;
+        int               right = -1;
+        // Range of _leaves, for leaves.
+        size_t            begin = 0;
+        size_t            end = 0;
+    };
+
+    const PXR_NS::HdSceneIndexBaseRefPtr              _sceneIndex;
+    const TypePredicate                               _isIndexedType;
+
+    // Ordered, to remove subtrees with a range query.
+    std::map<PXR_NS::SdfPath, _PrimBounds>            _prims;
+    std::set<PXR_NS::SdfPath>                         _dirtyPrims;
+    bool                                              _isPopulated { false };
+    bool                                              _isHierarchyValid { false };
+
+    // Bounding volume hierarchy, rebuilt on query when prims have changed.
+    std::vector<std::pair<PXR_NS::SdfPath, PXR_NS::GfRange3d>> _leaves;
+    std::vector<_Node>                                _nodes;
+    PXR_NS::SdfPathVector                             _unknownBoundsPrims;
+};
+
+}//end of namespace FVP_NS_DEF
+
+#endif //FLOW_VIEWPORT_SCENEINDEX_FVP_PRIM_BOUNDS_INDEX_H
@@ -0,0 +1,92 @@
+// Copyright 2024 Autodesk
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include "flowViewport/sceneIndex/fvpPrimTypeIndex.h"
+#include "flowViewport/fvpInstruments.h"
+
+#include <pxr/imaging/hd/sceneIndexPrimView.h>
+
+PXR_NAMESPACE_USING_DIRECTIVE
+
+namespace FVP_NS_DEF {
+
+PrimTypeIndex::PrimTypeIndex(const TypePredicate& isIndexedType)
+    : _isIndexedType(isIndexedType)
+{
+}
+
+const PrimTypeIndex::PrimTypes& PrimTypeIndex::GetPrims(const HdSceneIndexBaseRefPtr& sceneIndex)
+{
+    if (!_isPopulated) {
+        FVP_INSTRUMENTS_SCOPED_TIMER("PrimTypeIndex:Populate");
+
+        for (const SdfPath& path : HdSceneIndexPrimView(sceneIndex)) {
+            const TfToken primType = sceneIndex->GetPrim(path).primType;
+            if (_isIndexedType(primType)) {
+                _primTypes.emplace_hint(_primTypes.end(), path, primType);
+            }
+        }
+        _isPopulated = true;
+    }
+    return _primTypes;
+}
+
+void PrimTypeIndex::PrimsAdded(const HdSceneIndexObserver::AddedPrimEntries& entries)
+{
+    // Before population, the traversal will find the added prims.
+    if (!_isPopulated) {
+        return;
+    }
+
+    // Prims can be added again with a different type.
+    for (const auto& entry : entries) {
+        if (_isIndexedType(entry.primType)) {
+            _primTypes[entry.primPath] = entry.primType;
+        } else {
+            _primTypes.erase(entry.primPath);
+        }
+    }
+}
+
+void PrimTypeIndex::PrimsRemoved(const HdSceneIndexObserver::RemovedPrimEntries& entries)
+{
+    if (!_isPopulated) {
+        return;
+    }
+
+    // Removing a prim removes its descendants, which immediately follow it.
+    for (const auto& entry : entries) {
+        auto it = _primTypes.lower_bound(entry.primPath);
+        while (it != _primTypes.end() && it->first.HasPrefix(entry.primPath)) {
+            it = _primTypes.erase(it);
+        }
+    }
+}
+
+HdSceneIndexObserver::DirtiedPrimEntries PrimTypeIndex::GetDirtiedEntries(
+    const HdSceneIndexBaseRefPtr&              sceneIndex,
+    const HdDataSourceLocatorSet&              locators,
+    const std::function<bool(const SdfPath&)>& filter/* = {}*/)
+{
+    HdSceneIndexObserver::DirtiedPrimEntries entries;
+    for (const auto& primType : GetPrims(sceneIndex)) {
+        if (!filter || filter(primType.first)) {
+            entries.push_back({ primType.first, locators });
+        }
+    }
+    return entries;
+}
+
+}
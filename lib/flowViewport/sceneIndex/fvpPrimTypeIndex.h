@@ -0,0 +1,82 @@
+// Copyright 2024 Autodesk
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#ifndef FVP_PRIM_TYPE_INDEX_H
+#define FVP_PRIM_TYPE_INDEX_H
+
+#include "flowViewport/api.h"
+
+#include <pxr/base/tf/token.h>
+#include <pxr/imaging/hd/sceneIndex.h>
+#include <pxr/imaging/hd/sceneIndexObserver.h>
+#include <pxr/usd/sdf/path.h>
+
+#include <functional>
+#include <map>
+
+namespace FVP_NS_DEF {
+
+/// \class PrimTypeIndex
+///
+/// Index of the paths of the prims of some types in a scene index, for
+/// filtering scene indices which need to dirty all the prims they affect
+/// when one of their settings changes, without traversing the whole scene.
+///
+/// The index is populated with a single traversal of the scene index the
+/// first time it is queried, and kept up to date afterwards from the added
+/// and removed prims notifications of the scene index, which its owner must
+/// forward, whether it is observed or not.
+///
+class PrimTypeIndex
+{
+public:
+    using TypePredicate = std::function<bool(const PXR_NS::TfToken& primType)>;
+    // Indexed prim paths and their types, ordered so that the descendants of
+    // a path immediately follow it.
+    using PrimTypes = std::map<PXR_NS::SdfPath, PXR_NS::TfToken>;
+
+    // Only the prims whose type satisfies the predicate are indexed.
+    FVP_API
+    explicit PrimTypeIndex(const TypePredicate& isIndexedType);
+
+    // Return the indexed prims of the argument scene index, populating the
+    // index from it on first call.
+    FVP_API
+    const PrimTypes& GetPrims(const PXR_NS::HdSceneIndexBaseRefPtr& sceneIndex);
+
+    FVP_API
+    void PrimsAdded(const PXR_NS::HdSceneIndexObserver::AddedPrimEntries& entries);
+
+    FVP_API
+    void PrimsRemoved(const PXR_NS::HdSceneIndexObserver::RemovedPrimEntries& entries);
+
+    // Dirty the argument locators on all indexed prims of the argument scene
+    // index, optionally only on the prims satisfying the filter.
+    FVP_API
+    PXR_NS::HdSceneIndexObserver::DirtiedPrimEntries GetDirtiedEntries(
+        const PXR_NS::HdSceneIndexBaseRefPtr&              sceneIndex,
+        const PXR_NS::HdDataSourceLocatorSet&              locators,
+        const std::function<bool(const PXR_NS::SdfPath&)>& filter = {});
+
+    bool IsPopulated() const { return _isPopulated; }
+
+private:
+    const TypePredicate _isIndexedType;
+    PrimTypes           _primTypes;
+    bool                _isPopulated { false };
+};
+
+}
+
+#endif
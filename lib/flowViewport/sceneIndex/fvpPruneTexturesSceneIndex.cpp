@@ -16,7 +16,6 @@
 #include "flowViewport/sceneIndex/fvpPruneTexturesSceneIndex.h"
 
 #include <pxr/base/tf/staticTokens.h>
-#include <pxr/imaging/hd/sceneIndexPrimView.h>
 #include <pxr/imaging/hd/materialSchema.h>
 #include <pxr/imaging/hd/primvarsSchema.h>
 
@@ -82,7 +81,9 @@ PruneTexturesSceneIndex::MarkTexturesDirty(bool isTextured)
 PruneTexturesSceneIndex::PruneTexturesSceneIndex(
     HdSceneIndexBaseRefPtr const &inputSceneIndex)
   : HdMaterialFilteringSceneIndexBase(inputSceneIndex), 
-    InputSceneIndexUtils(inputSceneIndex)
+    InputSceneIndexUtils(inputSceneIndex),
+    // Typeless prims (transforms, scopes) have neither materials nor primvars.
+    _typedPrimsIndex([](const TfToken& primType) { return !primType.IsEmpty(); })
 {   
 }
 
@@ -98,11 +99,25 @@ void
 PruneTexturesSceneIndex::_DirtyAllPrims(
     const HdDataSourceLocatorSet locators)
 {
-    HdSceneIndexObserver::DirtiedPrimEntries entries;
-    for (const SdfPath &path : HdSceneIndexPrimView(GetInputSceneIndex())) {
-        entries.push_back({path, locators});
-    }
-    _SendPrimsDirtied(entries);
+    _SendPrimsDirtied(_typedPrimsIndex.GetDirtiedEntries(GetInputSceneIndex(), locators));
+}
+
+void
+PruneTexturesSceneIndex::_PrimsAdded(
+    const HdSceneIndexBase&                       sender,
+    const HdSceneIndexObserver::AddedPrimEntries& entries)
+{
+    _typedPrimsIndex.PrimsAdded(entries);
+    HdMaterialFilteringSceneIndexBase::_PrimsAdded(sender, entries);
+}
+
+void
+PruneTexturesSceneIndex::_PrimsRemoved(
+    const HdSceneIndexBase&                         sender,
+    const HdSceneIndexObserver::RemovedPrimEntries& entries)
+{
+    _typedPrimsIndex.PrimsRemoved(entries);
+    HdMaterialFilteringSceneIndexBase::_PrimsRemoved(sender, entries);
 }
 
 } //end of namespace FVP_NS_DEF
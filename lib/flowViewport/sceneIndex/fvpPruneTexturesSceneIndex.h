@@ -17,6 +17,7 @@
 
 #include "flowViewport/api.h"
 #include "flowViewport/sceneIndex/fvpSceneIndexUtils.h"
+#include "flowViewport/sceneIndex/fvpPrimTypeIndex.h"
 
 #include <pxr/imaging/hdsi/api.h>
 #include <pxr/imaging/hd/materialFilteringSceneIndexBase.h>
@@ -48,10 +49,21 @@ public:
     
 protected:
     FilteringFnc _GetFilteringFunction() const override;
+
+    void _PrimsAdded(
+        const PXR_NS::HdSceneIndexBase&                       sender,
+        const PXR_NS::HdSceneIndexObserver::AddedPrimEntries& entries) override;
+
+    void _PrimsRemoved(
+        const PXR_NS::HdSceneIndexBase&                         sender,
+        const PXR_NS::HdSceneIndexObserver::RemovedPrimEntries& entries) override;
     
 private:
     PruneTexturesSceneIndex(
         PXR_NS::HdSceneIndexBaseRefPtr const &inputSceneIndex);
+
+    // Typed prims : materials, and the prims using them.
+    PrimTypeIndex _typedPrimsIndex;
 };
 
 } //end of namespace FVP_NS_DEF
@@ -39,9 +39,9 @@
 #define FVP_RENDER_INDEX_PROXY_H
 
 #include "flowViewport/api.h"
+#include "flowViewport/sceneIndex/fvpMergingSceneIndex.h"
 
 #include <pxr/imaging/hd/sceneIndex.h>
-#include <pxr/imaging/hd/mergingSceneIndex.h>
 
 PXR_NAMESPACE_OPEN_SCOPE
 class HdRenderIndex;
@@ -97,7 +97,7 @@ public:
 private:
 
     PXR_NS::HdRenderIndex* const      _renderIndex{nullptr};
-    PXR_NS::HdMergingSceneIndexRefPtr _mergingSceneIndex;
+    MergingSceneIndexRefPtr           _mergingSceneIndex;
 };
 
 }//End of namespace FVP_NS_DEF
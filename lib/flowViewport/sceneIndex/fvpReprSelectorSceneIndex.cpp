@@ -24,7 +24,6 @@
 #include <pxr/imaging/hd/containerDataSourceEditor.h>
 #include <pxr/imaging/hd/legacyDisplayStyleSchema.h>
 #include <pxr/imaging/hd/primvarsSchema.h>
-#include <pxr/imaging/hd/sceneIndexPrimView.h>
 
 // This class is a filtering scene index that applies a different RepSelector on geometries (such as wireframe or wireframe on shaded)
 // and also applies an overrideWireframecolor for HdStorm 
@@ -76,7 +75,8 @@ const HdRetainedContainerDataSourceHandle sWireframeDisplayStyleDataSource
 ReprSelectorSceneIndex::ReprSelectorSceneIndex(const HdSceneIndexBaseRefPtr& inputSceneIndex, const std::shared_ptr<WireframeColorInterface>& wireframeColorInterface) 
     : ParentClass(inputSceneIndex), 
     InputSceneIndexUtils(inputSceneIndex),
-    _wireframeColorInterface(wireframeColorInterface)
+    _wireframeColorInterface(wireframeColorInterface),
+    _meshesIndex([](const TfToken& primType) { return primType == HdPrimTypeTokens->mesh; })
 {
     TF_AXIOM(_wireframeColorInterface);
 }
@@ -113,11 +113,8 @@ void
 ReprSelectorSceneIndex::_DirtyAllPrims(
     const HdDataSourceLocatorSet locators)
 {
-    HdSceneIndexObserver::DirtiedPrimEntries entries;
-    for (const SdfPath &path : HdSceneIndexPrimView(GetInputSceneIndex())) {
-        entries.push_back({path, locators});
-    }
-    _SendPrimsDirtied(entries);
+    _SendPrimsDirtied(_meshesIndex.GetDirtiedEntries(
+        GetInputSceneIndex(), locators, [this](const SdfPath& path) { return !_isExcluded(path); }));
 }
 
 HdSceneIndexPrim ReprSelectorSceneIndex::GetPrim(const SdfPath& primPath) const
@@ -18,7 +18,9 @@
 
 //Local headers
 #include "flowViewport/api.h"
+#include "flowViewport/fvpInstruments.h"
 #include "flowViewport/sceneIndex/fvpSceneIndexUtils.h"
+#include "flowViewport/sceneIndex/fvpPrimTypeIndex.h"
 #include "flowViewport/fvpWireframeColorInterface.h"
 
 //Hydra headers
@@ -81,14 +83,18 @@ ReprSelectorSceneIndex(const PXR_NS::HdSceneIndexBaseRefPtr& inputSceneIndex, co
 
     //From HdSingleInputFilteringSceneIndexBase
     void _PrimsAdded(const PXR_NS::HdSceneIndexBase& sender, const PXR_NS::HdSceneIndexObserver::AddedPrimEntries& entries) override{
+        FVP_INSTRUMENTS_SCOPED_TIMER("ReprSelectorSceneIndex:_PrimsAdded");
+        _meshesIndex.PrimsAdded(entries);
         if (!_IsObserved())return;
         _SendPrimsAdded(entries);
     }
     void _PrimsRemoved(const PXR_NS::HdSceneIndexBase& sender, const PXR_NS::HdSceneIndexObserver::RemovedPrimEntries& entries)override{
+        _meshesIndex.PrimsRemoved(entries);
         if (!_IsObserved())return;
         _SendPrimsRemoved(entries);
     }
     void _PrimsDirtied(const PXR_NS::HdSceneIndexBase& sender, const PXR_NS::HdSceneIndexObserver::DirtiedPrimEntries& entries)override{
+        FVP_INSTRUMENTS_SCOPED_TIMER("ReprSelectorSceneIndex:_PrimsDirtied");
         if (!_IsObserved())return;
         _SendPrimsDirtied(entries);
     }
@@ -109,6 +115,8 @@ ReprSelectorSceneIndex(const PXR_NS::HdSceneIndexBaseRefPtr& inputSceneIndex, co
 
     PXR_NS::HdRetainedContainerDataSourceHandle _wireframeTypeDataSource = nullptr;
     std::shared_ptr<WireframeColorInterface> _wireframeColorInterface;
+    // Only meshes are affected by the repr selection.
+    PrimTypeIndex _meshesIndex;
 };
 
 }//end of namespace FVP_NS_DEF
@@ -37,6 +37,7 @@
 //
 
 #include "flowViewport/sceneIndex/fvpSelectionSceneIndex.h"
+#include "flowViewport/fvpInstruments.h"
 #include "flowViewport/sceneIndex/fvpPathInterface.h"
 #include "flowViewport/selection/fvpSelection.h"
 #include <flowViewport/selection/fvpPathMapper.h>
@@ -218,18 +219,8 @@ void SelectionSceneIndex::ReplaceSelection(const Ufe::Selection& selection)
     TF_DEBUG(FVP_SELECTION_SCENE_INDEX)
         .Msg("SelectionSceneIndex::ReplaceSelection() called.\n");
 
-    // Process the selection replace by performing dirty notification of the
-    // existing selection state.  We could do this more efficiently by
-    // accounting for overlapping previous and new selections.
-    HdSceneIndexObserver::DirtiedPrimEntries entries;
-    auto paths = _selection->GetFullySelectedPaths();
-    entries.reserve(paths.size() + selection.size());
-    for (const auto& path : paths) {
-        entries.emplace_back(path, selectionsSchemaDefaultLocator);
-    }
-
-    _selection->Clear();
-
+    // Only dirty the paths whose selection changes : shift-adding an object
+    // to a large selection must not dirty the whole selection.
     PrimSelections sceneIndexSn;
     sceneIndexSn.reserve(selection.size());
     for (const auto& snItem : selection) {
@@ -244,11 +235,27 @@ void SelectionSceneIndex::ReplaceSelection(const Ufe::Selection& selection)
             sceneIndexSn.emplace_back(primSelection);
             TF_DEBUG(FVP_SELECTION_SCENE_INDEX)
                 .Msg("    Adding %s to the Hydra selection.\n", primSelection.primPath.GetText());
-            entries.emplace_back(primSelection.primPath, selectionsSchemaDefaultLocator);
         }
     }
 
-    _selection->Replace(sceneIndexSn);
+    Selection newSelection;
+    newSelection.Replace(sceneIndexSn);
+    const auto changedPaths = Selection::FindChangedPaths(*_selection, newSelection);
+    _selection->Replace(std::move(newSelection));
+
+    static auto& nbDirtiedCounter
+        = Instruments::instance().counter("SelectionSceneIndex:NbReplaceDirtiedPrims");
+    nbDirtiedCounter.add(changedPaths.size());
+
+    if (changedPaths.empty()) {
+        return;
+    }
+
+    HdSceneIndexObserver::DirtiedPrimEntries entries;
+    entries.reserve(changedPaths.size());
+    for (const auto& path : changedPaths) {
+        entries.emplace_back(path, selectionsSchemaDefaultLocator);
+    }
     _SendPrimsDirtied(entries);
 }
 
@@ -298,6 +305,7 @@ SelectionSceneIndex::_PrimsAdded(
     const HdSceneIndexBase &sender,
     const HdSceneIndexObserver::AddedPrimEntries &entries)
 {
+    FVP_INSTRUMENTS_SCOPED_TIMER("SelectionSceneIndex:_PrimsAdded");
     TF_DEBUG(FVP_SELECTION_SCENE_INDEX)
         .Msg("SelectionSceneIndex::_PrimsAdded() called.\n");
 
@@ -309,6 +317,7 @@ SelectionSceneIndex::_PrimsDirtied(
     const HdSceneIndexBase &sender,
     const HdSceneIndexObserver::DirtiedPrimEntries &entries)
 {
+    FVP_INSTRUMENTS_SCOPED_TIMER("SelectionSceneIndex:_PrimsDirtied");
     TF_DEBUG(FVP_SELECTION_SCENE_INDEX)
         .Msg("SelectionSceneIndex::_PrimsDirtied() called.\n");
 
@@ -15,6 +15,7 @@
 //
 
 #include "flowViewport/sceneIndex/fvpWireframeSelectionHighlightSceneIndex.h"
+#include "flowViewport/fvpInstruments.h"
 #include "flowViewport/selection/fvpSelection.h"
 #include "flowViewport/fvpUtils.h"
 
@@ -677,6 +678,7 @@ WireframeSelectionHighlightSceneIndex::_PrimsAdded(
     const HdSceneIndexBase &sender,
     const HdSceneIndexObserver::AddedPrimEntries &entries)
 {
+    FVP_INSTRUMENTS_SCOPED_TIMER("WireframeSelectionHighlightSceneIndex:_PrimsAdded");
     TF_DEBUG(FVP_WIREFRAME_SELECTION_HIGHLIGHT_SCENE_INDEX)
         .Msg("WireframeSelectionHighlightSceneIndex::_PrimsAdded() called.\n");
 
@@ -702,6 +704,7 @@ WireframeSelectionHighlightSceneIndex::_PrimsDirtied(
     const HdSceneIndexBase &sender,
     const HdSceneIndexObserver::DirtiedPrimEntries &entries)
 {
+    FVP_INSTRUMENTS_SCOPED_TIMER("WireframeSelectionHighlightSceneIndex:_PrimsDirtied");
     TF_DEBUG(FVP_WIREFRAME_SELECTION_HIGHLIGHT_SCENE_INDEX)
         .Msg("WireframeSelectionHighlightSceneIndex::_PrimsDirtied() called.\n");
 
@@ -827,12 +830,13 @@ WireframeSelectionHighlightSceneIndex::_PrimsRemoved(
     for (const auto& entry : entries) {
         // Collect and delete selection highlights for all prims rooted under the removed prim
         // (or if the removed prim itself has a highlight)
+        // Descendants of a path immediately follow it in the ordered map, so
+        // only the highlights of the removed subtree are visited.
         SdfPathVector selectionHighlightsToDelete;
-        for (const auto& selectionHighlightMirrorsForPrim : _selectionHighlightMirrorsByPrim) {
-            SdfPath primPath = selectionHighlightMirrorsForPrim.first;
-            if (primPath.HasPrefix(entry.primPath)) {
-                selectionHighlightsToDelete.push_back(primPath);
-            }
+        for (auto it = _selectionHighlightMirrorsByPrim.lower_bound(entry.primPath);
+             it != _selectionHighlightMirrorsByPrim.end() && it->first.HasPrefix(entry.primPath);
+             ++it) {
+            selectionHighlightsToDelete.push_back(it->first);
         }
         for (const auto& selectionHighlightToDelete : selectionHighlightsToDelete) {
             _DeleteSelectionHighlight(selectionHighlightToDelete);
@@ -26,6 +26,7 @@
 #include <pxr/imaging/hd/selectionsSchema.h>
 
 #include <functional>
+#include <map>
 #include <set>
 #include <unordered_map>
 
@@ -176,10 +177,14 @@ private:
     // a different mirror hierarchy for each color; in such a case, we could wrap these data members in a struct, and have 
     // one instance of this new struct for each differently colored selection highlight mirror hierarchy.
 
+    // The map of mirrors keyed by prim path is ordered, so that the descendants of a prim are
+    // contiguous and the highlights of a removed subtree can be found with a range query.
+
     // Maps a prim's path to its required selection highlight mirror paths.
-    std::unordered_map<PXR_NS::SdfPath, PXR_NS::SdfPathSet, PXR_NS::SdfPath::Hash> _selectionHighlightMirrorsByPrim;
+    std::map<PXR_NS::SdfPath, PXR_NS::SdfPathSet> _selectionHighlightMirrorsByPrim;
 
     // "Ref-counting" of selection highlight mirror prims, which are shared across prim highlights.
+    // Mirrors are only ever looked up individually, so this map is not ordered.
     std::unordered_map<PXR_NS::SdfPath, size_t, PXR_NS::SdfPath::Hash> _selectionHighlightMirrorUseCounters;
 
     // Tracks which prims contributes to using this prim's selection highlight (including itself).
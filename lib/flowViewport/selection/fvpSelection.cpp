@@ -40,8 +40,10 @@
 
 #include "flowViewport/fvpUtils.h"
 
+#include "pxr/base/tf/diagnostic.h"
 #include "pxr/imaging/hd/selectionsSchema.h"
 
+#include <algorithm>            // std::reverse
 #include <memory>               // std::shared_ptr
 
 PXR_NAMESPACE_USING_DIRECTIVE
@@ -61,7 +63,11 @@ Selection::Add(const PrimSelection& primSelection)
         return false;
     }
 
-    _pathToSelections[primSelection.primPath].push_back(primSelection);
+    auto& primSelections = _pathToSelections[primSelection.primPath];
+    if (primSelections.empty()) {
+        _AddToPrefixTree(primSelection.primPath);
+    }
+    primSelections.push_back(primSelection);
 
     return true;
 }
@@ -88,7 +94,8 @@ bool Selection::Remove(const PrimSelection& primSelection)
 
     // If no selections remain, remove the entry entirely
     if (primSelections.empty()) {
-        _pathToSelections.erase(primSelection.primPath);
+        _pathToSelections.erase(found);
+        _RemoveFromPrefixTree(primSelection.primPath);
     }
 
     return true;
@@ -98,6 +105,7 @@ void
 Selection::Clear()
 {
     _pathToSelections.clear();
+    _prefixTree.clear();
 }
 
 void Selection::Replace(const PrimSelections& primSelections)
@@ -110,11 +118,22 @@ void Selection::Replace(const PrimSelections& primSelections)
         }
         _pathToSelections[primSelection.primPath].push_back(primSelection);
     }
+
+    // Building the prefix tree once all paths are known visits each
+    // ancestor once per selected descendant, without any removal.
+    _RebuildPrefixTree();
 }
 
 void Selection::Replace(const Selection& rhs)
 {
     _pathToSelections = rhs._pathToSelections;
+    _prefixTree = rhs._prefixTree;
+}
+
+void Selection::Replace(Selection&& rhs)
+{
+    _pathToSelections = std::move(rhs._pathToSelections);
+    _prefixTree = std::move(rhs._prefixTree);
 }
 
 void Selection::RemoveHierarchy(const PXR_NS::SdfPath& primPath)
@@ -123,6 +142,14 @@ void Selection::RemoveHierarchy(const PXR_NS::SdfPath& primPath)
     while (it != _pathToSelections.end() && it->first.HasPrefix(primPath)) {
         it = _pathToSelections.erase(it);
     }
+
+    auto found = _prefixTree.find(primPath);
+    if (found == _prefixTree.end()) {
+        return;
+    }
+    const size_t nbRemoved = found->second.nbSelectedInSubtree;
+    _prefixTree.erase(found);
+    _RemoveFromAncestors(primPath, nbRemoved);
 }
 
 bool Selection::IsEmpty() const
@@ -132,17 +159,19 @@ bool Selection::IsEmpty() const
 
 bool Selection::IsFullySelected(const SdfPath& primPath) const
 {
-    return _pathToSelections.find(primPath) != _pathToSelections.end()
-        && !_pathToSelections.at(primPath).empty();
+    auto found = _prefixTree.find(primPath);
+    return found != _prefixTree.end() && found->second.selected;
 }
 
 bool Selection::HasFullySelectedAncestorInclusive(const SdfPath& primPath, const SdfPath& topmostAncestor/* = SdfPath::AbsoluteRootPath()*/) const
 {
-    // FLOW_VIEWPORT_TODO  Prefix tree would be much higher performance
-    // than iterating over the whole selection, especially for a large
-    // selection.  PPT, 13-Sep-2023.
-    for(const auto& entry : _pathToSelections) {
-        if (primPath.HasPrefix(entry.first) && entry.first.HasPrefix(topmostAncestor)) {
+    if (_prefixTree.empty()) {
+        return false;
+    }
+
+    for (SdfPath path = primPath; !path.IsEmpty() && path.HasPrefix(topmostAncestor);
+         path = path.GetParentPath()) {
+        if (IsFullySelected(path)) {
             return true;
         }
     }
@@ -151,83 +180,31 @@ bool Selection::HasFullySelectedAncestorInclusive(const SdfPath& primPath, const
 
 bool Selection::HasDescendantInclusive(const PXR_NS::SdfPath& primPath) const
 {
-    // No entries?  No descendant
-    if (_pathToSelections.empty()) {
-        return false;
-    }
-
-    // At least one entry.  Skip all entries before argument.  The iterator
-    // points to an entry with matching or greater key.
-    auto it = _pathToSelections.lower_bound(primPath);
-
-    // Reached the end?  Last entry is strictly smaller than, so no descendants.
-    if (it == _pathToSelections.end()) {
-        return false;
-    }
-
-    // Not at the end.  Query is exactly in the map, or is prefix to what is in
-    // the map (i.e. map contents is a descendant)?  Return true.
-    return (it->first == primPath || it->first.HasPrefix(primPath));
+    // Only paths with selected paths in their subtree are in the prefix tree.
+    return _prefixTree.find(primPath) != _prefixTree.end();
 }
 
 bool 
 Selection::HasAncestorOrDescendantInclusive(const PXR_NS::SdfPath& primPath) const
 {
-    // Use std::map::lower_bound to accelerate prim path lookup. The map is
-    // lexically ordered on SdfPath, with shorter paths less than longer
-    // paths. Makes determining ancestors and descendants somewhat tricky, but
-    // efficient. A prefix tree would be an easier data structure to implement
-    // this functionality.
-
-    // No entries?  No ancestors or descendants.
-    if (_pathToSelections.empty()) {
-        return false;
-    }
-
-    // At least one entry.  Skip all entries before argument.  The iterator
-    // points to an entry with matching or greater key.
-    auto it = _pathToSelections.lower_bound(primPath);
-
-    // Reached the end?  Last entry is strictly smaller than, so no descendants
-    // in map.  Check if it's an ancestor.
-    if (it == _pathToSelections.end()) {
-        auto rit = _pathToSelections.rbegin();
-        return primPath.HasPrefix(rit->first);
-    }
-
-    // Not at the end.  Map entry has matching or greater key, so check 
-    // match, or if the map entry with greater key is a descendant (i.e. query
-    // is an ancestor).
-    if (it->first == primPath ||         // Query is in map
-        it->first.HasPrefix(primPath)) { // Query descendant in map
-            return true;
-    }
-
-    // Map entry is strictly greater and not a descendant.  For the map entry
-    // to be an ancestor of the query, it would have to be less than the query.
-    // Thus, if we're at the beginning, the map entry is unrelated to the query.
-    if (it == _pathToSelections.begin()) {
-        return false;
-    }
-
-    // Map entry still strictly greater and not a descendant.  Is the previous
-    // map entry (lower key) a prefix (ancestor) to the query (i.e. query is a
-    // descendant)?
-    it = std::prev(it);
-    return primPath.HasPrefix(it->first); // Ancestor in map
+    return HasDescendantInclusive(primPath) || HasFullySelectedAncestorInclusive(primPath);
 }
 
 SdfPathVector Selection::FindFullySelectedAncestorsInclusive(const SdfPath& primPath, const SdfPath& topmostAncestor/* = SdfPath::AbsoluteRootPath()*/) const
 {
-    // FLOW_VIEWPORT_TODO  Prefix tree would be much higher performance
-    // than iterating over the whole selection, especially for a large
-    // selection.  PPT, 13-Sep-2023.
     SdfPathVector fullySelectedAncestors;
-    for(const auto& entry : _pathToSelections) {
-        if (primPath.HasPrefix(entry.first) && entry.first.HasPrefix(topmostAncestor)) {
-            fullySelectedAncestors.push_back(entry.first);
+    if (_prefixTree.empty()) {
+        return fullySelectedAncestors;
+    }
+
+    for (SdfPath path = primPath; !path.IsEmpty() && path.HasPrefix(topmostAncestor);
+         path = path.GetParentPath()) {
+        if (IsFullySelected(path)) {
+            fullySelectedAncestors.push_back(path);
         }
     }
+    // Return the ancestors from the topmost one, as sorted in the selection.
+    std::reverse(fullySelectedAncestors.begin(), fullySelectedAncestors.end());
     return fullySelectedAncestors;
 }
 
@@ -265,6 +242,41 @@ PrimSelections Selection::GetPrimSelections(const PXR_NS::SdfPath& primPath) con
     return (it == _pathToSelections.end()) ? PrimSelections() : it->second;
 }
 
+/* static */
+SdfPathVector Selection::FindChangedPaths(const Selection& from, const Selection& to)
+{
+    SdfPathVector changedPaths;
+
+    // Both maps are sorted with the same ordering, so they can be merged in a
+    // single linear pass.
+    auto fromIt = from._pathToSelections.begin();
+    auto toIt = to._pathToSelections.begin();
+    const auto fromEnd = from._pathToSelections.end();
+    const auto toEnd = to._pathToSelections.end();
+    while (fromIt != fromEnd && toIt != toEnd) {
+        if (fromIt->first < toIt->first) {
+            changedPaths.push_back(fromIt->first);
+            ++fromIt;
+        } else if (toIt->first < fromIt->first) {
+            changedPaths.push_back(toIt->first);
+            ++toIt;
+        } else {
+            if (!(fromIt->second == toIt->second)) {
+                changedPaths.push_back(fromIt->first);
+            }
+            ++fromIt;
+            ++toIt;
+        }
+    }
+    for (; fromIt != fromEnd; ++fromIt) {
+        changedPaths.push_back(fromIt->first);
+    }
+    for (; toIt != toEnd; ++toIt) {
+        changedPaths.push_back(toIt->first);
+    }
+    return changedPaths;
+}
+
 Selection::PrimSelectionsMap::const_iterator Selection::begin() const
 {
     return _pathToSelections.begin();
@@ -274,5 +286,59 @@ Selection::PrimSelectionsMap::const_iterator Selection::end() const
 {
     return _pathToSelections.end();
 }
+
+void Selection::_AddToPrefixTree(const SdfPath& primPath)
+{
+    // Inserting a path also inserts its missing ancestors.
+    auto inserted = _prefixTree.insert({primPath, _PrefixTreeEntry()}).first;
+    if (inserted->second.selected) {
+        return;
+    }
+    inserted->second.selected = true;
+    for (SdfPath path = primPath; !path.IsEmpty(); path = path.GetParentPath()) {
+        ++_prefixTree.find(path)->second.nbSelectedInSubtree;
+    }
+}
+
+void Selection::_RemoveFromPrefixTree(const SdfPath& primPath)
+{
+    auto found = _prefixTree.find(primPath);
+    if (found == _prefixTree.end() || !found->second.selected) {
+        return;
+    }
+    found->second.selected = false;
+    if (--found->second.nbSelectedInSubtree == 0) {
+        _prefixTree.erase(found);
+    }
+    _RemoveFromAncestors(primPath, 1);
+}
+
+void Selection::_RemoveFromAncestors(const SdfPath& primPath, size_t nbRemoved)
+{
+    // The topmost ancestor left without selected paths is erased with its
+    // whole subtree.
+    SdfPath topmostEmptyAncestor;
+    for (SdfPath path = primPath.GetParentPath(); !path.IsEmpty(); path = path.GetParentPath()) {
+        auto found = _prefixTree.find(path);
+        if (!TF_VERIFY(found != _prefixTree.end())) {
+            return;
+        }
+        found->second.nbSelectedInSubtree -= nbRemoved;
+        if (found->second.nbSelectedInSubtree == 0) {
+            topmostEmptyAncestor = path;
+        }
+    }
+    if (!topmostEmptyAncestor.IsEmpty()) {
+        _prefixTree.erase(topmostEmptyAncestor);
+    }
+}
+
+void Selection::_RebuildPrefixTree()
+{
+    _prefixTree.clear();
+    for (const auto& entry : _pathToSelections) {
+        _AddToPrefixTree(entry.first);
+    }
+}
     
 }
@@ -22,6 +22,7 @@
 
 #include <pxr/imaging/hd/retainedDataSource.h>
 #include <pxr/usd/sdf/path.h>
+#include <pxr/usd/sdf/pathTable.h>
 
 #include <map>
 
@@ -39,6 +40,10 @@ namespace FVP_NS_DEF {
 /// It would be desirable to add these capabilities to HdSelection and
 /// move support to OpenUSD.
 ///
+/// Selected paths are also indexed in a prefix tree, so that ancestor and
+/// descendant queries are O(depth of the queried path), independently of the
+/// size of the selection.
+///
 class Selection
 {
 public:
@@ -65,6 +70,9 @@ public:
     FVP_API
     void Replace(const Selection& selection);
 
+    FVP_API
+    void Replace(Selection&& selection);
+
     // Remove all entries from the selection.
     FVP_API
     void Clear();
@@ -114,14 +122,41 @@ public:
     FVP_API
     PrimSelections GetPrimSelections(const PXR_NS::SdfPath& primPath) const;
 
+    // Returns the paths whose selections differ between the two arguments:
+    // paths selected in only one of them, and paths selected in both with
+    // different selections.  Computed as a sorted merge of both selections.
+    FVP_API
+    static PXR_NS::SdfPathVector FindChangedPaths(const Selection& from, const Selection& to);
+
     PrimSelectionsMap::const_iterator begin() const;
     PrimSelectionsMap::const_iterator end() const;
 
 private:
-    
+
+    struct _PrefixTreeEntry
+    {
+        bool   selected { false };
+        // Number of selected paths in the subtree rooted at this path,
+        // including this path.  Entries with no selected paths in their
+        // subtree are removed from the tree.
+        size_t nbSelectedInSubtree { 0 };
+    };
+    using _PrefixTree = PXR_NS::SdfPathTable<_PrefixTreeEntry>;
+
+    void _AddToPrefixTree(const PXR_NS::SdfPath& primPath);
+    void _RemoveFromPrefixTree(const PXR_NS::SdfPath& primPath);
+    void _RebuildPrefixTree();
+
+    // Decrement the subtree counts of the strict ancestors of primPath, and
+    // remove the topmost ancestors left without selected paths.
+    void _RemoveFromAncestors(const PXR_NS::SdfPath& primPath, size_t nbRemoved);
+
     // Maps prim path to selections to be returned by the vector data
     // source at locator selections.
     PrimSelectionsMap _pathToSelections;
+
+    // Selected paths and their ancestors.
+    _PrefixTree _prefixTree;
 };
 
 }
@@ -88,6 +88,30 @@ VtValue MayaHydraAdapter::Get(const TfToken& key)
     return {};
 };
 
+size_t MayaHydraAdapter::SamplePrimvar(
+    const TfToken& key,
+    size_t         maxSampleCount,
+    float*         times,
+    VtValue*       samples)
+{
+    if (maxSampleCount < 1) {
+        return 0;
+    }
+    times[0] = 0.0f;
+    samples[0] = Get(key);
+    return 1;
+}
+
+size_t MayaHydraAdapter::SampleTransform(size_t maxSampleCount, float* times, GfMatrix4d* samples)
+{
+    if (maxSampleCount < 1) {
+        return 0;
+    }
+    times[0] = 0.0f;
+    samples[0] = GetTransform();
+    return 1;
+}
+
 bool MayaHydraAdapter::HasType(const TfToken& typeId) const
 {
     TF_UNUSED(typeId);
@@ -117,6 +117,14 @@ public:
     MAYAHYDRALIB_API
     virtual GfVec4f GetDisplayColor() const { return {1.f,1.f,1.f,1.f}; }
 
+    /// Motion samples over the shutter interval of the current frame. The default implementations
+    /// return a single sample, at the current frame.
+    MAYAHYDRALIB_API
+    virtual size_t
+    SamplePrimvar(const TfToken& key, size_t maxSampleCount, float* times, VtValue* samples);
+    MAYAHYDRALIB_API
+    virtual size_t SampleTransform(size_t maxSampleCount, float* times, GfMatrix4d* samples);
+
 protected:
     SdfPath                  _id;
     std::vector<MCallbackId> _callbacks;
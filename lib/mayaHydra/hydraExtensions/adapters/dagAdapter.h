@@ -64,7 +64,7 @@ public:
     MAYAHYDRALIB_API
     GfMatrix4d GetTransform() override;
     MAYAHYDRALIB_API
-    size_t SampleTransform(size_t maxSampleCount, float* times, GfMatrix4d* samples);
+    size_t SampleTransform(size_t maxSampleCount, float* times, GfMatrix4d* samples) override;
     MAYAHYDRALIB_API
     bool            UpdateVisibility();
     bool            IsVisible(bool checkDirty = true);
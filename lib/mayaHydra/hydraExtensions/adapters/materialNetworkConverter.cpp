@@ -19,22 +19,29 @@
 
 #include <mayaHydraLib/adapters/adapterDebugCodes.h>
 #include <mayaHydraLib/adapters/materialAdapter.h>
+#include <mayaHydraLib/adapters/materialNodeCache.h>
 #include <mayaHydraLib/adapters/mayaAttrs.h>
 #include <mayaHydraLib/adapters/tokens.h>
 #include <mayaHydraLib/hydraUtils.h>
 #include <mayaHydraLib/mixedUtils.h>
 
+#include <flowViewport/fvpInstruments.h>
+
 #include <pxr/usd/sdr/registry.h>
 #include <pxr/usd/sdr/shaderProperty.h>
 #include <pxr/usd/usdHydra/tokens.h>
 #include <pxr/usdImaging/usdImaging/tokens.h>
 
+#include <maya/MObjectHandle.h>
 #include <maya/MPlug.h>
 #include <maya/MPlugArray.h>
 #include <maya/MStatus.h>
 
+#include <memory>
 #include <mutex>
 #include <sstream>
+#include <unordered_map>
+#include <vector>
 
 PXR_NAMESPACE_OPEN_SCOPE
 // Bring the MayaHydra namespace into scope.
@@ -544,6 +551,123 @@ typedef std::unordered_map<TfToken, MayaHydraMaterialNodeConverter, TfToken::Has
 /// we use.
 NameToNodeConverterMap _nodeConverters;
 
+using _ConvertedNode = MayaHydraConvertedMaterialNode;
+using _ConvertedConnection = MayaHydraConvertedMaterialNode::Connection;
+using _ConvertedNodePtr = MayaHydraMaterialNodeCache::NodePtr;
+
+bool _IsPrimvarReader(const TfToken& identifier)
+{
+    return identifier == UsdImagingTokens->UsdPrimvarReader_float
+        || identifier == UsdImagingTokens->UsdPrimvarReader_float2
+        || identifier == UsdImagingTokens->UsdPrimvarReader_float3
+        || identifier == UsdImagingTokens->UsdPrimvarReader_float4;
+}
+
+void _ConvertParameter(
+    MFnDependencyNode&              node,
+    MayaHydraMaterialNodeConverter& nodeConverter,
+    _ConvertedNode&                 converted,
+    const TfToken&                  paramName,
+    const SdfValueTypeName&         type,
+    const VtValue*                  fallback = nullptr)
+{
+    MPlugArray plugArray;
+    VtValue    val;
+    TF_DEBUG(MAYAHYDRALIB_ADAPTER_MATERIALS).Msg("ConvertParameter(%s)\n", paramName.GetText());
+
+    auto attrConverter = nodeConverter.GetAttrConverter(paramName);
+    if (attrConverter) {
+        // Using an array of MPlug in plugArray, as some settings may have 2 or more attributes that
+        // should be taken into consideration for connections. For example : specular has a specular
+        // color and specular weight attributes, both should be considered. So after calling
+        // attrConverter->GetValue, the plugArray will contain all dependents MPlug for connections.
+        val = attrConverter->GetValue(node, paramName, type, fallback, &plugArray);
+    } else if (fallback) {
+        val = *fallback;
+    } else {
+        TF_DEBUG(MAYAHYDRALIB_ADAPTER_GET)
+            .Msg(
+                "MayaHydraMaterialNetworkConverter::ConvertParameter(): "
+                "No attrConverter found with name: %s and no fallback "
+                "given",
+                paramName.GetText());
+        val = VtValue();
+    }
+
+    converted.parameters[paramName] = val;
+
+    /*plugArray contains all dependents MPlug we should consider for connections.
+    Usually it contains 1 or 2 MPlug (2 is when dealing with a weighted attribute),
+    it can have more than 2 when dealing with the transmission which is combined with opacityR,
+    opacityG and opacityB attributes. But a limitation we have at this time is that if both the
+    color and the weight attributes have a connection, one of both connections will be ignored by
+    hydra as we have only one parameter in the UsdPreviewSurface which will have both connections
+    and hydra only considers the last connection added. There is no blending node we could use with
+    the UsdPreviewSurface. We would need the StandardSurface to be in hydra or use MaterialX to
+    build a shading network to handle this case with a multiply node for example.
+    */
+    _ConvertedConnection connection { paramName, type, {} };
+    for (auto plug : plugArray) {
+        if (plug.isNull()) {
+            break;
+        }
+
+        MPlug source = plug.source();
+        if (!source.isNull()) {
+            connection.sources.push_back(source.node());
+        }
+    }
+    if (!connection.sources.empty()) {
+        converted.connections.push_back(std::move(connection));
+    }
+}
+
+_ConvertedNodePtr _ConvertNode(
+    const MObject&                  mayaNode,
+    MFnDependencyNode&              node,
+    MayaHydraMaterialNodeConverter& nodeConverter)
+{
+    auto converted = std::make_shared<_ConvertedNode>();
+    converted->handle = MObjectHandle(mayaNode);
+    converted->identifier = nodeConverter.GetIdentifier();
+    if (converted->identifier == UsdImagingTokens->UsdPreviewSurface) {
+        for (const auto& param : MayaHydraMaterialNetworkConverter::GetPreviewShaderParams()) {
+            _ConvertParameter(
+                node, nodeConverter, *converted, param.name, param.type, &param.fallbackValue);
+        }
+
+        // If we are using a specular color which is not white, the UsdPreviewsurface specular
+        // workflow must be enabled to use the specular color which is done by setting the
+        // UsdPreviewSurface param "useSpecularWork" to 1
+        {
+            const auto it = converted->parameters.find(_specularColorToken);
+            if (it != converted->parameters.cend()) {
+                const VtValue& specColorVal = it->second;
+                if (!specColorVal.IsEmpty()
+                    && specColorVal.UncheckedGet<GfVec3f>() != GfVec3f(1, 1, 1)) {
+                    converted->parameters[_useSpecularWorkflowToken] = VtValue(1);
+                }
+            }
+        }
+
+        if (TfDebug::IsEnabled(MAYAHYDRALIB_ADAPTER_MATERIALS_PRINT_PARAMETERS_VALUES)) {
+            // DEBUG to print material parameters type and value to the output window
+            DebugPrintParameters(converted->parameters);
+        }
+
+    } else {
+        for (auto& nameAttrConverterPair : nodeConverter.GetAttrConverters()) {
+            _ConvertParameter(
+                node,
+                nodeConverter,
+                *converted,
+                nameAttrConverterPair.first,
+                nameAttrConverterPair.second->GetType());
+        }
+    }
+    return converted;
+}
+
 } // namespace
 
 /*static*/
@@ -721,6 +845,7 @@ MayaHydraMaterialNetworkConverter::MayaHydraMaterialNetworkConverter(
     , _prefix(init._prefix)
     , _pathToMobj(init._pathToMobj)
     , _enableXRayShadingMode(init._enableXRayShadingMode)
+    , _nodeCache(init._nodeCache)
 {
 }
 
@@ -749,73 +874,64 @@ HdMaterialNode* MayaHydraMaterialNetworkConverter::GetMaterial(const MObject& ma
         return &(*findResult);
     }
 
-    auto* nodeConverter
-        = MayaHydraMaterialNodeConverter::GetNodeConverter(TfToken(node.typeName().asChar()));
-    if (!nodeConverter) {
-        return nullptr;
+    static auto& nbNodeCacheHitsCounter = Fvp::Instruments::instance().counter(
+        "MayaHydraMaterialNetworkConverter:NbNodeCacheHits");
+    static auto& nbNodeCacheMissesCounter = Fvp::Instruments::instance().counter(
+        "MayaHydraMaterialNetworkConverter:NbNodeCacheMisses");
+
+    // Maya nodes are converted once per Maya scene index, and their conversion is shared by all
+    // the networks using them, until the node changes.
+    auto converted = _nodeCache ? _nodeCache->Find(mayaNode) : _ConvertedNodePtr();
+    if (converted) {
+        nbNodeCacheHitsCounter.add();
+    } else {
+        auto* nodeConverter
+            = MayaHydraMaterialNodeConverter::GetNodeConverter(TfToken(node.typeName().asChar()));
+        if (!nodeConverter) {
+            return nullptr;
+        }
+        nbNodeCacheMissesCounter.add();
+        converted = _ConvertNode(mayaNode, node, *nodeConverter);
+        if (_nodeCache) {
+            _nodeCache->Store(converted);
+        }
     }
+
     HdMaterialNode material {};
     material.path = materialPath;
-    material.identifier = nodeConverter->GetIdentifier();
-    if (material.identifier == UsdImagingTokens->UsdPreviewSurface) {
-        for (const auto& param : MayaHydraMaterialNetworkConverter::GetPreviewShaderParams()) {
-            this->ConvertParameter(
-                node, *nodeConverter, material, param.name, param.type, &param.fallbackValue);
-        }
-
-        // If we are using a specular color which is not white, the UsdPreviewsurface specular
-        // workflow must be enabled to use the specular color which is done by setting the
-        // UsdPreviewSurface param "useSpecularWork" to 1
-        {
-            const auto it = material.parameters.find(_specularColorToken);
-            if (it != material.parameters.cend()) {
-                const VtValue& specColorVal = it->second;
-                if (!specColorVal.IsEmpty()
-                    && specColorVal.UncheckedGet<GfVec3f>() != GfVec3f(1, 1, 1)) {
-                    material.parameters[_useSpecularWorkflowToken] = VtValue(1);
-                }
+    material.identifier = converted->identifier;
+    material.parameters = converted->parameters;
+
+    if (material.identifier == UsdImagingTokens->UsdPreviewSurface && _enableXRayShadingMode) {
+        // Multiply current opacity by hardcoded xRayOpacityValue
+        const auto it = material.parameters.find(_opacityToken);
+        if (it != material.parameters.cend()) {
+            const VtValue& opacityVal = it->second;
+            if (!opacityVal.IsEmpty()) {
+                material.parameters[_opacityToken]
+                    = VtValue(opacityVal.UncheckedGet<float>() * xRayOpacityValue);
             }
         }
+    }
 
-        if (_enableXRayShadingMode) {
-            // Multiply current opacity by hardcoded xRayOpacityValue
-            const auto it = material.parameters.find(_opacityToken);
-            if (it != material.parameters.cend()) {
-                const VtValue& opacityVal = it->second;
-                if (!opacityVal.IsEmpty()) {
-                    material.parameters[_opacityToken]
-                        = VtValue(opacityVal.UncheckedGet<float>() * xRayOpacityValue);
-                }
+    if (_IsPrimvarReader(material.identifier)) {
+        const auto it = material.parameters.find(MayaHydraAdapterTokens->varname);
+        if (it != material.parameters.cend()) {
+            if (TF_VERIFY(it->second.IsHolding<TfToken>())) {
+                AddPrimvar(it->second.UncheckedGet<TfToken>());
+            } else {
+                TF_WARN("Converter identified as a UsdPrimvarReader*, but "
+                        "it's "
+                        "varname did not hold a TfToken");
             }
         }
+    }
 
-        if (TfDebug::IsEnabled(MAYAHYDRALIB_ADAPTER_MATERIALS_PRINT_PARAMETERS_VALUES)) {
-            // DEBUG to print material parameters type and value to the output window
-            DebugPrintParameters(material.parameters);
-        }
-
-    } else {
-        for (auto& nameAttrConverterPair : nodeConverter->GetAttrConverters()) {
-            auto& name = nameAttrConverterPair.first;
-            auto& attrConverter = nameAttrConverterPair.second;
-            this->ConvertParameter(node, *nodeConverter, material, name, attrConverter->GetType());
-
-            if (name == MayaHydraAdapterTokens->varname
-                && (material.identifier == UsdImagingTokens->UsdPrimvarReader_float
-                    || material.identifier == UsdImagingTokens->UsdPrimvarReader_float2
-                    || material.identifier == UsdImagingTokens->UsdPrimvarReader_float3
-                    || material.identifier == UsdImagingTokens->UsdPrimvarReader_float4)) {
-                VtValue& primVarName = material.parameters[name];
-                if (TF_VERIFY(primVarName.IsHolding<TfToken>())) {
-                    AddPrimvar(primVarName.UncheckedGet<TfToken>());
-                } else {
-                    TF_WARN("Converter identified as a UsdPrimvarReader*, but "
-                            "it's "
-                            "varname did not hold a TfToken");
-                }
-            }
-        }
+    // Upstream nodes are added to the network first, so that the terminal node ends up last.
+    for (const auto& connection : converted->connections) {
+        _ConnectSources(material, connection.paramName, connection.type, connection.sources);
     }
+
     if (_pathToMobj) {
         (*_pathToMobj)[materialPath] = mayaNode;
     }
@@ -839,63 +955,36 @@ void MayaHydraMaterialNetworkConverter::ConvertParameter(
     const SdfValueTypeName&         type,
     const VtValue*                  fallback)
 {
-    MPlugArray plugArray;
-    VtValue    val;
-    TF_DEBUG(MAYAHYDRALIB_ADAPTER_MATERIALS).Msg("ConvertParameter(%s)\n", paramName.GetText());
+    _ConvertedNode converted;
+    _ConvertParameter(node, nodeConverter, converted, paramName, type, fallback);
 
-    auto attrConverter = nodeConverter.GetAttrConverter(paramName);
-    if (attrConverter) {
-        // Using an array of MPlug in plugArray, as some settings may have 2 or more attributes that
-        // should be taken into consideration for connections. For example : specular has a specular
-        // color and specular weight attributes, both should be considered. So after calling
-        // attrConverter->GetValue, the plugArray will contain all dependents MPlug for connections.
-        val = attrConverter->GetValue(node, paramName, type, fallback, &plugArray);
-    } else if (fallback) {
-        val = *fallback;
-    } else {
-        TF_DEBUG(MAYAHYDRALIB_ADAPTER_GET)
-            .Msg(
-                "MayaHydraMaterialNetworkConverter::ConvertParameter(): "
-                "No attrConverter found with name: %s and no fallback "
-                "given",
-                paramName.GetText());
-        val = VtValue();
+    material.parameters[paramName] = converted.parameters[paramName];
+    for (const auto& connection : converted.connections) {
+        _ConnectSources(material, connection.paramName, connection.type, connection.sources);
     }
+}
 
-    material.parameters[paramName] = val;
-
-    /*plugArray contains all dependents MPlug we should consider for connections.
-    Usually it contains 1 or 2 MPlug (2 is when dealing with a weighted attribute),
-    it can have more than 2 when dealing with the transmission which is combined with opacityR,
-    opacityG and opacityB attributes. But a limitation we have at this time is that if both the
-    color and the weight attributes have a connection, one of both connections will be ignored by
-    hydra as we have only one parameter in the UsdPreviewSurface which will have both connections
-    and hydra only considers the last connection added. There is no blending node we could use with
-    the UsdPreviewSurface. We would need the StandardSurface to be in hydra or use MaterialX to
-    build a shading network to handle this case with a multiply node for example.
-    */
-    for (auto plug : plugArray) {
-        if (plug.isNull()) {
+void MayaHydraMaterialNetworkConverter::_ConnectSources(
+    const HdMaterialNode&       material,
+    const TfToken&              paramName,
+    const SdfValueTypeName&     type,
+    const std::vector<MObject>& sources)
+{
+    for (const auto& source : sources) {
+        auto* sourceMat = GetMaterial(source);
+        if (!sourceMat) {
             return;
         }
-
-        MPlug source = plug.source();
-        if (!source.isNull()) {
-            auto* sourceMat = GetMaterial(source.node());
-            if (!sourceMat) {
-                return;
-            }
-            const auto& sourceMatPath = sourceMat->path;
-            if (sourceMatPath.IsEmpty()) {
-                return;
-            }
-            HdMaterialRelationship rel;
-            rel.inputId = sourceMatPath;
-            rel.inputName = GetOutputName(*sourceMat, type);
-            rel.outputId = material.path;
-            rel.outputName = paramName;
-            _network.relationships.push_back(rel);
+        const auto& sourceMatPath = sourceMat->path;
+        if (sourceMatPath.IsEmpty()) {
+            return;
         }
+        HdMaterialRelationship rel;
+        rel.inputId = sourceMatPath;
+        rel.inputName = GetOutputName(*sourceMat, type);
+        rel.outputId = material.path;
+        rel.outputName = paramName;
+        _network.relationships.push_back(rel);
     }
 }
 
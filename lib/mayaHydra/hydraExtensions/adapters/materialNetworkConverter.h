@@ -30,9 +30,12 @@
 #include <maya/MShaderManager.h>
 
 #include <unordered_map>
+#include <vector>
 
 PXR_NAMESPACE_OPEN_SCOPE
 
+class MayaHydraMaterialNodeCache;
+
 /**
  * The MayaHydraMaterialNetworkConverter class contains how we translate the Maya shaders to hydra
  * and how we do the parameters mapping, please see MayaHydraMaterialNetworkConverter::initialize()
@@ -137,20 +140,23 @@ public:
     struct MayaHydraMaterialNetworkConverterInit
     {
         MayaHydraMaterialNetworkConverterInit(
-            const SdfPath& prefix,
-            bool           enableXRayShadingMode,
-            PathToMobjMap* pathToMobj)
+            const SdfPath&              prefix,
+            bool                        enableXRayShadingMode,
+            PathToMobjMap*              pathToMobj,
+            MayaHydraMaterialNodeCache* nodeCache = nullptr)
             : _prefix(prefix)
             , _enableXRayShadingMode(enableXRayShadingMode)
             , _pathToMobj(pathToMobj)
+            , _nodeCache(nodeCache)
         {
         }
         MayaHydraMaterialNetworkConverterInit() = delete;
 
-        HdMaterialNetwork _materialNetwork;
-        const SdfPath&    _prefix;
-        bool              _enableXRayShadingMode;
-        PathToMobjMap*    _pathToMobj; // Can be a nullptr
+        HdMaterialNetwork           _materialNetwork;
+        const SdfPath&              _prefix;
+        bool                        _enableXRayShadingMode;
+        PathToMobjMap*              _pathToMobj; // Can be a nullptr
+        MayaHydraMaterialNodeCache* _nodeCache;  // Can be a nullptr, nodes are then not cached
     };
 
     MAYAHYDRALIB_API
@@ -199,10 +205,17 @@ public:
     static const MayaHydraShaderParams& GetPreviewShaderParams();
 
 private:
+    void _ConnectSources(
+        const HdMaterialNode&       material,
+        const TfToken&              paramName,
+        const SdfValueTypeName&     type,
+        const std::vector<MObject>& sources);
+
     HdMaterialNetwork& _network;
     const SdfPath&     _prefix;
     PathToMobjMap*     _pathToMobj;
     bool               _enableXRayShadingMode = false;
+    MayaHydraMaterialNodeCache* _nodeCache = nullptr;
 };
 
 PXR_NAMESPACE_CLOSE_SCOPE
@@ -0,0 +1,159 @@
+//
+// Copyright 2024 Autodesk
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include "materialNodeCache.h"
+
+#include <flowViewport/fvpInstruments.h>
+
+#include <pxr/base/tf/envSetting.h>
+
+#include <maya/MNodeMessage.h>
+
+#include <algorithm>
+
+PXR_NAMESPACE_OPEN_SCOPE
+
+TF_DEFINE_ENV_SETTING(MAYA_HYDRA_MATERIAL_NODE_CACHE_SIZE, 4096,
+    "Maximum number of converted Maya shading nodes kept in the cache of each Maya scene index.");
+
+MayaHydraMaterialNodeCache::MayaHydraMaterialNodeCache()
+    : _capacity(std::max(TfGetEnvSetting(MAYA_HYDRA_MATERIAL_NODE_CACHE_SIZE), 1))
+{
+}
+
+MayaHydraMaterialNodeCache::~MayaHydraMaterialNodeCache() { Clear(); }
+
+MayaHydraMaterialNodeCache::NodePtr MayaHydraMaterialNodeCache::Find(const MObject& mayaNode)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    const auto                  entry = _Find(mayaNode);
+    if (entry == _entries.end()) {
+        return {};
+    }
+    // Move the entry to the front of the LRU list.
+    _entries.splice(_entries.begin(), _entries, entry);
+    return entry->node;
+}
+
+void MayaHydraMaterialNodeCache::Store(const NodePtr& node)
+{
+    MObject mayaNode = node->handle.object();
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    const auto                  entry = _Find(mayaNode);
+    if (entry != _entries.end()) {
+        entry->node = node;
+        _entries.splice(_entries.begin(), _entries, entry);
+        return;
+    }
+
+    // The conversion is dropped as soon as the node changes or is removed, independently of the
+    // materials using it.
+    _Entry  newEntry { node, {} };
+    MStatus status;
+    auto    id = MNodeMessage::addNodeDirtyCallback(mayaNode, _OnNodeChanged, this, &status);
+    if (status) {
+        newEntry.callbacks.push_back(id);
+    }
+    id = MNodeMessage::addNodePreRemovalCallback(mayaNode, _OnNodeChanged, this, &status);
+    if (status) {
+        newEntry.callbacks.push_back(id);
+    }
+    _entries.push_front(std::move(newEntry));
+    _entriesByHash.emplace(node->handle.hashCode(), _entries.begin());
+    _EvictToCapacity();
+}
+
+void MayaHydraMaterialNodeCache::Invalidate(const MObject& mayaNode)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    const auto                  entry = _Find(mayaNode);
+    if (entry != _entries.end()) {
+        _Erase(entry);
+    }
+}
+
+void MayaHydraMaterialNodeCache::SetCapacity(size_t capacity)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    _capacity = std::max(capacity, size_t(1));
+    _EvictToCapacity();
+}
+
+void MayaHydraMaterialNodeCache::Clear()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    for (const auto& entry : _entries) {
+        for (auto callback : entry.callbacks) {
+            MMessage::removeCallback(callback);
+        }
+    }
+    _entries.clear();
+    _entriesByHash.clear();
+}
+
+size_t MayaHydraMaterialNodeCache::GetSize() const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _entries.size();
+}
+
+MayaHydraMaterialNodeCache::_LruList::iterator
+MayaHydraMaterialNodeCache::_Find(const MObject& mayaNode)
+{
+    const auto range = _entriesByHash.equal_range(MObjectHandle(mayaNode).hashCode());
+    for (auto it = range.first; it != range.second; ++it) {
+        if (it->second->node->handle.objectRef() == mayaNode) {
+            return it->second;
+        }
+    }
+    return _entries.end();
+}
+
+void MayaHydraMaterialNodeCache::_Erase(_LruList::iterator entry)
+{
+    for (auto callback : entry->callbacks) {
+        MMessage::removeCallback(callback);
+    }
+    const auto range = _entriesByHash.equal_range(entry->node->handle.hashCode());
+    for (auto it = range.first; it != range.second; ++it) {
+        if (it->second == entry) {
+            _entriesByHash.erase(it);
+            break;
+        }
+    }
+    _entries.erase(entry);
+}
+
+void MayaHydraMaterialNodeCache::_EvictToCapacity()
+{
+    static auto& nbEvictionsCounter
+        = Fvp::Instruments::instance().counter("MayaHydraMaterialNodeCache:NbEvictions");
+
+    while (_entries.size() > _capacity) {
+        // Evicted conversions remain valid for the networks already built from them.
+        _Erase(std::prev(_entries.end()));
+        nbEvictionsCounter.add();
+    }
+}
+
+/*static*/
+void MayaHydraMaterialNodeCache::_OnNodeChanged(MObject& node, void* clientData)
+{
+    reinterpret_cast<MayaHydraMaterialNodeCache*>(clientData)->Invalidate(node);
+}
+
+PXR_NAMESPACE_CLOSE_SCOPE
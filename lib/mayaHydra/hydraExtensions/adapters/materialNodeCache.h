@@ -0,0 +1,129 @@
+//
+// Copyright 2024 Autodesk
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#ifndef MAYAHYDRALIB_MATERIAL_NODE_CACHE_H
+#define MAYAHYDRALIB_MATERIAL_NODE_CACHE_H
+
+#include <mayaHydraLib/api.h>
+
+#include <pxr/base/tf/token.h>
+#include <pxr/base/vt/value.h>
+#include <pxr/pxr.h>
+#include <pxr/usd/sdf/valueTypeName.h>
+
+#include <maya/MMessage.h>
+#include <maya/MObject.h>
+#include <maya/MObjectHandle.h>
+
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+PXR_NAMESPACE_OPEN_SCOPE
+
+/// A Maya shading node converted to Hydra, independently of the network it is used in : the Hydra
+/// path of the node depends on the material prefix, so only its identifier, parameters and
+/// upstream nodes are kept.
+struct MayaHydraConvertedMaterialNode
+{
+    struct Connection
+    {
+        TfToken              paramName;
+        SdfValueTypeName     type;
+        std::vector<MObject> sources;
+    };
+
+    MObjectHandle              handle;
+    TfToken                    identifier;
+    std::map<TfToken, VtValue> parameters;
+    std::vector<Connection>    connections;
+};
+
+/**
+ * \brief MayaHydraMaterialNodeCache caches the Maya shading nodes converted by
+ * MayaHydraMaterialNetworkConverter, so that the nodes shared by several networks (e.g. a file
+ * texture) are only converted once. The cache installs a node dirty and a node removal callback
+ * on each cached node, and drops the node's conversion when they are called, whether or not a
+ * material still uses the node. The least recently used nodes are evicted when the cache is full.
+ * Each Maya scene index owns its cache. It is thread safe.
+ */
+class MayaHydraMaterialNodeCache
+{
+public:
+    using NodePtr = std::shared_ptr<const MayaHydraConvertedMaterialNode>;
+
+    MAYAHYDRALIB_API
+    MayaHydraMaterialNodeCache();
+
+    MAYAHYDRALIB_API
+    ~MayaHydraMaterialNodeCache();
+
+    MayaHydraMaterialNodeCache(const MayaHydraMaterialNodeCache&) = delete;
+    MayaHydraMaterialNodeCache& operator=(const MayaHydraMaterialNodeCache&) = delete;
+
+    /// Return the cached conversion of the Maya node, or nullptr if it is not cached.
+    MAYAHYDRALIB_API
+    NodePtr Find(const MObject& mayaNode);
+
+    /// Cache the conversion of a Maya node, replacing its previous conversion if any.
+    MAYAHYDRALIB_API
+    void Store(const NodePtr& node);
+
+    /// Drop the cached conversion of the Maya node.
+    MAYAHYDRALIB_API
+    void Invalidate(const MObject& mayaNode);
+
+    /// Maximum number of cached nodes. Reducing it evicts the least recently used nodes.
+    MAYAHYDRALIB_API
+    void SetCapacity(size_t capacity);
+    size_t GetCapacity() const { return _capacity; }
+
+    /// Remove all the cached nodes.
+    MAYAHYDRALIB_API
+    void Clear();
+
+    /// Number of nodes currently cached.
+    MAYAHYDRALIB_API
+    size_t GetSize() const;
+
+private:
+    struct _Entry
+    {
+        NodePtr                  node;
+        std::vector<MCallbackId> callbacks;
+    };
+    using _LruList = std::list<_Entry>;
+
+    _LruList::iterator _Find(const MObject& mayaNode);
+    void               _Erase(_LruList::iterator entry);
+    void               _EvictToCapacity();
+
+    static void _OnNodeChanged(MObject& node, void* clientData);
+
+    mutable std::mutex                                        _mutex;
+    // Most recently used entries first.
+    _LruList                                                  _entries;
+    // Keyed by MObjectHandle hash code.
+    std::unordered_multimap<unsigned int, _LruList::iterator> _entriesByHash;
+    size_t                                                    _capacity;
+};
+
+PXR_NAMESPACE_CLOSE_SCOPE
+
+#endif // MAYAHYDRALIB_MATERIAL_NODE_CACHE_H
@@ -0,0 +1,203 @@
+//
+// Copyright 2024 Autodesk
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include "materialXNetworkCache.h"
+
+#include <flowViewport/fvpInstruments.h>
+
+#include <pxr/base/arch/hash.h>
+#include <pxr/base/tf/envSetting.h>
+#include <pxr/base/tf/staticTokens.h>
+#include <pxr/usd/usd/prim.h>
+#include <pxr/usd/usd/stage.h>
+#include <pxr/usd/usdMtlx/reader.h>
+#include <pxr/usd/usdShade/material.h>
+#include <pxr/usd/usdShade/shader.h>
+#include <pxr/usd/usdShade/utils.h>
+#include <pxr/usdImaging/usdImaging/materialParamUtils.h>
+
+#include <MaterialXCore/Document.h>
+#include <MaterialXFormat/XmlIo.h>
+
+#include <algorithm>
+
+PXR_NAMESPACE_OPEN_SCOPE
+
+TF_DEFINE_ENV_SETTING(MAYA_HYDRA_MATERIALX_NETWORK_CACHE_SIZE, 512,
+    "Maximum number of translated MaterialX networks kept in the cache.");
+
+namespace {
+
+TF_DEFINE_PRIVATE_TOKENS(
+    _tokens,
+    (mtlx)
+    ((mtlxSurface, "mtlx:surface"))
+    (surface)
+);
+
+bool _TranslateMaterialXDocument(const std::string& mtlxDocStr, HdMaterialNetworkMap& networkMap)
+{
+    // Construct a MaterialX document
+    auto mtlxDoc = MaterialX::createDocument();
+    MaterialX::readFromXmlString(mtlxDoc, mtlxDocStr);
+
+    // Create a Usd Stage from the MaterialX document
+    auto stage = UsdStage::CreateInMemory("tmp.usda", TfNullPtr);
+    UsdMtlxRead(mtlxDoc, stage);
+
+    // Search for material group in the Usd Stage
+    static const SdfPath basePath("/MaterialX/Materials");
+    auto mtlxRange = stage->GetPrimAtPath(basePath).GetChildren();
+    if (mtlxRange.empty()) {
+        return false;
+    }
+
+    // There should be only one material. Fetch it.
+    UsdShadeMaterial mtlxMaterial(*mtlxRange.begin());
+    if (!mtlxMaterial) {
+        return false;
+    }
+
+    // Get MaterialX output
+    UsdShadeOutput mtlxOutput = mtlxMaterial.GetOutput(_tokens->mtlxSurface);
+    if (!mtlxOutput) {
+        return false;
+    }
+
+    // Get MaterialX shader outputs
+    UsdShadeAttributeVector mtlxShaderOutputs = 
+        UsdShadeUtils::GetValueProducingAttributes(mtlxOutput, /*shaderOutputsOnly*/true);
+    if (mtlxShaderOutputs.empty()) {
+        return false;
+    }
+
+    // Finally get MaterialX shader
+    UsdShadeShader mtlxShader(mtlxShaderOutputs[0].GetPrim());
+    if (!mtlxShader) {
+        return false;
+    }
+
+    // Convert the MaterialX shader to HdMaterialNetwork. Node paths come from the stage
+    // created above, so the network only depends on the document.
+    UsdImagingBuildHdMaterialNetworkFromTerminal(
+        mtlxShader.GetPrim(), _tokens->surface, {_tokens->mtlx},
+        {_tokens->mtlx}, &networkMap, UsdTimeCode());
+
+    return true;
+}
+
+} // namespace
+
+MayaHydraMaterialXNetworkCache& MayaHydraMaterialXNetworkCache::GetInstance()
+{
+    static MayaHydraMaterialXNetworkCache instance;
+    return instance;
+}
+
+MayaHydraMaterialXNetworkCache::MayaHydraMaterialXNetworkCache()
+    : _capacity(std::max(TfGetEnvSetting(MAYA_HYDRA_MATERIALX_NETWORK_CACHE_SIZE), 1))
+{
+}
+
+MayaHydraMaterialXNetworkCache::NetworkMapPtr
+MayaHydraMaterialXNetworkCache::GetNetworkMap(const std::string& mtlxDocument)
+{
+    static auto& nbHitsCounter
+        = Fvp::Instruments::instance().counter("MayaHydraMaterialXNetworkCache:NbHits");
+    static auto& nbMissesCounter
+        = Fvp::Instruments::instance().counter("MayaHydraMaterialXNetworkCache:NbMisses");
+
+    const uint64_t hash = ArchHash64(mtlxDocument.data(), mtlxDocument.size());
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        const auto range = _entriesByHash.equal_range(hash);
+        for (auto it = range.first; it != range.second; ++it) {
+            if (it->second->mtlxDocument == mtlxDocument) {
+                // Move the entry to the front of the LRU list.
+                _entries.splice(_entries.begin(), _entries, it->second);
+                nbHitsCounter.add();
+                return it->second->networkMap;
+            }
+        }
+    }
+
+    // Translate outside of the lock : it is the expensive part. Concurrent misses on the same
+    // document translate it more than once, but only one network is kept.
+    nbMissesCounter.add();
+    NetworkMapPtr networkMap;
+    {
+        FVP_INSTRUMENTS_SCOPED_TIMER("MayaHydraMaterialXNetworkCache:Translate");
+        auto translated = std::make_shared<HdMaterialNetworkMap>();
+        if (_TranslateMaterialXDocument(mtlxDocument, *translated)) {
+            networkMap = std::move(translated);
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    const auto range = _entriesByHash.equal_range(hash);
+    for (auto it = range.first; it != range.second; ++it) {
+        if (it->second->mtlxDocument == mtlxDocument) {
+            return it->second->networkMap;
+        }
+    }
+    _entries.push_front({ hash, mtlxDocument, networkMap });
+    _entriesByHash.emplace(hash, _entries.begin());
+    _EvictToCapacity();
+
+    return networkMap;
+}
+
+void MayaHydraMaterialXNetworkCache::SetCapacity(size_t capacity)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    _capacity = std::max(capacity, size_t(1));
+    _EvictToCapacity();
+}
+
+void MayaHydraMaterialXNetworkCache::Clear()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    _entries.clear();
+    _entriesByHash.clear();
+}
+
+size_t MayaHydraMaterialXNetworkCache::GetSize() const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _entries.size();
+}
+
+void MayaHydraMaterialXNetworkCache::_EvictToCapacity()
+{
+    static auto& nbEvictionsCounter
+        = Fvp::Instruments::instance().counter("MayaHydraMaterialXNetworkCache:NbEvictions");
+
+    while (_entries.size() > _capacity) {
+        // Evicted networks remain valid for the materials still using them.
+        const auto& lruEntry = _entries.back();
+        const auto  range = _entriesByHash.equal_range(lruEntry.hash);
+        for (auto it = range.first; it != range.second; ++it) {
+            if (it->second == std::prev(_entries.end())) {
+                _entriesByHash.erase(it);
+                break;
+            }
+        }
+        _entries.pop_back();
+        nbEvictionsCounter.add();
+    }
+}
+
+PXR_NAMESPACE_CLOSE_SCOPE
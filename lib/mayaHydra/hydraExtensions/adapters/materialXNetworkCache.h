@@ -0,0 +1,94 @@
+//
+// Copyright 2024 Autodesk
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#ifndef MAYAHYDRALIB_MATERIALX_NETWORK_CACHE_H
+#define MAYAHYDRALIB_MATERIALX_NETWORK_CACHE_H
+
+#include <mayaHydraLib/api.h>
+
+#include <pxr/imaging/hd/material.h>
+#include <pxr/pxr.h>
+
+#include <atomic>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+PXR_NAMESPACE_OPEN_SCOPE
+
+/**
+ * \brief MayaHydraMaterialXNetworkCache caches the Hydra material networks translated from
+ * MaterialX documents. Translating a document (parsing it, reading it into a USD stage and
+ * building the network) is expensive, and is otherwise done each time a MaterialX material is
+ * dirtied. Networks are looked up by a hash of the document, so that identical documents shared
+ * by several materials are only translated once. The least recently used networks are evicted
+ * when the cache is full. It is thread safe.
+ */
+class MayaHydraMaterialXNetworkCache
+{
+public:
+    using NetworkMapPtr = std::shared_ptr<const HdMaterialNetworkMap>;
+
+    MAYAHYDRALIB_API
+    static MayaHydraMaterialXNetworkCache& GetInstance();
+
+    /// Return the network translated from the MaterialX document, translating it if it is not
+    /// cached. Returns nullptr if the document could not be translated.
+    MAYAHYDRALIB_API
+    NetworkMapPtr GetNetworkMap(const std::string& mtlxDocument);
+
+    /// Maximum number of cached networks. Reducing it evicts the least recently used networks.
+    MAYAHYDRALIB_API
+    void SetCapacity(size_t capacity);
+    size_t GetCapacity() const { return _capacity; }
+
+    /// Remove all the cached networks.
+    MAYAHYDRALIB_API
+    void Clear();
+
+    /// Number of networks currently cached. Lookups and evictions are counted per frame by the
+    /// "MayaHydraMaterialXNetworkCache:NbHits", "NbMisses" and "NbEvictions" instruments counters.
+    MAYAHYDRALIB_API
+    size_t GetSize() const;
+
+private:
+    MayaHydraMaterialXNetworkCache();
+
+    struct _Entry
+    {
+        uint64_t      hash;
+        // Kept to rule out hash collisions.
+        std::string   mtlxDocument;
+        // Null if the document could not be translated, so that it is not translated again.
+        NetworkMapPtr networkMap;
+    };
+    using _LruList = std::list<_Entry>;
+
+    void _EvictToCapacity();
+
+    mutable std::mutex                                          _mutex;
+    // Most recently used entries first.
+    _LruList                                                    _entries;
+    std::unordered_multimap<uint64_t, _LruList::iterator>       _entriesByHash;
+    std::atomic<size_t>                                         _capacity;
+};
+
+PXR_NAMESPACE_CLOSE_SCOPE
+
+#endif // MAYAHYDRALIB_MATERIALX_NETWORK_CACHE_H
@@ -20,6 +20,8 @@
 #include <mayaHydraLib/adapters/adapterRegistry.h>
 #include <mayaHydraLib/adapters/mayaAttrs.h>
 #include <mayaHydraLib/adapters/tokens.h>
+#include <mayaHydraLib/adapters/topologyCache.h>
+#include <mayaHydraLib/mhBufferKernels.h>
 #include <mayaHydraLib/sceneIndex/mayaHydraSceneIndex.h>
 
 #include <pxr/base/plug/plugin.h>
@@ -39,6 +41,7 @@
 #include <maya/MShaderManager.h>
 #include <maya/MViewport2Renderer.h>
 
+#include <cstring>
 #include <functional>
 
 PXR_NAMESPACE_OPEN_SCOPE
@@ -52,6 +55,26 @@ using namespace MayaHydra;
 #define PLUG_THIS_PLUGIN \
     PlugRegistry::GetInstance().GetPluginWithName(TF_PP_STRINGIZE(MFB_PACKAGE_NAME))
 
+namespace {
+
+// Copy count elements from a Maya buffer into dst, only if they differ from what dst already
+// holds. Reuses dst's storage when possible. Returns true if dst was modified.
+template <typename T>
+bool _CopyIfChanged(VtArray<T>& dst, const T* src, size_t count, size_t* nbBytesCopied)
+{
+    if (dst.size() == count && 0 == std::memcmp(dst.cdata(), src, count * sizeof(T))) {
+        return false;
+    }
+
+    dst.assign(src, src + count);
+    if (nbBytesCopied) {
+        *nbBytesCopied += count * sizeof(T);
+    }
+    return true;
+}
+
+} // namespace
+
 /*
  * MayaHydraRenderItemAdapter is used to translate from a render item to hydra.
  * This is where we translate from Maya shapes (such as meshes) to hydra using their vertex and
@@ -129,12 +152,151 @@ void MayaHydraRenderItemAdapter::_RemoveRprim() { GetMayaHydraSceneIndex()->Remo
 // and the current frame
 void MayaHydraRenderItemAdapter::UpdateFromDelta(const UpdateFromDeltaData& data)
 {
-    if (_primitive != MHWRender::MGeometry::Primitive::kTriangles
-        && _primitive != MHWRender::MGeometry::Primitive::kLines
-        && _primitive != MHWRender::MGeometry::Primitive::kLineStrip) {
+    DeltaBuffers buffers;
+    MapDeltaBuffers(data, buffers);
+    MarkDirty(TranslateFromDelta(data, buffers));
+    UnmapDeltaBuffers(buffers);
+}
+
+bool MayaHydraRenderItemAdapter::_IsTranslatedPrimitive() const
+{
+    return _primitive == MHWRender::MGeometry::Primitive::kTriangles
+        || _primitive == MHWRender::MGeometry::Primitive::kLines
+        || _primitive == MHWRender::MGeometry::Primitive::kLineStrip;
+}
+
+// Query the render item and map the Maya buffers that TranslateFromDelta reads. This is the only
+// part of the translation which calls the Maya API, see MayaHydraSceneIndex::HandleCompleteViewportScene.
+void MayaHydraRenderItemAdapter::MapDeltaBuffers(
+    const UpdateFromDeltaData& data,
+    DeltaBuffers&              buffers) const
+{
+    if (!_IsTranslatedPrimitive()) {
         return;
     }
 
+    buffers.hideOnPlayback = data._ri.isHideOnPlayback();
+
+    using MVS = MDataServerOperation::MViewportScene;
+    const bool positionsHaveBeenReset = (0 == _positions.size());
+    bool       geomChanged = (data._flags & MVS::MVS_changedGeometry) || positionsHaveBeenReset;
+    const bool topoChanged = (data._flags & MVS::MVS_changedTopo) || positionsHaveBeenReset;
+    if (data._geometrySource || !(geomChanged || topoChanged)) {
+        return;
+    }
+
+    MGeometry* geom = data._ri.geometry();
+    const auto bbox = data._ri.boundingBox();
+    const MPoint& min = bbox.min();
+    const MPoint& max = bbox.max();
+    buffers.bounds = GfRange3d({min.x, min.y, min.z}, {max.x, max.y, max.z});
+    buffers.hasBounds = true;
+
+    const int vertexBuffercount = geom ? geom->vertexBufferCount() : 0;
+    if (vertexBuffercount <= 0) {
+        return;
+    }
+    buffers.hasVertexBuffers = true;
+
+    MVertexBuffer* positions = nullptr;
+    MVertexBuffer* normals = nullptr;
+    MVertexBuffer* uvs = nullptr;
+    MVertexBuffer* tangents = nullptr;
+    for (int vbIdx = 0; vbIdx < vertexBuffercount; vbIdx++) {
+        MVertexBuffer* mvb = geom->vertexBuffer(vbIdx);
+        if (!mvb) {
+            continue;
+        }
+        switch (mvb->descriptor().semantic()) {
+        case MGeometry::Semantic::kPosition: positions = mvb; break;
+        case MGeometry::Semantic::kNormal: normals = mvb; break;
+        case MGeometry::Semantic::kTexture: uvs = mvb; break;
+        case MGeometry::Semantic::kTangent: tangents = mvb; break;
+        default: break;
+        }
+    }
+
+    auto mapVertexBuffer = [&buffers](MVertexBuffer* mvb, DeltaBuffers::Buffer& buffer) {
+        buffer.present = true;
+        buffer.count = mvb->vertexCount();
+        buffer.dimension = mvb->descriptor().dimension();
+        buffer.data = mvb->map();
+        buffers._mappedVertexBuffers.push_back(mvb);
+    };
+
+    //Temp workaround for a bug in Maya MAYA-134200
+    //With face components selection, we have topoChanged which is true but geomChanged is false, but this is wrong, the number of vertices may have changed.
+    //We want to check here if we also need to update the geometry if the number of vertices is different from what is stored already
+    if (!geomChanged && topoChanged && positions && _positions.size() != positions->vertexCount()) {
+        buffers.vertexCountChanged = true;
+        geomChanged = true;
+    }
+
+    static const bool passNormalsToHydra = MayaHydraSceneIndex::passNormalsToHydra();
+    if (geomChanged) {
+        if (positions) {
+            mapVertexBuffer(positions, buffers.positions);
+        }
+        if (normals && passNormalsToHydra) {
+            mapVertexBuffer(normals, buffers.normals);
+        }
+    }
+
+    if (topoChanged) {
+        // Assume first stream contains the positions.
+        if (MIndexBuffer* indices = geom->indexBuffer(0)) {
+            buffers.indices.present = true;
+            buffers.indices.count = indices->size();
+            buffers.indices.data = indices->map();
+            buffers._mappedIndexBuffer = indices;
+
+            // Face varying data, like uvs, is expanded from the indices.
+            if (_primitive == MHWRender::MGeometry::Primitive::kTriangles && buffers.indices.count > 0) {
+                if (uvs) {
+                    mapVertexBuffer(uvs, buffers.uvs);
+                }
+                // Maya tangents may have a 4th component (bitangent sign), but need at least 3.
+                if (tangents && tangents->descriptor().dimension() >= 3) {
+                    mapVertexBuffer(tangents, buffers.tangents);
+                }
+            }
+        }
+
+        if (_primitive == MHWRender::MGeometry::Primitive::kTriangles) {
+            // For the OGS normals vertex buffer to be used, we need to use
+            // PxOsdOpenSubdivTokens->none
+            buffers.meshScheme = (!passNormalsToHydra
+                                  && (GetMayaHydraSceneIndex()->GetParams().displaySmoothMeshes
+                                      || GetDisplayStyle().refineLevel > 0))
+                ? PxOsdOpenSubdivTokens->catmullClark
+                : PxOsdOpenSubdivTokens->none;
+        }
+    }
+}
+
+void MayaHydraRenderItemAdapter::UnmapDeltaBuffers(DeltaBuffers& buffers)
+{
+    for (MVertexBuffer* mvb : buffers._mappedVertexBuffers) {
+        mvb->unmap();
+    }
+    buffers._mappedVertexBuffers.clear();
+    if (buffers._mappedIndexBuffer) {
+        buffers._mappedIndexBuffer->unmap();
+        buffers._mappedIndexBuffer = nullptr;
+    }
+}
+
+// Translate the Maya viewport changes into our Hydra data, without notifying the scene index.
+// This may be called from a worker thread, see MayaHydraSceneIndex::HandleCompleteViewportScene :
+// it only reads the buffers mapped by MapDeltaBuffers, and does not call the Maya API.
+HdDirtyBits MayaHydraRenderItemAdapter::TranslateFromDelta(
+    const UpdateFromDeltaData& data,
+    const DeltaBuffers&        buffers)
+{
+    if (!_IsTranslatedPrimitive()) {
+        return 0;
+    }
+
     const bool positionsHaveBeenReset
         = (0 == _positions.size()); // when positionsHaveBeenReset is true we need to recompute the
                                     // geometry and topology as our data has been cleared
@@ -142,7 +304,8 @@ void MayaHydraRenderItemAdapter::UpdateFromDelta(const UpdateFromDeltaData& data
     // const bool isNew = flags & MViewportScene::MVS_new;  //not used yet
     const bool visible          = data._flags & MVS::MVS_visible;
     const bool matrixChanged    = data._flags & MVS::MVS_changedMatrix;
-          bool geomChanged      = (data._flags & MVS::MVS_changedGeometry) || positionsHaveBeenReset;//Non const as we may modify it later => Temp workaround for a bug in Maya MAYA-134200
+    const bool geomChanged      = (data._flags & MVS::MVS_changedGeometry) || positionsHaveBeenReset
+                                  || buffers.vertexCountChanged;
     const bool topoChanged      = (data._flags & MVS::MVS_changedTopo) || positionsHaveBeenReset;
     const bool visibChanged     = data._flags & MVS::MVS_changedVisibility;
     const bool effectChanged    = data._flags & MVS::MVS_changedEffect;
@@ -154,9 +317,8 @@ void MayaHydraRenderItemAdapter::UpdateFromDelta(const UpdateFromDeltaData& data
         dirtyBits |= HdChangeTracker::DirtyPrimvar; // displayColor primVar
     }
 
-    const bool hideOnPlayback = data._ri.isHideOnPlayback();
-    if (hideOnPlayback != _isHideOnPlayback) {
-        _isHideOnPlayback = hideOnPlayback;
+    if (buffers.hideOnPlayback != _isHideOnPlayback) {
+        _isHideOnPlayback = buffers.hideOnPlayback;
         dirtyBits |= HdChangeTracker::DirtyVisibility;
     }
 
@@ -171,238 +333,174 @@ void MayaHydraRenderItemAdapter::UpdateFromDelta(const UpdateFromDeltaData& data
     if (matrixChanged) {
         dirtyBits |= HdChangeTracker::DirtyTransform;
     }
-    if (geomChanged) {
-        dirtyBits |= (HdChangeTracker::DirtyPoints | HdChangeTracker::DirtyExtent | HdChangeTracker::DirtyNormals);
-    }
+    // Points, normals and topology dirty bits are set below, only if their data actually changed.
     if (topoChanged) {
-        dirtyBits |= (HdChangeTracker::DirtyTopology | HdChangeTracker::DirtyPrimvar | HdChangeTracker::DirtyExtent);
+        dirtyBits |= (HdChangeTracker::DirtyPrimvar | HdChangeTracker::DirtyExtent);
     }
 
-    MGeometry* geom = nullptr;
-    if (geomChanged || topoChanged) {
-        geom = data._ri.geometry();
-        auto bbox = data._ri.boundingBox();
-        const MPoint& min = bbox.min();
-        const MPoint& max = bbox.max();
-        _bounds.SetRange(GfRange3d({min.x, min.y, min.z}, {max.x, max.y, max.z}));
+    if (data._geometrySource) {
+        if (geomChanged || topoChanged) {
+            dirtyBits |= _ShareGeometry(*data._geometrySource);
+        }
+        return dirtyBits;
+    }
+
+    if (buffers.hasBounds) {
+        _bounds.SetRange(buffers.bounds);
     }
     VtIntArray vertexIndices;
     VtIntArray vertexCounts;
 
-    static const bool passNormalsToHydra = MayaHydraSceneIndex::passNormalsToHydra();
-        
-    const int vertexBuffercount = geom ? geom->vertexBufferCount() : 0;
+    const bool hasVertexBuffers = buffers.hasVertexBuffers;
+    const int* indicesData = static_cast<const int*>(buffers.indices.data);
+    const int  indexCount = buffers.indices.count;
+
+    // Maya flags topology changes generously (e.g. on face components selection), so compare the
+    // index buffer with the one used to build our current topology : if it is the same, it does
+    // not need to be copied nor scanned again.
+    bool indicesUnchanged = false;
+    if (topoChanged && hasVertexBuffers && _topology && !_indices.empty()
+        && buffers.indices.present && static_cast<size_t>(indexCount) == _indices.size()) {
+        indicesUnchanged = indicesData
+            && (0 == std::memcmp(indicesData, _indices.cdata(), _indices.size() * sizeof(int)));
+    }
+    // Vertex counts are only re-determined from the buffers when the indices have changed.
+    const bool vertexCountsChanged = topoChanged && !indicesUnchanged;
 
-    //Temp workaround for a bug in Maya MAYA-134200
-    if ((!geomChanged && topoChanged) && vertexBuffercount) { 
-        //With face components selection, we have topoChanged which is true but geomChanged is false, but this is wrong, the number of vertices may have changed.
-        //We want to check here if we also need to update the geometry if the number of vertices is different from what is stored already
-        for (int vbIdx = 0; (vbIdx < vertexBuffercount) && (!geomChanged); vbIdx++) {
-            MVertexBuffer* mvb = geom->vertexBuffer(vbIdx);
-            if (!mvb) {
-                continue;
+    // Vertices
+    if (geomChanged && hasVertexBuffers && buffers.positions.present) {
+        int                vertCount = 0;
+        const unsigned int originalVertexCount = buffers.positions.count;
+        if (vertexCountsChanged) {
+            vertCount = originalVertexCount;
+        } else {
+            // Keep the previously-determined vertex count in case it was truncated.
+            const size_t positionSize = _positions.size();
+            if (positionSize > 0 && positionSize <= originalVertexCount) {
+                vertCount = positionSize;
+            } else {
+                vertCount = originalVertexCount;
             }
+        }
 
-            const MVertexBufferDescriptor& desc = mvb->descriptor();
-            const auto                     semantic = desc.semantic();
-            switch (semantic) {
-            case MGeometry::Semantic::kPosition: {
-                // Vertices
-                MVertexBuffer*     verts = mvb;
-                const unsigned int originalVertexCount = verts->vertexCount();
-                if (_positions.size() != originalVertexCount) {//Is it different ?
-                    geomChanged = true;//this will stop the loop
-                }
-            } break;
-            default: break;
+        const auto* vertexPositions = static_cast<const GfVec3f*>(buffers.positions.data);
+        if (TF_VERIFY(vertexPositions)) {
+            if (_CopyIfChanged(_positions, vertexPositions, vertCount, data._nbBytesCopied)) {
+                dirtyBits |= (HdChangeTracker::DirtyPoints | HdChangeTracker::DirtyExtent);
             }
+        } else {
+            _positions.clear();
+            dirtyBits |= (HdChangeTracker::DirtyPoints | HdChangeTracker::DirtyExtent);
         }
     }
 
-    // Vertices
-    if (geomChanged && vertexBuffercount) {
-        //vertexBuffercount > 0 means geom is non null
-        for (int vbIdx = 0; vbIdx < vertexBuffercount; vbIdx++) {
-            MVertexBuffer* mvb = geom->vertexBuffer(vbIdx);
-            if ( ! mvb) {
-                continue;
+    // Normals, only mapped if they are passed to Hydra
+    if (geomChanged && hasVertexBuffers && buffers.normals.present) {
+        int                normalsCount = 0;
+        const unsigned int originalNormalsCount = buffers.normals.count;
+        if (vertexCountsChanged) {
+            normalsCount = originalNormalsCount;
+        } else {
+            // Keep the previously-determined normals count in case it was truncated.
+            const size_t normalSize = _normals.size();
+            if (normalSize > 0 && normalSize <= originalNormalsCount) {
+                normalsCount = normalSize;
+            } else {
+                normalsCount = originalNormalsCount;
             }
+        }
 
-            const MVertexBufferDescriptor& desc = mvb->descriptor();
-            const auto semantic = desc.semantic();
-            switch(semantic){
-
-                case MGeometry::Semantic::kPosition: {
-                    //Vertices
-                    MVertexBuffer*verts = mvb;
-                    int                vertCount = 0;
-                    const unsigned int originalVertexCount = verts->vertexCount();
-                    if (topoChanged) {
-                        vertCount = originalVertexCount;
-                    } else {
-                        // Keep the previously-determined vertex count in case it was truncated.
-                        const size_t positionSize = _positions.size();
-                        if (positionSize > 0 && positionSize <= originalVertexCount) {
-                            vertCount = positionSize;
-                        } else {
-                            vertCount = originalVertexCount;
-                        }
-                    }
-
-                    _positions.clear();
-                    const auto* vertexPositions = reinterpret_cast<const GfVec3f*>(verts->map());
-                    if (TF_VERIFY(vertexPositions)) {
-                        _positions.assign(vertexPositions, vertexPositions + vertCount);
-                    }
-                    verts->unmap();
-                }
-                break;
-                case MGeometry::Semantic::kNormal: {
-                    //Normals
-                    if (passNormalsToHydra){
-                        MVertexBuffer* normals = mvb;
-                        int normalsCount = 0;
-                        const unsigned int originalNormalsCount = normals->vertexCount();
-                        if (topoChanged) {
-                            normalsCount = originalNormalsCount;
-                        } else {
-                            // Keep the previously-determined normals count in case it was truncated.
-                            const size_t normalSize = _normals.size();
-                            if (normalSize > 0 && normalSize <= originalNormalsCount) {
-                                normalsCount = normalSize;
-                            } else {
-                                normalsCount = originalNormalsCount;
-                            }
-                        }
-
-                        _normals.clear();
-                        const auto* vertexNormals = reinterpret_cast<const GfVec3f*>(normals->map());
-                        if (TF_VERIFY(vertexNormals)) {
-                            _normals.assign(vertexNormals, vertexNormals + normalsCount);
-                        }
-                        normals->unmap();
-                    }
-                }
-                break;
-                default:
-                break;
+        const auto* vertexNormals = static_cast<const GfVec3f*>(buffers.normals.data);
+        if (TF_VERIFY(vertexNormals)) {
+            if (_CopyIfChanged(_normals, vertexNormals, normalsCount, data._nbBytesCopied)) {
+                dirtyBits |= HdChangeTracker::DirtyNormals;
             }
+        } else {
+            _normals.clear();
+            dirtyBits |= HdChangeTracker::DirtyNormals;
         }
     }
 
     // Indices
-    if (topoChanged && vertexBuffercount) {
-        // Assume first stream contains the positions.
-        MIndexBuffer* indices = geom->indexBuffer(0);
-        if (indices) {
-            int indexCount = indices->size();
-            vertexIndices.resize(indexCount);
-            int* indicesData = (int*)indices->map();
+    if (topoChanged && hasVertexBuffers && buffers.indices.present) {
+        if (!indicesUnchanged) {
             // USD spamming the "topology references only upto element" message is super
             // slow.  Scanning the index array to look for an incompletely used vertex
             // buffer is innefficient, but it's better than the spammy warning. Cause of
             // the incompletely used vertex buffer is unclear.  Maya scene data just is
             // that way sometimes.
-            int maxIndex = 0;
-            for (int i = 0; i < indexCount; i++) {
-                if (indicesData[i] > maxIndex) {
-                    maxIndex = indicesData[i];
-                }
+            _maxIndex = BufferKernels::maxIndex(indicesData, indexCount);
+
+            _indices.assign(indicesData, indicesData + indexCount);
+            if (data._nbBytesCopied) {
+                *data._nbBytesCopied += indexCount * sizeof(int);
             }
+        }
+        const int maxIndex = _maxIndex;
+        vertexIndices = _indices;
 
-            vertexIndices.assign(indicesData, indicesData + indexCount);
+        if (maxIndex < (int64_t)_positions.size() - 1) {
+            _positions.resize(maxIndex + 1);
+        }
+        const size_t numNormals = _normals.size();
+        if (numNormals > 0 && (maxIndex < (int64_t)numNormals - 1)) {
+            _normals.resize(maxIndex + 1);
+        }
 
-            if (maxIndex < (int64_t)_positions.size() - 1) {
-                _positions.resize(maxIndex + 1);
-            }
-            const size_t numNormals = _normals.size();
-            if (numNormals > 0 && (maxIndex < (int64_t)numNormals - 1)) {
-                _normals.resize(maxIndex + 1);
+        switch (GetPrimitive()) {
+        case MHWRender::MGeometry::Primitive::kTriangles:
+            vertexCounts.resize(indexCount / 3);
+            vertexCounts.assign(indexCount / 3, 3);
+
+            // Face varying data from Maya like uvs
+            if (buffers.uvs.present) {
+                // Hydra supports a uv coordinate for each face-index (face varying), though we could use its own set of indices which should be smaller.
+                // Every element is overwritten, so keep the previous storage.
+                _uvs.resize(indexCount);
+                BufferKernels::gather(
+                    _uvs.data()->data(), static_cast<const float*>(buffers.uvs.data),
+                    indicesData, indexCount, 2, buffers.uvs.dimension);
+                if (data._nbBytesCopied) {
+                    *data._nbBytesCopied += indexCount * sizeof(GfVec2f);
+                }
             }
-
-            switch (GetPrimitive()) {
-            case MHWRender::MGeometry::Primitive::kTriangles:
-                vertexCounts.resize(indexCount / 3);
-                vertexCounts.assign(indexCount / 3, 3);
-
-                // Get face varying data from Maya like uvs
-                if (indexCount > 0) {
-                    
-                    MVertexBuffer* mvb = nullptr;
-
-                    for (int vbIdx = 0; vbIdx < vertexBuffercount; vbIdx++) {
-                        mvb = geom->vertexBuffer(vbIdx);
-                        if (!mvb)
-                            continue;
-
-                        const MVertexBufferDescriptor& desc = mvb->descriptor();
-                        const auto semantic = desc.semantic();
-                        switch(semantic){
-                            case MGeometry::Semantic::kTexture: {
-                                // Hydra supports a uv coordinate for each face-index (face varying), though we could use its own set of indices which should be smaller.
-                                _uvs.clear();
-                                _uvs.resize(indices->size());
-                                float* uvs = (float*)mvb->map();
-                                for (int i = 0; i < indexCount; ++i){
-                                    _uvs[i].Set(&uvs[indicesData[i] * 2]);
-                                }
-                                mvb->unmap();
-                            }
-                            break;
-                            case MHWRender::MGeometry::kTangent:{
-                                // Hydra supports a tangent for each face-index (face varying), though we could use its own set of indices which should be smaller.
-                                _tangents.clear();
-                                _tangents.resize(indices->size());
-                                float* tangents = (float*)mvb->map();
-                                for (int i = 0; i < indexCount; ++i){
-                                    _tangents[i].Set(&tangents[indicesData[i] * 2]);
-                                }
-                                mvb->unmap();
-                            }
-                            break;
-                            default:
-                            break;
-                        }
-                    }
+            if (buffers.tangents.present) {
+                // Hydra supports a tangent for each face-index (face varying), though we could use its own set of indices which should be smaller.
+                // Maya tangents may have a 4th component (bitangent sign), so use
+                // the buffer dimension as stride.
+                _tangents.resize(indexCount);
+                BufferKernels::gather(
+                    _tangents.data()->data(), static_cast<const float*>(buffers.tangents.data),
+                    indicesData, indexCount, 3, buffers.tangents.dimension);
+                if (data._nbBytesCopied) {
+                    *data._nbBytesCopied += indexCount * sizeof(GfVec3f);
                 }
-                break;
-            case MHWRender::MGeometry::Primitive::kLines:
-                vertexCounts.resize(indexCount);
-                vertexCounts.assign(indexCount / 2, 2);
-                break;
-
-            default:
-                assert(false); // unexpected/unsupported primitive type
-                break;
             }
-            indices->unmap();
+            break;
+        case MHWRender::MGeometry::Primitive::kLines:
+            vertexCounts.resize(indexCount);
+            vertexCounts.assign(indexCount / 2, 2);
+            break;
+
+        default:
+            assert(false); // unexpected/unsupported primitive type
+            break;
         }
     }
 
     if (topoChanged) {
+        // Identical topologies are shared through the topology cache, so the topology is only
+        // dirty if we end up with a different one.
+        std::shared_ptr<const HdTopology> topology = _topology;
+        auto& topologyCache = MayaHydraTopologyCache::GetInstance();
         switch (GetPrimitive()) {
-        case MGeometry::Primitive::kTriangles:{
-            static const bool passNormalsToHydra = MayaHydraSceneIndex::passNormalsToHydra();
+        case MGeometry::Primitive::kTriangles:
             if (vertexCounts.size()) {
-                if (passNormalsToHydra) {
-                    // For the OGS normals vertex buffer to be used, we need to use
-                    // PxOsdOpenSubdivTokens->none
-                    _topology.reset(new HdMeshTopology(
-                        PxOsdOpenSubdivTokens->none, 
-                        UsdGeomTokens->rightHanded,
-                        vertexCounts,
-                        vertexIndices));
-                } else {
-                    _topology.reset(new HdMeshTopology(
-                        (GetMayaHydraSceneIndex()->GetParams().displaySmoothMeshes
-                         || GetDisplayStyle().refineLevel > 0)
-                            ? PxOsdOpenSubdivTokens->catmullClark
-                            : PxOsdOpenSubdivTokens->none,
-                        UsdGeomTokens->rightHanded,
-                        vertexCounts,
-                        vertexIndices));
-                }
-            }
+                topology = topologyCache.GetMeshTopology(
+                    buffers.meshScheme,
+                    UsdGeomTokens->rightHanded,
+                    vertexCounts,
+                    vertexIndices);
             }
             break;
         case MGeometry::Primitive::kLines:
@@ -418,30 +516,63 @@ void MayaHydraRenderItemAdapter::UpdateFromDelta(const UpdateFromDeltaData& data
                 vertexCounts.assign(1, _positions.size());
                 vertexIndices = VtIntArray();
             }
-            _topology.reset(new HdBasisCurvesTopology(
+            topology = topologyCache.GetBasisCurvesTopology(
                 HdTokens->linear,
                 // basis type is ignored, due to linear curve type
                 {},
                 curveTopoType,
                 vertexCounts,
-                vertexIndices));
+                vertexIndices);
             break;
         }
         default: break;
         }
+
+        if (topology != _topology) {
+            _topology = std::move(topology);
+            dirtyBits |= HdChangeTracker::DirtyTopology;
+        }
     }
 
-    MarkDirty(dirtyBits);
+    return dirtyBits;
+}
+
+HdDirtyBits MayaHydraRenderItemAdapter::_ShareGeometry(const MayaHydraRenderItemAdapter& source)
+{
+    // VtArrays are copy on write : sharing them does not copy the data, and a later update of the
+    // source detaches its own buffers.
+    HdDirtyBits dirtyBits = 0;
+    if (!_positions.IsIdentical(source._positions)) {
+        _positions = source._positions;
+        dirtyBits |= (HdChangeTracker::DirtyPoints | HdChangeTracker::DirtyExtent);
+    }
+    if (!_normals.IsIdentical(source._normals)) {
+        _normals = source._normals;
+        dirtyBits |= HdChangeTracker::DirtyNormals;
+    }
+    if (!_tangents.IsIdentical(source._tangents) || !_uvs.IsIdentical(source._uvs)) {
+        _tangents = source._tangents;
+        _uvs = source._uvs;
+        dirtyBits |= HdChangeTracker::DirtyPrimvar;
+    }
+    _indices = source._indices;
+    _maxIndex = source._maxIndex;
+    _bounds = source._bounds;
+    if (_topology != source._topology) {
+        _topology = source._topology;
+        dirtyBits |= HdChangeTracker::DirtyTopology;
+    }
+    return dirtyBits;
 }
 
 HdMeshTopology MayaHydraRenderItemAdapter::GetMeshTopology()
 {
-    return _topology ? *static_cast<HdMeshTopology*>(_topology.get()) : HdMeshTopology();
+    return _topology ? *static_cast<const HdMeshTopology*>(_topology.get()) : HdMeshTopology();
 }
 
 HdBasisCurvesTopology MayaHydraRenderItemAdapter::GetBasisCurvesTopology()
 {
-    return _topology ? *static_cast<HdBasisCurvesTopology*>(_topology.get())
+    return _topology ? *static_cast<const HdBasisCurvesTopology*>(_topology.get())
                      : HdBasisCurvesTopology();
 }
 
@@ -30,11 +30,13 @@
 #include <pxr/pxr.h>
 
 #include <maya/MDagPath.h>
+#include <maya/MHWGeometry.h>
 #include <maya/MHWGeometryUtilities.h>
 #include <maya/MMatrix.h>
 
 #include <functional>
 #include <memory>
+#include <vector>
 
 PXR_NAMESPACE_OPEN_SCOPE
 
@@ -146,6 +148,45 @@ public:
         MRenderItem&             _ri;
         unsigned int             _flags;
         const MColor&            _wireframeColor;
+        /// If non null, the number of bytes copied from the Maya buffers is added to it.
+        size_t*                  _nbBytesCopied = nullptr;
+        /// If non null, a render item with identical geometry (e.g. the render item of another
+        /// instance of the same shape) which was already updated : its buffers and topology are
+        /// shared instead of being copied from the Maya buffers.
+        const MayaHydraRenderItemAdapter* _geometrySource = nullptr;
+    };
+
+    /// The Maya data a render item change is translated from : render item queries and mapped
+    /// Maya buffers. Filled by MapDeltaBuffers on the main thread, as the Maya API is not thread
+    /// safe, and released by UnmapDeltaBuffers.
+    class DeltaBuffers
+    {
+    public:
+        /// A mapped Maya vertex or index buffer.
+        struct Buffer
+        {
+            bool         present = false;   // The render item has this buffer
+            const void*  data = nullptr;    // Null if the buffer could not be mapped
+            unsigned int count = 0;         // Number of vertices or indices
+            unsigned int dimension = 0;     // Number of floats per vertex
+        };
+
+        bool      hideOnPlayback = false;
+        bool      vertexCountChanged = false; // Temp workaround for a bug in Maya MAYA-134200
+        bool      hasBounds = false;
+        GfRange3d bounds;
+        bool      hasVertexBuffers = false;
+        Buffer    positions;
+        Buffer    normals;
+        Buffer    uvs;
+        Buffer    tangents;
+        Buffer    indices;
+        TfToken   meshScheme;
+
+    private:
+        friend class MayaHydraRenderItemAdapter;
+        std::vector<MVertexBuffer*> _mappedVertexBuffers;
+        MIndexBuffer*               _mappedIndexBuffer = nullptr;
     };
 
     /// We receive in that function the changes made in the Maya viewport between the last frame
@@ -153,6 +194,23 @@ public:
     MAYAHYDRALIB_API
     void UpdateFromDelta(const UpdateFromDeltaData& data);
 
+    /// Query the render item and map the Maya buffers needed to translate a change. Must be
+    /// called on the main thread, before TranslateFromDelta.
+    MAYAHYDRALIB_API
+    void MapDeltaBuffers(const UpdateFromDeltaData& data, DeltaBuffers& buffers) const;
+
+    /// Unmap the Maya buffers mapped by MapDeltaBuffers. Must be called on the main thread,
+    /// after TranslateFromDelta.
+    MAYAHYDRALIB_API
+    static void UnmapDeltaBuffers(DeltaBuffers& buffers);
+
+    /// Same as UpdateFromDelta, but does not notify the scene index : the dirty bits are returned
+    /// so that the caller can mark the prim dirty later. Only reads the mapped buffers, without
+    /// calling the Maya API, and only touches this adapter's data, so different adapters can be
+    /// updated concurrently.
+    MAYAHYDRALIB_API
+    HdDirtyBits TranslateFromDelta(const UpdateFromDeltaData& data, const DeltaBuffers& buffers);
+
     MAYAHYDRALIB_API
     HdMeshTopology GetMeshTopology() override;
 
@@ -190,16 +248,22 @@ private:
     MAYAHYDRALIB_API
     void _RemoveRprim();
 
+    bool _IsTranslatedPrimitive() const;
+
+    HdDirtyBits _ShareGeometry(const MayaHydraRenderItemAdapter& source);
+
     MAYAHYDRALIB_API
     void _InsertRprim(MayaHydraAdapter* adapter);
 
     SdfPath                     _material;
     MDagPath                    _dagPath;
-    std::unique_ptr<HdTopology> _topology = nullptr;
+    std::shared_ptr<const HdTopology> _topology = nullptr; //Shared with identical topologies
     VtVec3fArray                _positions = {};
     VtVec3fArray                _normals = {};//Are per vertex
     VtVec3fArray                _tangents = {}; //Are face varying
     VtVec2fArray                _uvs = {}; //Are face varying
+    VtIntArray                  _indices = {}; //Maya index buffer our topology was built from
+    int                         _maxIndex = 0; //Highest vertex index found in _indices
     MGeometry::Primitive        _primitive;
     MString                     _name;
     GfMatrix4d                  _transform[2];
@@ -44,7 +44,8 @@ public:
 
     MAYAHYDRALIB_API
     virtual size_t
-    SamplePrimvar(const TfToken& key, size_t maxSampleCount, float* times, VtValue* samples);
+    SamplePrimvar(const TfToken& key, size_t maxSampleCount, float* times, VtValue* samples)
+        override;
     MAYAHYDRALIB_API
     virtual HdMeshTopology GetMeshTopology() override;
     MAYAHYDRALIB_API
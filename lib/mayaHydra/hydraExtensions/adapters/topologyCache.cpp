@@ -0,0 +1,127 @@
+//
+// Copyright 2024 Autodesk
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include "topologyCache.h"
+
+#include <flowViewport/fvpInstruments.h>
+
+#include <pxr/base/arch/hash.h>
+
+PXR_NAMESPACE_OPEN_SCOPE
+
+namespace {
+
+uint64_t _HashArray(const VtIntArray& array, uint64_t seed)
+{
+    return ArchHash64(
+        reinterpret_cast<const char*>(array.cdata()), array.size() * sizeof(int), seed);
+}
+
+uint64_t _HashToken(const TfToken& token, uint64_t seed)
+{
+    // Tokens are interned, so their hash identifies them.
+    const size_t tokenHash = token.Hash();
+    return ArchHash64(reinterpret_cast<const char*>(&tokenHash), sizeof(tokenHash), seed);
+}
+
+} // namespace
+
+MayaHydraTopologyCache& MayaHydraTopologyCache::GetInstance()
+{
+    static MayaHydraTopologyCache instance;
+    return instance;
+}
+
+template <typename T>
+std::shared_ptr<const T>
+MayaHydraTopologyCache::_FindOrInsert(_Cache<T>& cache, uint64_t hash, T&& topology)
+{
+    static auto& nbHitsCounter = Fvp::Instruments::instance().counter("MayaHydraTopologyCache:NbHits");
+    static auto& nbMissesCounter
+        = Fvp::Instruments::instance().counter("MayaHydraTopologyCache:NbMisses");
+
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    // Entries with the same hash are compared, to rule out hash collisions.
+    const auto range = cache.entries.equal_range(hash);
+    for (auto it = range.first; it != range.second; ++it) {
+        auto cached = it->second.lock();
+        if (cached && *cached == topology) {
+            nbHitsCounter.add();
+            return cached;
+        }
+    }
+
+    nbMissesCounter.add();
+    auto inserted = std::make_shared<const T>(std::move(topology));
+    cache.entries.emplace(hash, inserted);
+
+    // Remove the entries of the topologies which are not used anymore. Doing it every
+    // "number of entries" insertions keeps the amortized cost of insertions constant.
+    if (++cache.nbInsertions >= cache.entries.size()) {
+        for (auto it = cache.entries.begin(); it != cache.entries.end();) {
+            it = it->second.expired() ? cache.entries.erase(it) : std::next(it);
+        }
+        cache.nbInsertions = 0;
+    }
+
+    return inserted;
+}
+
+MayaHydraTopologyCache::MeshTopologyPtr MayaHydraTopologyCache::GetMeshTopology(
+    const TfToken&    scheme,
+    const TfToken&    orientation,
+    const VtIntArray& faceVertexCounts,
+    const VtIntArray& faceVertexIndices)
+{
+    // Hash the content outside of the lock, this is the most expensive part.
+    uint64_t hash = _HashArray(faceVertexIndices, 0);
+    hash = _HashArray(faceVertexCounts, hash);
+    hash = _HashToken(scheme, hash);
+    hash = _HashToken(orientation, hash);
+
+    return _FindOrInsert(
+        _meshTopologies,
+        hash,
+        HdMeshTopology(scheme, orientation, faceVertexCounts, faceVertexIndices));
+}
+
+MayaHydraTopologyCache::BasisCurvesTopologyPtr MayaHydraTopologyCache::GetBasisCurvesTopology(
+    const TfToken&    curveType,
+    const TfToken&    curveBasis,
+    const TfToken&    curveWrap,
+    const VtIntArray& curveVertexCounts,
+    const VtIntArray& curveIndices)
+{
+    uint64_t hash = _HashArray(curveIndices, 0);
+    hash = _HashArray(curveVertexCounts, hash);
+    hash = _HashToken(curveType, hash);
+    hash = _HashToken(curveBasis, hash);
+    hash = _HashToken(curveWrap, hash);
+
+    return _FindOrInsert(
+        _basisCurvesTopologies,
+        hash,
+        HdBasisCurvesTopology(curveType, curveBasis, curveWrap, curveVertexCounts, curveIndices));
+}
+
+size_t MayaHydraTopologyCache::GetSize() const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _meshTopologies.entries.size() + _basisCurvesTopologies.entries.size();
+}
+
+PXR_NAMESPACE_CLOSE_SCOPE
@@ -0,0 +1,95 @@
+//
+// Copyright 2024 Autodesk
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#ifndef MAYAHYDRALIB_TOPOLOGY_CACHE_H
+#define MAYAHYDRALIB_TOPOLOGY_CACHE_H
+
+#include <mayaHydraLib/api.h>
+
+#include <pxr/base/tf/token.h>
+#include <pxr/base/vt/array.h>
+#include <pxr/imaging/hd/basisCurvesTopology.h>
+#include <pxr/imaging/hd/meshTopology.h>
+#include <pxr/pxr.h>
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+PXR_NAMESPACE_OPEN_SCOPE
+
+/**
+ * \brief MayaHydraTopologyCache shares identical topologies between render item adapters.
+ * Topologies are looked up by a content hash of their vertex counts and indices, so that
+ * identical topologies (instances of the same shape, or the same shape over several frames)
+ * are only created once and can be compared by pointer. The cache does not own the topologies :
+ * they are destroyed when no adapter uses them anymore. It is thread safe.
+ */
+class MayaHydraTopologyCache
+{
+public:
+    using MeshTopologyPtr = std::shared_ptr<const HdMeshTopology>;
+    using BasisCurvesTopologyPtr = std::shared_ptr<const HdBasisCurvesTopology>;
+
+    MAYAHYDRALIB_API
+    static MayaHydraTopologyCache& GetInstance();
+
+    /// Return the cached mesh topology identical to the one described by the arguments, creating
+    /// it if needed.
+    MAYAHYDRALIB_API
+    MeshTopologyPtr GetMeshTopology(
+        const TfToken&    scheme,
+        const TfToken&    orientation,
+        const VtIntArray& faceVertexCounts,
+        const VtIntArray& faceVertexIndices);
+
+    /// Return the cached basis curves topology identical to the one described by the arguments,
+    /// creating it if needed.
+    MAYAHYDRALIB_API
+    BasisCurvesTopologyPtr GetBasisCurvesTopology(
+        const TfToken&    curveType,
+        const TfToken&    curveBasis,
+        const TfToken&    curveWrap,
+        const VtIntArray& curveVertexCounts,
+        const VtIntArray& curveIndices);
+
+    /// Number of topologies currently cached. Lookups are counted per frame by the
+    /// "MayaHydraTopologyCache:NbHits" and "MayaHydraTopologyCache:NbMisses" instruments counters.
+    MAYAHYDRALIB_API
+    size_t GetSize() const;
+
+private:
+    MayaHydraTopologyCache() = default;
+
+    template <typename T> struct _Cache
+    {
+        std::unordered_multimap<uint64_t, std::weak_ptr<const T>> entries;
+        // Number of insertions since the expired entries were last removed.
+        size_t nbInsertions = 0;
+    };
+
+    template <typename T>
+    std::shared_ptr<const T> _FindOrInsert(_Cache<T>& cache, uint64_t hash, T&& topology);
+
+    mutable std::mutex                  _mutex;
+    _Cache<HdMeshTopology>              _meshTopologies;
+    _Cache<HdBasisCurvesTopology>       _basisCurvesTopologies;
+};
+
+PXR_NAMESPACE_CLOSE_SCOPE
+
+#endif // MAYAHYDRALIB_TOPOLOGY_CACHE_H
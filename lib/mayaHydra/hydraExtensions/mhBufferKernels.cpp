@@ -0,0 +1,248 @@
+//
+// Copyright 2024 Autodesk
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include "mhBufferKernels.h"
+
+#include <cstring>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define MH_BUFFER_KERNELS_X64
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+// MSVC lets us use any intrinsic without changing the target architecture.
+#define MH_TARGET_AVX2
+#define MH_HAS_SSE41
+#else
+#define MH_TARGET_AVX2 __attribute__((target("avx2")))
+#if defined(__SSE4_1__)
+#define MH_HAS_SSE41
+#endif
+#endif
+#endif
+
+namespace MAYAHYDRA_NS_DEF {
+namespace BufferKernels {
+
+namespace {
+
+template <size_t N>
+void _GatherScalar(
+    float*       dst,
+    const float* src,
+    const int*   indices,
+    size_t       count,
+    size_t       srcStride)
+{
+    for (size_t i = 0; i < count; ++i) {
+        const float* element = src + size_t(indices[i]) * srcStride;
+        for (size_t c = 0; c < N; ++c) {
+            dst[c] = element[c];
+        }
+        dst += N;
+    }
+}
+
+#ifdef MH_BUFFER_KERNELS_X64
+
+bool _DetectAvx2()
+{
+#if defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7) {
+        return false;
+    }
+    // The OS must save the AVX registers on context switches.
+    __cpuid(info, 1);
+    const bool osxsave = (info[2] & (1 << 27)) != 0;
+    if (!osxsave || (_xgetbv(0) & 0x6) != 0x6) {
+        return false;
+    }
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+#else
+    return __builtin_cpu_supports("avx2");
+#endif
+}
+
+MH_TARGET_AVX2
+int _MaxIndexAvx2(const int* indices, size_t count)
+{
+    // Several accumulators to hide the latency of the max instruction.
+    __m256i max0 = _mm256_setzero_si256();
+    __m256i max1 = _mm256_setzero_si256();
+    __m256i max2 = _mm256_setzero_si256();
+    __m256i max3 = _mm256_setzero_si256();
+    size_t  i = 0;
+    for (; i + 32 <= count; i += 32) {
+        const auto* data = reinterpret_cast<const __m256i*>(indices + i);
+        max0 = _mm256_max_epi32(max0, _mm256_loadu_si256(data));
+        max1 = _mm256_max_epi32(max1, _mm256_loadu_si256(data + 1));
+        max2 = _mm256_max_epi32(max2, _mm256_loadu_si256(data + 2));
+        max3 = _mm256_max_epi32(max3, _mm256_loadu_si256(data + 3));
+    }
+    for (; i + 8 <= count; i += 8) {
+        max0 = _mm256_max_epi32(
+            max0, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(indices + i)));
+    }
+    const __m256i max256 = _mm256_max_epi32(_mm256_max_epi32(max0, max1), _mm256_max_epi32(max2, max3));
+
+    __m128i max128
+        = _mm_max_epi32(_mm256_castsi256_si128(max256), _mm256_extracti128_si256(max256, 1));
+    max128 = _mm_max_epi32(max128, _mm_shuffle_epi32(max128, _MM_SHUFFLE(1, 0, 3, 2)));
+    max128 = _mm_max_epi32(max128, _mm_shuffle_epi32(max128, _MM_SHUFFLE(2, 3, 0, 1)));
+
+    int result = _mm_cvtsi128_si32(max128);
+    for (; i < count; ++i) {
+        if (indices[i] > result) {
+            result = indices[i];
+        }
+    }
+    return result;
+}
+
+MH_TARGET_AVX2
+void _GatherVec2Avx2(
+    float*       dst,
+    const float* src,
+    const int*   indices,
+    size_t       count,
+    size_t       srcStride)
+{
+    // A 2 floats element is 64 bits : gather 4 of them at once.
+    const __m128i stride = _mm_set1_epi32(int(srcStride));
+    const auto*   base = reinterpret_cast<const long long*>(src);
+    size_t        i = 0;
+    for (; i + 4 <= count; i += 4) {
+        const __m128i idx = _mm_mullo_epi32(
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(indices + i)), stride);
+        const __m256i elements = _mm256_i32gather_epi64(base, idx, sizeof(float));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i * 2), elements);
+    }
+    _GatherScalar<2>(dst + i * 2, src, indices + i, count - i, srcStride);
+}
+
+#endif // MH_BUFFER_KERNELS_X64
+
+#ifdef MH_HAS_SSE41
+
+int _MaxIndexSse41(const int* indices, size_t count)
+{
+    __m128i max0 = _mm_setzero_si128();
+    __m128i max1 = _mm_setzero_si128();
+    size_t  i = 0;
+    for (; i + 8 <= count; i += 8) {
+        const auto* data = reinterpret_cast<const __m128i*>(indices + i);
+        max0 = _mm_max_epi32(max0, _mm_loadu_si128(data));
+        max1 = _mm_max_epi32(max1, _mm_loadu_si128(data + 1));
+    }
+    __m128i max128 = _mm_max_epi32(max0, max1);
+    max128 = _mm_max_epi32(max128, _mm_shuffle_epi32(max128, _MM_SHUFFLE(1, 0, 3, 2)));
+    max128 = _mm_max_epi32(max128, _mm_shuffle_epi32(max128, _MM_SHUFFLE(2, 3, 0, 1)));
+
+    int result = _mm_cvtsi128_si32(max128);
+    for (; i < count; ++i) {
+        if (indices[i] > result) {
+            result = indices[i];
+        }
+    }
+    return result;
+}
+
+#endif // MH_HAS_SSE41
+
+} // namespace
+
+bool isAvx2Supported()
+{
+#ifdef MH_BUFFER_KERNELS_X64
+    static const bool avx2 = _DetectAvx2();
+    return avx2;
+#else
+    return false;
+#endif
+}
+
+int maxIndexScalar(const int* indices, size_t count)
+{
+    int result = 0;
+    for (size_t i = 0; i < count; ++i) {
+        if (indices[i] > result) {
+            result = indices[i];
+        }
+    }
+    return result;
+}
+
+int maxIndex(const int* indices, size_t count)
+{
+#ifdef MH_BUFFER_KERNELS_X64
+    if (isAvx2Supported()) {
+        return _MaxIndexAvx2(indices, count);
+    }
+#endif
+#ifdef MH_HAS_SSE41
+    return _MaxIndexSse41(indices, count);
+#else
+    return maxIndexScalar(indices, count);
+#endif
+}
+
+void gatherScalar(
+    float*       dst,
+    const float* src,
+    const int*   indices,
+    size_t       count,
+    size_t       nbComponents,
+    size_t       srcStride)
+{
+    switch (nbComponents) {
+    case 2: _GatherScalar<2>(dst, src, indices, count, srcStride); break;
+    case 3: _GatherScalar<3>(dst, src, indices, count, srcStride); break;
+    case 4: _GatherScalar<4>(dst, src, indices, count, srcStride); break;
+    default:
+        for (size_t i = 0; i < count; ++i) {
+            std::memcpy(
+                dst + i * nbComponents,
+                src + size_t(indices[i]) * srcStride,
+                nbComponents * sizeof(float));
+        }
+        break;
+    }
+}
+
+void gather(
+    float*       dst,
+    const float* src,
+    const int*   indices,
+    size_t       count,
+    size_t       nbComponents,
+    size_t       srcStride)
+{
+#ifdef MH_BUFFER_KERNELS_X64
+    // Larger elements are copied as efficiently by the scalar loop, since each
+    // of them is read with contiguous loads.
+    if (nbComponents == 2 && isAvx2Supported()) {
+        _GatherVec2Avx2(dst, src, indices, count, srcStride);
+        return;
+    }
+#endif
+    gatherScalar(dst, src, indices, count, nbComponents, srcStride);
+}
+
+} // namespace BufferKernels
+} // namespace MAYAHYDRA_NS_DEF
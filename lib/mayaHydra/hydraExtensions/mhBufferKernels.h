@@ -0,0 +1,68 @@
+//
+// Copyright 2024 Autodesk
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#ifndef MAYA_HYDRA_BUFFER_KERNELS_H
+#define MAYA_HYDRA_BUFFER_KERNELS_H
+
+#include "mayaHydraLib/api.h"
+
+#include <cstddef>
+
+// Kernels used to convert Maya VP2 vertex and index buffers to Hydra data.
+// They only depend on the C++ standard library, so they can be benchmarked
+// without Maya. On x86-64, AVX2 versions are used when the CPU supports them
+// (detected at runtime), otherwise SSE4.1 or scalar versions are used.
+
+namespace MAYAHYDRA_NS_DEF {
+namespace BufferKernels {
+
+/// Return the highest value in indices, or 0 if there is none higher than 0.
+MAYAHYDRALIB_API
+int maxIndex(const int* indices, size_t count);
+
+/// Expand vertex data to face-varying data : for i in [0, count), copy the
+/// nbComponents floats of element indices[i] of src to element i of dst.
+/// srcStride is the number of floats between two elements of src, it must be
+/// greater or equal to nbComponents. dst is tightly packed.
+MAYAHYDRALIB_API
+void gather(
+    float*       dst,
+    const float* src,
+    const int*   indices,
+    size_t       count,
+    size_t       nbComponents,
+    size_t       srcStride);
+
+/// Scalar versions of the above, used as reference and fallback.
+MAYAHYDRALIB_API
+int maxIndexScalar(const int* indices, size_t count);
+
+MAYAHYDRALIB_API
+void gatherScalar(
+    float*       dst,
+    const float* src,
+    const int*   indices,
+    size_t       count,
+    size_t       nbComponents,
+    size_t       srcStride);
+
+/// Return true if the AVX2 versions are used by maxIndex and gather.
+MAYAHYDRALIB_API
+bool isAvx2Supported();
+
+} // namespace BufferKernels
+} // namespace MAYAHYDRA_NS_DEF
+
+#endif // MAYA_HYDRA_BUFFER_KERNELS_H
@@ -15,3 +15,33 @@
 //
 
 #include <mayaHydraLib/pick/mhPickHandler.h>
+
+#include <pxr/imaging/hdx/pickTask.h>
+
+namespace MAYAHYDRA_NS_DEF {
+
+bool PickHandler::handlePickHits(
+    const BatchInput& pickInput, Output& pickOutput
+) const
+{
+    bool handled = false;
+    for (const HdxPickHit* pickHit : pickInput.pickHits) {
+        handled |= handlePickHit(
+            Input(*pickHit, pickInput.pickInfo, pickInput.isSolePickHit), pickOutput);
+    }
+    return handled;
+}
+
+const HdxPickHit* PickHandler::findSingleNodeComponentsPickHit(
+    const BatchInput& pickInput
+) const
+{
+    for (const HdxPickHit* pickHit : pickInput.pickHits) {
+        if (inSingleNodeComponentsPick(*pickHit)) {
+            return pickHit;
+        }
+    }
+    return nullptr;
+}
+
+}
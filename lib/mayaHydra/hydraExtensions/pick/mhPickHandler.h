@@ -25,6 +25,8 @@
 
 #include <ufe/namedSelection.h>
 
+#include <vector>
+
 PXR_NAMESPACE_OPEN_SCOPE
 struct HdxPickHit;
 PXR_NAMESPACE_CLOSE_SCOPE
@@ -48,6 +50,7 @@ class PickHandler
 public:
 
     struct Input;
+    struct BatchInput;
     struct Output;
 
     MAYAHYDRALIB_API
@@ -55,10 +58,33 @@ public:
         const Input& pickInput, Output& pickOutput
     ) const = 0;
 
+    /// Handle a run of consecutive pick hits of a pick that map to this pick
+    /// handler.  Runs are handled in pick order, so a pick handler may be
+    /// called several times per pick when hits of other pick handlers are
+    /// interleaved.  Pick handlers which can share work between hits (e.g.
+    /// many hits on the same prim) should override this.  The default implementation
+    /// calls handlePickHit() for each hit.  Returns true if any hit was
+    /// added to the output.
+    MAYAHYDRALIB_API
+    virtual bool handlePickHits(
+        const BatchInput& pickInput, Output& pickOutput
+    ) const;
+
     MAYAHYDRALIB_API
     virtual bool inSingleNodeComponentsPick(const HdxPickHit&) const {
         return false;
     }
+
+    /// Return the first of a run of consecutive pick hits that map to this
+    /// pick handler which is on a node in components picking mode, or nullptr
+    /// if there is none.  Called for each run, before handlePickHits(), so
+    /// that pick handlers can fetch the components picking mode state once
+    /// for all the hits of the run.  The default implementation calls
+    /// inSingleNodeComponentsPick() for each hit.
+    MAYAHYDRALIB_API
+    virtual const HdxPickHit* findSingleNodeComponentsPickHit(
+        const BatchInput& pickInput
+    ) const;
 };
 
 /// \class PickHandler::Input
@@ -76,6 +102,23 @@ struct PickHandler::Input {
     const bool                       isSolePickHit;
 };
 
+/// \class PickHandler::BatchInput
+///
+/// Batch picking input consists of a run of consecutive Hydra pick hits for a
+/// single pick handler, in pick order, and the Maya selection state.  isSolePickHit is
+/// true when the batch holds the only hit of the pick.
+struct PickHandler::BatchInput {
+    BatchInput(
+        const std::vector<const HdxPickHit*>& pickHitsArg, 
+        const MHWRender::MSelectionInfo&      pickInfoArg,
+        const bool                            isSolePickHitArg
+    ) : pickHits(pickHitsArg), pickInfo(pickInfoArg), isSolePickHit(isSolePickHitArg) {}
+
+    const std::vector<const HdxPickHit*>& pickHits;
+    const MHWRender::MSelectionInfo&      pickInfo;
+    const bool                            isSolePickHit;
+};
+
 /// \class PickHandler::Output
 ///
 /// Picking output can go either to the UFE representation of the Maya selection
@@ -37,6 +37,9 @@
 #include <ufe/hierarchy.h>
 #include <ufe/selection.h>
 
+#include <unordered_map>
+#include <unordered_set>
+
 PXR_NAMESPACE_OPEN_SCOPE
 
 // Copy-pasted and adapted from maya-usd's
@@ -230,17 +233,20 @@ Ufe::Path usdPathToUfePath(
 }
 
 #if PXR_VERSION >= 2403
-std::vector<UsdPickHandler::HitPath> resolveGeomSubsetsPicking(
+// Prim origin paths of the geomSubsets of a mesh, indexed by element (e.g.
+// face) index.
+using GeomSubsetsByElement = std::unordered_map<int, SdfPathVector>;
+
+GeomSubsetsByElement collectGeomSubsets(
     HdSceneIndexBaseConstRefPtr sceneIndex, 
     const SdfPath& basePrimPath, 
-    const TfToken& geomSubsetType, 
-    int componentIndex)
+    const TfToken& geomSubsetType)
 {
-    if (componentIndex < 0 || sceneIndex->GetPrim(basePrimPath).primType != HdPrimTypeTokens->mesh) {
-        return {};
+    GeomSubsetsByElement geomSubsets;
+    if (sceneIndex->GetPrim(basePrimPath).primType != HdPrimTypeTokens->mesh) {
+        return geomSubsets;
     }
 
-    std::vector<UsdPickHandler::HitPath> pickedGeomSubsets;
     auto childPaths = sceneIndex->GetChildPrimPaths(basePrimPath);
     for (const auto& childPath : childPaths) {
         HdSceneIndexPrim childPrim = sceneIndex->GetPrim(childPath);
@@ -257,18 +263,18 @@ std::vector<UsdPickHandler::HitPath> resolveGeomSubsetsPicking(
             continue;
         }
 
+        HdPrimOriginSchema primOriginSchema = HdPrimOriginSchema::GetFromParent(childPrim.dataSource);
+        if (!primOriginSchema.IsDefined()) {
+            continue;
+        }
+        auto usdPath = primOriginSchema.GetOriginPath(HdPrimOriginSchemaTokens->scenePath);
+
         auto geomSubsetIndices = geomSubsetSchema.GetIndices()->GetTypedValue(0);
         for (const auto& index : geomSubsetIndices) {
-            if (index == componentIndex) {
-                HdPrimOriginSchema primOriginSchema = HdPrimOriginSchema::GetFromParent(childPrim.dataSource);
-                if (primOriginSchema.IsDefined()) {
-                    auto usdPath = primOriginSchema.GetOriginPath(HdPrimOriginSchemaTokens->scenePath);
-                    pickedGeomSubsets.push_back({usdPath, -1});
-                }
-            }
+            geomSubsets[index].push_back(usdPath);
         }
     }
-    return pickedGeomSubsets;
+    return geomSubsets;
 }
 #endif
 
@@ -276,7 +282,8 @@ std::vector<UsdPickHandler::HitPath> resolveGeomSubsetsPicking(
 // that corresponds to the pick hit.  If the pick hit is not an instance,
 // the instance index will be -1.  HdRenderIndex is non-const because of
 // HdxPrimOriginInfo::FromPickHit() requirements.
-UsdPickHandler::HitPath resolveInstancePicking(HdRenderIndex& renderIndex, const HdxPickHit& pickHit)
+UsdPickHandler::HitPath resolveInstancePicking(
+    HdRenderIndex& renderIndex, const HdxPickHit& pickHit, UsdPointInstancesPickMode pickMode)
 {
     auto primOrigin = HdxPrimOriginInfo::FromPickHit(&renderIndex, pickHit);
 
@@ -303,7 +310,7 @@ UsdPickHandler::HitPath resolveInstancePicking(HdRenderIndex& renderIndex, const
         auto instanceOriginPath = instanceOriginSchema.GetOriginPath(HdPrimOriginSchemaTokens->scenePath);
 
         // EMSUSD-1220 : Native instances picking depends on the Point Instances pick mode. 
-        if (GetPointInstancesPickMode() != UsdPointInstancesPickMode::Prototypes) {
+        if (pickMode != UsdPointInstancesPickMode::Prototypes) {
             // "PointInstancer" and "Instances" pick modes : select the instanced prim
             return {instanceOriginPath, -1};
         }
@@ -321,12 +328,64 @@ UsdPickHandler::HitPath resolveInstancePicking(HdRenderIndex& renderIndex, const
     // Explicit prototype instancing (i.e. USD point instancing).
     std::function<UsdPickHandler::HitPath(const HdxPrimOriginInfo& primOrigin, const HdxPickHit& hit)> pickFn[] = {pickInstancer, pickInstance, pickPrototype};
                         
-    // Retrieve pick mode from mayaUsd optionVar, to see if we're picking
+    // The pick mode from the mayaUsd optionVar tells if we're picking
     // instances, the instancer itself, or the prototype instanced by the
     // point instance.
-    return pickFn[GetPointInstancesPickMode()](primOrigin, pickHit);
+    return pickFn[pickMode](primOrigin, pickHit);
 }
 
+// Selection kind resolution for the pick hits of a batch on one scene index
+// registration.  The stage is obtained once, and the kind ancestor of each
+// picked prim is only searched for once.
+class KindResolver
+{
+public:
+    KindResolver(const MayaHydraSceneIndexRegistrationPtr& registration, const TfToken& kind)
+        : _registration(registration), _kind(kind) {}
+
+    SdfPath resolve(const SdfPath& pickedUsdPath)
+    {
+        auto found = _kindPaths.find(pickedUsdPath);
+        if (found != _kindPaths.end()) {
+            return found->second;
+        }
+
+        SdfPath usdPath = pickedUsdPath;
+        if (const auto& stage = getStage()) {
+            auto prim = GetPrimOrAncestorWithKind(stage->GetPrimAtPath(pickedUsdPath), _kind);
+            if (prim) {
+                usdPath = prim.GetPath();
+            }
+        }
+        _kindPaths.emplace(pickedUsdPath, usdPath);
+        return usdPath;
+    }
+
+private:
+    const UsdStageRefPtr& getStage()
+    {
+        if (!_stageQueried) {
+            _stageQueried = true;
+            // Get the stage from the proxy shape, to access the UsdModelAPI
+            // of the picked prims.
+            auto proxyShapeObj = _registration->dagNode.object();
+            if (proxyShapeObj.isNull()) {
+                TF_FATAL_ERROR("No mayaUsd proxy shape object corresponds to USD pick");
+            } else {
+                MayaUsdAPI::ProxyStage proxyStage{proxyShapeObj};
+                _stage = proxyStage.getUsdStage();
+            }
+        }
+        return _stage;
+    }
+
+    const MayaHydraSceneIndexRegistrationPtr                _registration;
+    const TfToken                                           _kind;
+    bool                                                    _stageQueried{false};
+    UsdStageRefPtr                                          _stage;
+    std::unordered_map<SdfPath, SdfPath, SdfPath::Hash>     _kindPaths;
+};
+
 }
 
 namespace MAYAHYDRA_NS_DEF {
@@ -334,6 +393,15 @@ namespace MAYAHYDRA_NS_DEF {
 bool UsdPickHandler::handlePickHit(
     const Input& pickInput, Output& pickOutput
 ) const
+{
+    const std::vector<const HdxPickHit*> pickHits{&pickInput.pickHit};
+    return handlePickHits(
+        BatchInput(pickHits, pickInput.pickInfo, pickInput.isSolePickHit), pickOutput);
+}
+
+bool UsdPickHandler::handlePickHits(
+    const BatchInput& pickInput, Output& pickOutput
+) const
 {
     if (!sceneIndexRegistry()) {
         TF_FATAL_ERROR("Picking called while no scene index registry exists");
@@ -345,86 +413,114 @@ bool UsdPickHandler::handlePickHit(
         return false;
     }
 
-    auto registration = sceneIndexRegistry()->GetSceneIndexRegistrationForRprim(pickInput.pickHit.objectId);
-
-    if (!registration) {
-        return false;
-    }
+    // A region pick on a dense asset produces many hits on the same rprims
+    // and kind ancestors, so the option vars are read once, and the
+    // registration, geomSubsets and kind lookups are memoized for the batch.
+    const auto pointInstancesPickMode = GetPointInstancesPickMode();
+    const auto snKind = GetSelectionKind();
+#if PXR_VERSION >= 2403
+    const bool pickGeomSubsets = (GetGeomSubsetsPickMode() == GeomSubsetsPickModeTokens->Faces);
+    std::unordered_map<SdfPath, GeomSubsetsByElement, SdfPath::Hash> geomSubsetsByRprim;
+#endif
+    std::unordered_map<SdfPath, MayaHydraSceneIndexRegistrationPtr, SdfPath::Hash> registrationByRprim;
+    std::unordered_map<SdfPath, HitPath, SdfPath::Hash> nonInstanceHitPaths;
+    std::unordered_map<const MayaHydraSceneIndexRegistration*, KindResolver> kindResolvers;
+    std::unordered_set<Ufe::Path> selectedUfePaths;
 
+    size_t nbSelectedUfeItems = 0;
     std::vector<HitPath> hitPaths;
+    for (const HdxPickHit* pickHit : pickInput.pickHits) {
+        auto foundRegistration = registrationByRprim.find(pickHit->objectId);
+        if (foundRegistration == registrationByRprim.end()) {
+            foundRegistration = registrationByRprim.emplace(pickHit->objectId,
+                sceneIndexRegistry()->GetSceneIndexRegistrationForRprim(pickHit->objectId)).first;
+        }
+        const auto& registration = foundRegistration->second;
 
-#if PXR_VERSION >= 2403
-    if (GetGeomSubsetsPickMode() == GeomSubsetsPickModeTokens->Faces) {
-        auto geomSubsetsHitPaths = resolveGeomSubsetsPicking(
-            renderIndex()->GetTerminalSceneIndex(), 
-            pickInput.pickHit.objectId, 
-            HdGeomSubsetSchemaTokens->typeFaceSet, 
-            pickInput.pickHit.elementIndex);
-        if (!geomSubsetsHitPaths.empty()) {
-            hitPaths.insert(hitPaths.end(), geomSubsetsHitPaths.begin(), geomSubsetsHitPaths.end());
+        if (!registration) {
+            continue;
         }
 
-        // If we did not find any geomSubset and this is the only pick hit, then fallback to selecting the base prim/instance.
-        if (hitPaths.empty() && pickInput.isSolePickHit) {
-            hitPaths.push_back(resolveInstancePicking(*renderIndex(), pickInput.pickHit));
+        const auto resolveHitPath = [&]() -> HitPath {
+            // Without an instancer, the hit path only depends on the rprim.
+            if (!pickHit->instancerId.IsEmpty()) {
+                return resolveInstancePicking(*renderIndex(), *pickHit, pointInstancesPickMode);
+            }
+            auto found = nonInstanceHitPaths.find(pickHit->objectId);
+            if (found == nonInstanceHitPaths.end()) {
+                found = nonInstanceHitPaths.emplace(pickHit->objectId,
+                    resolveInstancePicking(*renderIndex(), *pickHit, pointInstancesPickMode)).first;
+            }
+            return found->second;
+        };
+
+        hitPaths.clear();
+
+#if PXR_VERSION >= 2403
+        if (pickGeomSubsets) {
+            if (pickHit->elementIndex >= 0) {
+                auto foundGeomSubsets = geomSubsetsByRprim.find(pickHit->objectId);
+                if (foundGeomSubsets == geomSubsetsByRprim.end()) {
+                    foundGeomSubsets = geomSubsetsByRprim.emplace(pickHit->objectId, collectGeomSubsets(
+                        renderIndex()->GetTerminalSceneIndex(), 
+                        pickHit->objectId, 
+                        HdGeomSubsetSchemaTokens->typeFaceSet)).first;
+                }
+                auto foundElement = foundGeomSubsets->second.find(pickHit->elementIndex);
+                if (foundElement != foundGeomSubsets->second.end()) {
+                    for (const auto& usdPath : foundElement->second) {
+                        hitPaths.push_back({usdPath, -1});
+                    }
+                }
+            }
+
+            // If we did not find any geomSubset and this is the only pick hit, then fallback to selecting the base prim/instance.
+            if (hitPaths.empty() && pickInput.isSolePickHit) {
+                hitPaths.push_back(resolveHitPath());
+            }
+        } else {
+            hitPaths.push_back(resolveHitPath());
         }
-    } else {
-        hitPaths.push_back(resolveInstancePicking(*renderIndex(), pickInput.pickHit));
-    }
 #else
-    hitPaths.push_back(resolveInstancePicking(*renderIndex(), pickInput.pickHit));
+        hitPaths.push_back(resolveHitPath());
 #endif
 
-    size_t nbSelectedUfeItems = 0;
-    for (const auto& [pickedUsdPath, instanceNdx] : hitPaths) {
-        // For the USD pick handler pick results are directly returned with USD
-        // scene paths, so no need to remove scene index plugin path prefix.
-        const auto pickedMayaPath = usdPathToUfePath(registration, pickedUsdPath);
-        const auto snMayaPath =
-            // As per https://stackoverflow.com/questions/46114214
-            // structured bindings cannot be captured by a lambda in C++ 17,
-            // so pass in pickedUsdPath and instanceNdx as lambda arguments.
-            [&pickedMayaPath, &registration](
-                const SdfPath& pickedUsdPath, int instanceNdx) {
-
+        for (const auto& [pickedUsdPath, instanceNdx] : hitPaths) {
+            // For the USD pick handler pick results are directly returned with USD
+            // scene paths, so no need to remove scene index plugin path prefix.
+            Ufe::Path snMayaPath;
             if (instanceNdx >= 0) {
                 // Point instance: add the instance index to the path.
                 // Appending a numeric component to the path to identify a
                 // point instance cannot be done on the picked SdfPath, as
                 // numeric path components are not allowed by SdfPath.  Do so
                 // here with Ufe::Path, which has no such restriction.
-                return pickedMayaPath + std::to_string(instanceNdx);
+                snMayaPath = usdPathToUfePath(registration, pickedUsdPath) + std::to_string(instanceNdx);
+            } else if (snKind.IsEmpty()) {
+                snMayaPath = usdPathToUfePath(registration, pickedUsdPath);
+            } else {
+                // Not an instance: adjust picked path for selection kind.
+                auto kindResolver = kindResolvers.find(registration.get());
+                if (kindResolver == kindResolvers.end()) {
+                    kindResolver = kindResolvers.emplace(
+                        registration.get(), KindResolver(registration, snKind)).first;
+                }
+                snMayaPath = usdPathToUfePath(registration, kindResolver->second.resolve(pickedUsdPath));
             }
 
-            // Not an instance: adjust picked path for selection kind.
-            auto snKind = GetSelectionKind();
-            if (snKind.IsEmpty()) {
-                return pickedMayaPath;
+            // Many hits resolve to the same item, only create it once.
+            if (!selectedUfePaths.insert(snMayaPath).second) {
+                continue;
             }
 
-            // Get the prim from the stage and path, to access the
-            // UsdModelAPI for the prim.
-            auto proxyShapeObj = registration->dagNode.object();
-            if (proxyShapeObj.isNull()) {
-                TF_FATAL_ERROR("No mayaUsd proxy shape object corresponds to USD pick");
-                return pickedMayaPath;
+            auto si = Ufe::Hierarchy::createItem(snMayaPath);
+            if (!si) {
+                continue;
             }
 
-            MayaUsdAPI::ProxyStage proxyStage{proxyShapeObj};
-            auto prim = proxyStage.getUsdStage()->GetPrimAtPath(pickedUsdPath);
-            prim = GetPrimOrAncestorWithKind(prim, snKind);
-            const auto usdPath = prim ? prim.GetPath() : pickedUsdPath;
-
-            return usdPathToUfePath(registration, usdPath);
-        }(pickedUsdPath, instanceNdx);
-
-        auto si = Ufe::Hierarchy::createItem(snMayaPath);
-        if (!si) {
-            continue;
+            pickOutput.ufeSelection->append(si);
+            nbSelectedUfeItems++;
         }
-
-        pickOutput.ufeSelection->append(si);
-        nbSelectedUfeItems++;
     }
     return nbSelectedUfeItems > 0;
 }
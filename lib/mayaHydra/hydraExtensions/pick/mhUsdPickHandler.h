@@ -51,6 +51,13 @@ public:
         const Input& pickInput, Output& pickOutput
     ) const override;
 
+    // Resolve the hits of a pick together, sharing the scene index
+    // registration, geomSubsets, selection kind and UFE item lookups between
+    // hits on the same prims.
+    bool handlePickHits(
+        const BatchInput& pickInput, Output& pickOutput
+    ) const override;
+
 private:
 
     PXR_NS::HdRenderIndex* renderIndex() const;
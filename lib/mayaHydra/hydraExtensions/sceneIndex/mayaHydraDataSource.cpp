@@ -22,8 +22,11 @@
 #include <mayaHydraLib/sceneIndex/mayaHydraLightDataSource.h>
 #include <mayaHydraLib/sceneIndex/mayaHydraSceneIndex.h>
 #include <mayaHydraLib/sceneIndex/mayaHydraSceneIndexUtils.h>
+#include <mayaHydraLib/sceneIndex/mayaHydraXformDataSource.h>
 #include <mayaHydraLib/adapters/adapter.h>
 
+#include <flowViewport/fvpInstruments.h>
+
 #include <pxr/imaging/hd/retainedDataSource.h>
 #include <pxr/imaging/hd/basisCurvesSchema.h>
 #include <pxr/imaging/hd/basisCurvesTopologySchema.h>
@@ -106,66 +109,24 @@ MayaHydraDataSource::Get(const TfToken& name)
 {
     if (name == HdMeshSchemaTokens->mesh) {
         if (_type == HdPrimTypeTokens->mesh) {
-            auto topology = _adapter->GetMeshTopology();
-            return HdMeshSchema::Builder()
-                .SetTopology(
-                    HdMeshTopologySchema::Builder()
-                    .SetFaceVertexCounts(
-                        HdRetainedTypedSampledDataSource<VtIntArray>::New(
-                            topology.GetFaceVertexCounts()))
-                    .SetFaceVertexIndices(
-                        HdRetainedTypedSampledDataSource<VtIntArray>::New(
-                            topology.GetFaceVertexIndices()))
-                    .SetOrientation(
-                        HdRetainedTypedSampledDataSource<TfToken>::New(
-                            HdMeshTopologySchemaTokens->rightHanded))
-                    .Build())
-                .SetSubdivisionScheme(
-                    HdRetainedTypedSampledDataSource<TfToken>::New(topology.GetScheme()))
-                .SetDoubleSided(
-                    HdRetainedTypedSampledDataSource<bool>::New(_adapter->GetDoubleSided()))
-                .Build();
+            return _GetCachedDataSource(name, &MayaHydraDataSource::_GetMeshDataSource);
         }
     }
     else if (name == HdBasisCurvesSchemaTokens->basisCurves) {
         if (_type == HdPrimTypeTokens->basisCurves) {
-            auto topology = _adapter->GetBasisCurvesTopology();
-            return HdBasisCurvesSchema::Builder()
-                .SetTopology(
-                    HdBasisCurvesTopologySchema::Builder()
-                    .SetCurveVertexCounts(
-                        HdRetainedTypedSampledDataSource<VtIntArray>::New(
-                            topology.GetCurveVertexCounts()))
-                    .SetCurveIndices(
-                        HdRetainedTypedSampledDataSource<VtIntArray>::New(
-                            topology.GetCurveIndices()))
-                    .SetBasis(
-                        HdRetainedTypedSampledDataSource<TfToken>::New(
-                            topology.GetCurveBasis()))
-                    .SetType(
-                        HdRetainedTypedSampledDataSource<TfToken>::New(
-                            topology.GetCurveType()))
-                    .SetWrap(
-                        HdRetainedTypedSampledDataSource<TfToken>::New(
-                            topology.GetCurveWrap()))
-                    .Build())
-                .Build();
+            return _GetCachedDataSource(name, &MayaHydraDataSource::_GetBasisCurvesDataSource);
         }
     }
     else if (name == HdPrimvarsSchemaTokens->primvars) {
-        return _GetPrimvarsDataSource();
+        return _GetCachedDataSource(name, &MayaHydraDataSource::_GetPrimvarsDataSource);
     }
     else if (name ==
              HdMaterialBindingsSchema::GetSchemaToken()
              ) {
-       return _GetMaterialBindingDataSource();
+       return _GetCachedDataSource(name, &MayaHydraDataSource::_GetMaterialBindingDataSource);
     }
     else if (name == HdXformSchemaTokens->xform) {
-        auto xform = _adapter->GetTransform();
-        return HdXformSchema::Builder()
-            .SetMatrix(
-                HdRetainedTypedSampledDataSource<GfMatrix4d>::New(xform))
-            .Build();
+        return _GetCachedDataSource(name, &MayaHydraDataSource::_GetXformDataSource);
     }
     else if (name == HdMaterialSchemaTokens->material) {
        return _GetMaterialDataSource();
@@ -183,11 +144,7 @@ MayaHydraDataSource::Get(const TfToken& name)
         return MayaHydraLightDataSource::New(_id, _type, _adapter);
     }
     else if (name == HdExtentSchemaTokens->extent) {//Extent attribute to support the bounding box display style
-        GfBBox3d bbox = _adapter->GetBoundingBox();
-        return HdExtentSchema::Builder()
-            .SetMin(HdRetainedTypedSampledDataSource<GfVec3d>::New(bbox.GetRange().GetMin()))
-            .SetMax(HdRetainedTypedSampledDataSource<GfVec3d>::New(bbox.GetRange().GetMax()))
-            .Build();
+        return _GetCachedDataSource(name, &MayaHydraDataSource::_GetExtentDataSource);
     }
     else if (name == HdTokens->displayColor) {//Is not part of a schema so using HdTokens->displayColor
         return _GetDisplayColorDataSource();
@@ -196,6 +153,134 @@ MayaHydraDataSource::Get(const TfToken& name)
     return nullptr;
 }
 
+void MayaHydraDataSource::Invalidate(const HdDataSourceLocatorSet& locators)
+{
+    std::lock_guard<std::mutex> lock(_cachedDataSourcesMutex);
+    // Data sources being built while invalidating must not be cached, see _GetCachedDataSource.
+    ++_cacheGeneration;
+    for (auto it = _cachedDataSources.begin(); it != _cachedDataSources.end();) {
+        const HdDataSourceLocator locator(it->first);
+        if (!locators.Intersects(locator)) {
+            ++it;
+            continue;
+        }
+
+        // When only some primvars are dirtied (e.g. points), keep the others.
+        if (it->first == HdPrimvarsSchemaTokens->primvars && !locators.Contains(locator)) {
+            if (auto primvarsDs
+                = std::dynamic_pointer_cast<MayaHydraPrimvarsDataSource>(it->second)) {
+                for (const auto& dirtiedLocator : locators) {
+                    if (dirtiedLocator.HasPrefix(locator) && dirtiedLocator.GetElementCount() > 1) {
+                        primvarsDs->Invalidate(dirtiedLocator.GetElement(1));
+                    }
+                }
+                ++it;
+                continue;
+            }
+        }
+
+        it = _cachedDataSources.erase(it);
+    }
+}
+
+HdDataSourceBaseHandle MayaHydraDataSource::_GetCachedDataSource(
+    const TfToken& name,
+    HdDataSourceBaseHandle (MayaHydraDataSource::*buildDataSource)())
+{
+    static auto& nbCacheHitsCounter
+        = Fvp::Instruments::instance().counter("MayaHydraDataSource:NbCacheHits");
+    static auto& nbAdapterGetsCounter
+        = Fvp::Instruments::instance().counter("MayaHydraDataSource:NbAdapterGets");
+
+    size_t generation = 0;
+    {
+        std::lock_guard<std::mutex> lock(_cachedDataSourcesMutex);
+        const auto found = _cachedDataSources.find(name);
+        if (found != _cachedDataSources.end()) {
+            nbCacheHitsCounter.add();
+            return found->second;
+        }
+        generation = _cacheGeneration;
+    }
+
+    // Build outside of the lock, the adapter may be slow to answer. Concurrent queries of the
+    // same data source may both build it, the last one wins. If the data source was invalidated
+    // meanwhile, it may have been built from stale adapter data : it is returned to this caller,
+    // but not cached, so that the next query rebuilds it.
+    nbAdapterGetsCounter.add();
+    HdDataSourceBaseHandle dataSource = (this->*buildDataSource)();
+
+    std::lock_guard<std::mutex> lock(_cachedDataSourcesMutex);
+    if (generation == _cacheGeneration) {
+        _cachedDataSources[name] = dataSource;
+    }
+    return dataSource;
+}
+
+HdDataSourceBaseHandle MayaHydraDataSource::_GetMeshDataSource()
+{
+    auto topology = _adapter->GetMeshTopology();
+    return HdMeshSchema::Builder()
+        .SetTopology(
+            HdMeshTopologySchema::Builder()
+            .SetFaceVertexCounts(
+                HdRetainedTypedSampledDataSource<VtIntArray>::New(
+                    topology.GetFaceVertexCounts()))
+            .SetFaceVertexIndices(
+                HdRetainedTypedSampledDataSource<VtIntArray>::New(
+                    topology.GetFaceVertexIndices()))
+            .SetOrientation(
+                HdRetainedTypedSampledDataSource<TfToken>::New(
+                    HdMeshTopologySchemaTokens->rightHanded))
+            .Build())
+        .SetSubdivisionScheme(
+            HdRetainedTypedSampledDataSource<TfToken>::New(topology.GetScheme()))
+        .SetDoubleSided(
+            HdRetainedTypedSampledDataSource<bool>::New(_adapter->GetDoubleSided()))
+        .Build();
+}
+
+HdDataSourceBaseHandle MayaHydraDataSource::_GetBasisCurvesDataSource()
+{
+    auto topology = _adapter->GetBasisCurvesTopology();
+    return HdBasisCurvesSchema::Builder()
+        .SetTopology(
+            HdBasisCurvesTopologySchema::Builder()
+            .SetCurveVertexCounts(
+                HdRetainedTypedSampledDataSource<VtIntArray>::New(
+                    topology.GetCurveVertexCounts()))
+            .SetCurveIndices(
+                HdRetainedTypedSampledDataSource<VtIntArray>::New(
+                    topology.GetCurveIndices()))
+            .SetBasis(
+                HdRetainedTypedSampledDataSource<TfToken>::New(
+                    topology.GetCurveBasis()))
+            .SetType(
+                HdRetainedTypedSampledDataSource<TfToken>::New(
+                    topology.GetCurveType()))
+            .SetWrap(
+                HdRetainedTypedSampledDataSource<TfToken>::New(
+                    topology.GetCurveWrap()))
+            .Build())
+        .Build();
+}
+
+HdDataSourceBaseHandle MayaHydraDataSource::_GetXformDataSource()
+{
+    return HdXformSchema::Builder()
+        .SetMatrix(MayaHydraXformMatrixDataSource::New(_adapter))
+        .Build();
+}
+
+HdDataSourceBaseHandle MayaHydraDataSource::_GetExtentDataSource()
+{
+    GfBBox3d bbox = _adapter->GetBoundingBox();
+    return HdExtentSchema::Builder()
+        .SetMin(HdRetainedTypedSampledDataSource<GfVec3d>::New(bbox.GetRange().GetMin()))
+        .SetMax(HdRetainedTypedSampledDataSource<GfVec3d>::New(bbox.GetRange().GetMax()))
+        .Build();
+}
+
 HdDataSourceBaseHandle MayaHydraDataSource::_GetVisibilityDataSource()
 {
     bool vis = _adapter->GetVisible();
@@ -220,10 +305,6 @@ HdDataSourceBaseHandle MayaHydraDataSource::_GetDisplayColorDataSource()
 
 HdDataSourceBaseHandle MayaHydraDataSource::_GetPrimvarsDataSource()
 {
-    if (_primvarsBuilt.load()) {
-        return HdContainerDataSource::AtomicLoad(_primvars);
-    }
-
     MayaHydraPrimvarsDataSourceHandle primvarsDs;
 
     for (size_t interpolation = HdInterpolationConstant;
@@ -244,10 +325,6 @@ HdDataSourceBaseHandle MayaHydraDataSource::_GetPrimvarsDataSource()
         }
     }
 
-    HdContainerDataSourceHandle ds = primvarsDs;
-    HdContainerDataSource::AtomicStore(_primvars, ds);
-    _primvarsBuilt.store(true);
-
     return primvarsDs;
 }
 
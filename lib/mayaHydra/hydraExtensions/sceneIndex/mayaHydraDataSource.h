@@ -20,8 +20,12 @@
 #include <pxr/pxr.h>
 #include <pxr/usd/sdf/path.h>
 #include <pxr/imaging/hd/dataSource.h>
+#include <pxr/imaging/hd/dataSourceLocator.h>
 #include <pxr/imaging/hd/enums.h>
 
+#include <mutex>
+#include <unordered_map>
+
 PXR_NAMESPACE_OPEN_SCOPE
 
 class MayaHydraAdapter;
@@ -40,6 +44,10 @@ public:
     TfTokenVector GetNames() override;
     HdDataSourceBaseHandle Get(const TfToken& name) override;
 
+    /// Drop the cached data sources intersecting the dirtied locators, so that they are rebuilt
+    /// from the adapter on the next query.
+    void Invalidate(const HdDataSourceLocatorSet& locators);
+
 private:
     MayaHydraDataSource(
         const SdfPath& id,
@@ -53,14 +61,26 @@ private:
     HdDataSourceBaseHandle _GetMaterialBindingDataSource();
     HdDataSourceBaseHandle _GetMaterialDataSource();
     HdDataSourceBaseHandle _GetDisplayColorDataSource();
+    HdDataSourceBaseHandle _GetMeshDataSource();
+    HdDataSourceBaseHandle _GetBasisCurvesDataSource();
+    HdDataSourceBaseHandle _GetXformDataSource();
+    HdDataSourceBaseHandle _GetExtentDataSource();
+    HdDataSourceBaseHandle _GetCachedDataSource(
+        const TfToken& name,
+        HdDataSourceBaseHandle (MayaHydraDataSource::*buildDataSource)());
 private:
     SdfPath _id;
     TfToken _type;
     MayaHydraSceneIndex* _sceneIndex = nullptr;
     MayaHydraAdapter* _adapter = nullptr;
 
-    std::atomic_bool _primvarsBuilt{false};
-    HdContainerDataSourceAtomicHandle _primvars;
+    // Data sources built from the adapter, cached until their locator is dirtied.
+    using _CachedDataSources
+        = std::unordered_map<TfToken, HdDataSourceBaseHandle, TfToken::HashFunctor>;
+    std::mutex         _cachedDataSourcesMutex;
+    _CachedDataSources _cachedDataSources;
+    // Incremented on each invalidation.
+    size_t             _cacheGeneration = 0;
 };
 
 HD_DECLARE_DATASOURCE_HANDLES(MayaHydraDataSource);
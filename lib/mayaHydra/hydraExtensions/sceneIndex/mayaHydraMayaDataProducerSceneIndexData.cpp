@@ -20,6 +20,7 @@
 
 //Local headers
 #include "mayaHydraMayaDataProducerSceneIndexData.h"
+#include "mayaHydraLib/adapters/mayaAttrs.h"
 #include "mayaHydraLib/hydraUtils.h"
 #include "mayaHydraLib/mayaUtils.h"
 
@@ -27,7 +28,10 @@
 #include <flowViewport/selection/fvpDataProducersNodeHashCodeToSdfPathRegistry.h>
 
 //maya headers
+#include <maya/MAnimControl.h>
+#include <maya/MNodeMessage.h>
 #include <maya/MObjectHandle.h>
+#include <maya/MPlug.h>
 
 PXR_NAMESPACE_USING_DIRECTIVE
 
@@ -46,6 +50,20 @@ private:
     MayaDataProducerSceneIndexData& _dataProducer;
 };
 
+class MayaDataProducerSceneIndexData::UfeObjectChangesHandler : public Ufe::Observer
+{
+public:
+    UfeObjectChangesHandler(MayaDataProducerSceneIndexData& dataProducer)
+        : _dataProducer(dataProducer)
+    {
+    }
+
+    void operator()(const Ufe::Notification& notification) override;
+
+private:
+    MayaDataProducerSceneIndexData& _dataProducer;
+};
+
 MayaDataProducerSceneIndexData::MayaDataProducerSceneIndexData(const FVP_NS_DEF::DataProducerSceneIndexDataBase::CreationParameters& params) 
     : FVP_NS_DEF::DataProducerSceneIndexDataBase(params)
 {
@@ -73,6 +91,12 @@ MayaDataProducerSceneIndexData::~MayaDataProducerSceneIndexData()
         Ufe::Scene::instance().removeObserver(_ufeSceneChangesHandler);
         _ufeSceneChangesHandler.reset();
     }
+    if (_ufeObjectChangesHandler) {
+        _RemoveUfeTransformObservation();
+        Ufe::Object3d::removeObserver(_ufeObjectChangesHandler);
+        _ufeObjectChangesHandler.reset();
+    }
+    _RemoveAncestorsDirtyCallbacks();
     if (0 != _dccNodeHashCode){
         //Remove the node from the registry
         FVP_NS::DataProducersNodeHashCodeToSdfPathRegistry::Instance().Remove(_dccNodeHashCode);
@@ -110,18 +134,82 @@ void MayaDataProducerSceneIndexData::SetupUfeObservation(const MDagPath& dagPath
     _ufeSceneChangesHandler = std::make_shared<UfeSceneChangesHandler>(*this);
     Ufe::Scene::instance().addObserver(_ufeSceneChangesHandler);
 
-    // Note : while we currently use a query-based approach to update the transform and visibility,
-    // we could also move to a UFE notifications-based approach if necessary. In this case, we would
-    // setup the subject-observer relationships here.
-    // For visibility changes, the observer would observe the Ufe::Object3d subject, receive
-    // Ufe::VisibilityChanged notifications and call UpdateVisibility() if the received notification
-    // is relevant (i.e. if the data producer's path starts with the notification's path, the
-    // same way as in MayaDataProducerSceneIndexData::UfeSceneChangesHandler::operator()).
-    // For transform changes, the observer would observe a Ufe::Transform3dPathSubject created off
-    // the UFE path of the node (_path), receive Ufe::Transform3dChanged notifications and call
-    // UpdateTransform() if the received notification is relevant (i.e. if the data producer's path
-    // starts with the notification's path, the same way as in
-    // MayaDataProducerSceneIndexData::UfeSceneChangesHandler::operator()).
+    // Visibility and transform are updated from UFE notifications : the observer receives the
+    // Ufe::VisibilityChanged notifications of all objects, and the Ufe::Transform3dChanged
+    // notifications of the data producer scene item (which are also sent when an ancestor moves).
+    // It only dirties the visibility or transform, which are queried in UpdateVisibility() and
+    // UpdateTransform() when the viewport is next rendered.
+    _ufeObjectChangesHandler = std::make_shared<UfeObjectChangesHandler>(*this);
+    Ufe::Object3d::addObserver(_ufeObjectChangesHandler);
+    _AddUfeTransformObservation();
+
+    // Attributes driven by a connection or an expression change without any UFE notification,
+    // so the plugs of the node and of its ancestors are observed as well.
+    _AddAncestorsDirtyCallbacks(dagPath);
+}
+
+void MayaDataProducerSceneIndexData::_AddAncestorsDirtyCallbacks(MDagPath dagPath)
+{
+    MStatus status;
+    for (; dagPath.length() > 0; dagPath.pop()) {
+        MObject obj = dagPath.node();
+        if (obj.isNull()) {
+            continue;
+        }
+        auto id = MNodeMessage::addNodeDirtyPlugCallback(obj, _AncestorPlugDirty, this, &status);
+        if (status) {
+            _ancestorsDirtyCallbacks.append(id);
+        }
+    }
+}
+
+void MayaDataProducerSceneIndexData::_RemoveAncestorsDirtyCallbacks()
+{
+    if (_ancestorsDirtyCallbacks.length() > 0) {
+        MMessage::removeCallbacks(_ancestorsDirtyCallbacks);
+        _ancestorsDirtyCallbacks.clear();
+    }
+}
+
+void MayaDataProducerSceneIndexData::_AncestorPlugDirty(MObject& /*node*/, MPlug& plug, void* clientData)
+{
+    auto* dataProducer = reinterpret_cast<MayaDataProducerSceneIndexData*>(clientData);
+    if (plug == MayaAttrs::dagNode::visibility || plug == MayaAttrs::dagNode::overrideEnabled
+        || plug == MayaAttrs::dagNode::overrideVisibility) {
+        dataProducer->_visibilityDirty = true;
+    } else {
+        // Any other plug may feed the local matrix, the new value is only read when rendering.
+        dataProducer->_transformDirty = true;
+    }
+}
+
+void MayaDataProducerSceneIndexData::_AddUfeTransformObservation()
+{
+    if (!_path.has_value() || !_ufeObjectChangesHandler) {
+        return;
+    }
+    _transformObservedItem = Ufe::Hierarchy::createItem(_path.value());
+    if (_transformObservedItem) {
+        Ufe::Transform3d::addObserver(_transformObservedItem, _ufeObjectChangesHandler);
+    }
+}
+
+void MayaDataProducerSceneIndexData::_RemoveUfeTransformObservation()
+{
+    if (_transformObservedItem) {
+        Ufe::Transform3d::removeObserver(_transformObservedItem, _ufeObjectChangesHandler);
+        _transformObservedItem.reset();
+    }
+}
+
+void MayaDataProducerSceneIndexData::_DirtyOnTimeChange()
+{
+    const double time = MAnimControl::currentTime().value();
+    if (time != _lastTime) {
+        _lastTime = time;
+        _visibilityDirty = true;
+        _transformDirty = true;
+    }
 }
 
 bool MayaDataProducerSceneIndexData::UpdateVisibility()
@@ -133,6 +221,12 @@ bool MayaDataProducerSceneIndexData::UpdateVisibility()
     // so we should also have a UsdImagingRootOverridesSceneIndex
     TF_AXIOM(_rootOverridesSceneIndex);
 
+    _DirtyOnTimeChange();
+    if (!_visibilityDirty) {
+        return false;
+    }
+    _visibilityDirty = false;
+
     bool      isVisible = true;
     Ufe::Path currPath = _path.value();
     while (isVisible && !currPath.empty()) {
@@ -157,6 +251,12 @@ bool MayaDataProducerSceneIndexData::UpdateTransform()
     // so we should also have a UsdImagingRootOverridesSceneIndex
     TF_AXIOM(_rootOverridesSceneIndex);
 
+    _DirtyOnTimeChange();
+    if (!_transformDirty) {
+        return false;
+    }
+    _transformDirty = false;
+
     auto transform = Ufe::Transform3dRead::transform3dRead(Ufe::Hierarchy::createItem(_path.value()));
     if (!transform) {
         return false;
@@ -184,6 +284,22 @@ void MayaDataProducerSceneIndexData::UfeSceneChangesHandler::operator()(const Uf
     }
 }
 
+void MayaDataProducerSceneIndexData::UfeObjectChangesHandler::operator()(const Ufe::Notification& notification)
+{
+    // We're processing UFE notifications, which implies that a path must be in use.
+    TF_AXIOM(_dataProducer._path.has_value());
+
+    if (const auto visibilityChanged = dynamic_cast<const Ufe::VisibilityChanged*>(&notification)) {
+        // Sent for any object : only the visibility of our ancestors, or our own, is relevant.
+        if (_dataProducer._path.value().startsWith(visibilityChanged->path())) {
+            _dataProducer._visibilityDirty = true;
+        }
+    } else if (dynamic_cast<const Ufe::Transform3dChanged*>(&notification)) {
+        // Only sent for the observed scene item.
+        _dataProducer._transformDirty = true;
+    }
+}
+
 void MayaDataProducerSceneIndexData::UfeSceneChangesHandler::handleSceneChanged(const Ufe::SceneChanged& sceneChanged)
 {
     auto handleSingleOperation = [&](const Ufe::SceneCompositeNotification::Op& sceneOperation) -> void {
@@ -198,7 +314,13 @@ void MayaDataProducerSceneIndexData::UfeSceneChangesHandler::handleSceneChanged(
             return;
         }
 
+        // Any change to our parent hierarchy can affect the inherited visibility and transform.
+        _dataProducer._visibilityDirty = true;
+        _dataProducer._transformDirty = true;
+
         if (sceneOperation.opType == Ufe::SceneChanged::ObjectPathChange) {
+            // Transform observation is per scene item, so it is moved to the new path.
+            _dataProducer._RemoveUfeTransformObservation();
             switch (sceneOperation.subOpType) {
             case Ufe::ObjectPathChange::ObjectRename:
                 _dataProducer._path = _dataProducer._path.value().replaceComponent(
@@ -208,6 +330,16 @@ void MayaDataProducerSceneIndexData::UfeSceneChangesHandler::handleSceneChanged(
                 _dataProducer._path = _dataProducer._path.value().reparent(sceneOperation.path, sceneOperation.item->path());
                 break;
             }
+            _dataProducer._AddUfeTransformObservation();
+
+            // A reparent changes the ancestors whose plugs must be observed.
+            if (_dataProducer._dccNode) {
+                MDagPath dagPath;
+                MDagPath::getAPathTo(*reinterpret_cast<MObject*>(_dataProducer._dccNode), dagPath);
+                dagPath.extendToShape();
+                _dataProducer._RemoveAncestorsDirtyCallbacks();
+                _dataProducer._AddAncestorsDirtyCallbacks(dagPath);
+            }
         }
     };
     if (sceneChanged.opType() == Ufe::SceneChanged::SceneCompositeNotification) {
@@ -23,9 +23,15 @@
 #include "ufeExtensions/Global.h"
 #include <ufe/hierarchy.h>
 #include <ufe/object3d.h>
+#include <ufe/object3dNotification.h>
 #include <ufe/scene.h>
 #include <ufe/sceneNotification.h>
 #include <ufe/transform3d.h>
+#include <ufe/transform3dNotification.h>
+
+// Maya headers
+#include <maya/MCallbackIdArray.h>
+#include <maya/MDagPath.h>
 
 PXR_NAMESPACE_OPEN_SCOPE
 
@@ -52,6 +58,8 @@ public:
     ///Destructor
     ~MayaDataProducerSceneIndexData() override;
     
+    /// Visibility and transform are only queried from UFE when a notification or a plug dirty
+    /// callback has dirtied them.
     bool UpdateVisibility() override;
     bool UpdateTransform() override;
 
@@ -61,13 +69,36 @@ private:
     
     void SetupDCCNode();
     void SetupUfeObservation(const MDagPath& dagPath) ;
+    void _AddUfeTransformObservation();
+    void _RemoveUfeTransformObservation();
+    void _AddAncestorsDirtyCallbacks(MDagPath dagPath);
+    void _RemoveAncestorsDirtyCallbacks();
+    static void _AncestorPlugDirty(MObject& node, MPlug& plug, void* clientData);
+    void _DirtyOnTimeChange();
+
     // Path to the scene item, if it was added as one
     std::optional<Ufe::Path> _path;
 
     // To observe scene changes to the data producer scene item, if it exists
     Ufe::Observer::Ptr       _ufeSceneChangesHandler;
 
+    // To observe visibility and transform changes of the data producer scene item and its ancestors
+    Ufe::Observer::Ptr       _ufeObjectChangesHandler;
+    // Scene item on which _ufeObjectChangesHandler observes transform changes
+    Ufe::SceneItem::Ptr      _transformObservedItem;
+
+    // Plug dirty callbacks on the data producer node and its DAG ancestors : visibility and
+    // transform changes driven by connections or expressions send no UFE notification.
+    MCallbackIdArray         _ancestorsDirtyCallbacks;
+
+    // Set by the UFE notifications and plug dirty callbacks, reset once the visibility or transform has been updated
+    bool                     _visibilityDirty = true;
+    bool                     _transformDirty = true;
+    // Animation does not necessarily send UFE notifications, so a time change dirties both
+    double                   _lastTime = 0.0;
+
     class UfeSceneChangesHandler;
+    class UfeObjectChangesHandler;
 };
 
 PXR_NAMESPACE_CLOSE_SCOPE
@@ -0,0 +1,119 @@
+//
+// Copyright 2024 Autodesk, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#ifndef MAYAHYDRAMOTIONSAMPLES_H
+#define MAYAHYDRAMOTIONSAMPLES_H
+
+#include <pxr/pxr.h>
+
+#include <functional>
+#include <mutex>
+#include <vector>
+
+PXR_NAMESPACE_OPEN_SCOPE
+
+/**
+ * \brief Motion samples of a value over the shutter interval of a Maya frame.
+ *
+ * All the shutter times are evaluated in a single batch, the first time the samples are needed.
+ * The queries of all the sample times are then answered from this cache. The frame is given at
+ * creation, as it is read from the main thread, and the data source owning the samples is replaced
+ * when its value is dirtied (e.g. by a time change).
+ */
+template <typename T>
+class MayaHydraMotionSamples
+{
+public:
+    /// Fills times and samples, and returns the number of samples.
+    using Sampler = std::function<size_t(size_t maxSampleCount, float* times, T* samples)>;
+
+    /// Shutter open, center and close.
+    static constexpr size_t kMaxSamples = 3;
+
+    MayaHydraMotionSamples(Sampler sampler, double frame)
+        : _sampler(std::move(sampler))
+        , _frame(frame)
+    {
+    }
+
+    /// The Maya frame the samples are taken around.
+    double GetFrame() const { return _frame; }
+
+    /// Returns the sample at or before the shutter offset, samples are held until the next one.
+    T GetValue(float shutterOffset)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _Update();
+        if (_samples.empty()) {
+            return T();
+        }
+        size_t i = 0;
+        while (i + 1 < _times.size() && _times[i + 1] <= shutterOffset) {
+            ++i;
+        }
+        return _samples[i];
+    }
+
+    /// Returns false if the value does not change over the shutter interval.
+    bool GetContributingSampleTimesForInterval(
+        float               startTime,
+        float               endTime,
+        std::vector<float>* outSampleTimes)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _Update();
+        if (_times.size() < 2) {
+            return false;
+        }
+        if (outSampleTimes) {
+            outSampleTimes->clear();
+            // Keep the samples bracketing the interval, they contribute to its boundaries.
+            for (size_t i = 0; i < _times.size(); ++i) {
+                const bool beforeStart = i + 1 < _times.size() && _times[i + 1] <= startTime;
+                const bool afterEnd = i > 0 && _times[i - 1] >= endTime;
+                if (!beforeStart && !afterEnd) {
+                    outSampleTimes->push_back(_times[i]);
+                }
+            }
+        }
+        return true;
+    }
+
+private:
+    void _Update()
+    {
+        if (_sampled) {
+            return;
+        }
+        _times.resize(kMaxSamples);
+        _samples.resize(kMaxSamples);
+        const size_t nbSamples = _sampler(kMaxSamples, _times.data(), _samples.data());
+        _times.resize(nbSamples);
+        _samples.resize(nbSamples);
+        _sampled = true;
+    }
+
+    Sampler            _sampler;
+    const double       _frame;
+    std::mutex         _mutex;
+    bool               _sampled = false;
+    std::vector<float> _times;
+    std::vector<T>     _samples;
+};
+
+PXR_NAMESPACE_CLOSE_SCOPE
+
+#endif // MAYAHYDRAMOTIONSAMPLES_H
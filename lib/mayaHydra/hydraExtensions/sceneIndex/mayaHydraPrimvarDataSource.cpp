@@ -17,6 +17,9 @@
 #include "mayaHydraPrimvarDataSource.h"
 
 #include <mayaHydraLib/adapters/adapter.h>
+#include <mayaHydraLib/sceneIndex/mayaHydraSceneIndex.h>
+
+#include <flowViewport/fvpInstruments.h>
 
 #include <pxr/imaging/hd/retainedDataSource.h>
 #include <pxr/imaging/hd/primvarSchema.h>
@@ -55,9 +58,15 @@ HdDataSourceBaseHandle MayaHydraPrimvarsDataSource::Get(const TfToken& name)
         return nullptr;
     }
 
+    std::lock_guard<std::mutex> lock(_primvarsMutex);
+    auto found = _primvars.find(name);
+    if (found != _primvars.end()) {
+        return found->second;
+    }
+
     // Need to handle indexed case?
     assert(!(*it).second.indexed);
-    return HdPrimvarSchema::Builder()
+    HdDataSourceBaseHandle primvar = HdPrimvarSchema::Builder()
         .SetPrimvarValue(MayaHydraPrimvarValueDataSource::New(
             name, _adapter))
         .SetInterpolation(HdPrimvarSchema::BuildInterpolationDataSource(
@@ -65,6 +74,14 @@ HdDataSourceBaseHandle MayaHydraPrimvarsDataSource::Get(const TfToken& name)
         .SetRole(HdPrimvarSchema::BuildRoleDataSource(
             (*it).second.role))
         .Build();
+    _primvars[name] = primvar;
+    return primvar;
+}
+
+void MayaHydraPrimvarsDataSource::Invalidate(const TfToken& name)
+{
+    std::lock_guard<std::mutex> lock(_primvarsMutex);
+    _primvars.erase(name);
 }
 
 MayaHydraPrimvarValueDataSource::MayaHydraPrimvarValueDataSource(
@@ -72,19 +89,25 @@ MayaHydraPrimvarValueDataSource::MayaHydraPrimvarValueDataSource(
     MayaHydraAdapter* adapter)
     : _primvarName(primvarName)
     , _adapter(adapter)
+    , _samples([primvarName, adapter](size_t maxSampleCount, float* times, VtValue* samples) {
+        static auto& nbAdapterGetsCounter
+            = Fvp::Instruments::instance().counter("MayaHydraDataSource:NbAdapterGets");
+        nbAdapterGetsCounter.add();
+        return adapter->SamplePrimvar(primvarName, maxSampleCount, times, samples);
+    }, adapter->GetMayaHydraSceneIndex()->GetCurrentFrame())
 {
 }
 
 VtValue MayaHydraPrimvarValueDataSource::GetValue(Time shutterOffset)
 {
-    return _adapter->Get(_primvarName);
+    return _samples.GetValue(shutterOffset);
 }
 
 bool MayaHydraPrimvarValueDataSource::GetContributingSampleTimesForInterval(
     Time startTime, Time endTime,
     std::vector<Time>* outSampleTimes)
 {
-    return false;
+    return _samples.GetContributingSampleTimesForInterval(startTime, endTime, outSampleTimes);
 }
 
 PXR_NAMESPACE_CLOSE_SCOPE
@@ -17,12 +17,15 @@
 #ifndef MAYAHYDRAPRIMVARVALUEDATASOURCE_H
 #define MAYAHYDRAPRIMVARVALUEDATASOURCE_H
 
+#include <mayaHydraLib/sceneIndex/mayaHydraMotionSamples.h>
+
 #include <pxr/pxr.h>
 #include <pxr/base/tf/denseHashMap.h>
 #include <pxr/usd/sdf/path.h>
 #include <pxr/imaging/hd/dataSource.h>
 #include <pxr/imaging/hd/enums.h>
 
+#include <mutex>
 
 PXR_NAMESPACE_OPEN_SCOPE
 
@@ -47,6 +50,10 @@ public:
     TfTokenVector GetNames() override;
     HdDataSourceBaseHandle Get(const TfToken& name) override;
 
+    /// Drop the cached data source of a dirtied primvar, so that its value is queried again from
+    /// the adapter.
+    void Invalidate(const TfToken& name);
+
 private:
     struct _Entry
     {
@@ -60,6 +67,12 @@ private:
 
     _EntryMap _entries;
     MayaHydraAdapter* _adapter;
+
+    using _PrimvarMap = TfDenseHashMap<TfToken, HdDataSourceBaseHandle,
+        TfToken::HashFunctor, std::equal_to<TfToken>, 32>;
+
+    std::mutex _primvarsMutex;
+    _PrimvarMap _primvars;
 };
 
 HD_DECLARE_DATASOURCE_HANDLES(MayaHydraPrimvarsDataSource);
@@ -85,6 +98,10 @@ public:
 private:
     TfToken _primvarName;
     MayaHydraAdapter* _adapter;
+
+    // The samples are queried from the adapter once, around the frame at creation : the data
+    // source is replaced when dirtied.
+    MayaHydraMotionSamples<VtValue> _samples;
 };
 
 PXR_NAMESPACE_CLOSE_SCOPE
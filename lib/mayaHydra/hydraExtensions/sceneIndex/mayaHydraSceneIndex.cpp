@@ -17,16 +17,20 @@
 #include "mayaHydraSceneIndex.h"
 
 #include <flowViewport/colorPreferences/fvpColorPreferencesTokens.h>
+#include <flowViewport/fvpInstruments.h>
 #include <flowViewport/selection/fvpPathMapper.h>
 #include <flowViewport/selection/fvpPathMapperRegistry.h>
 
 #include <maya/MDGMessage.h>
+#include <maya/MDagMessage.h>
 #include <maya/MDagPath.h>
 #include <maya/MDagPathArray.h>
 #include <maya/MFnComponent.h>
+#include <maya/MFnDagNode.h>
 #include <maya/MFnMesh.h>
 #include <maya/MItDag.h>
 #include <maya/MMatrixArray.h>
+#include <maya/MNodeMessage.h>
 #include <maya/MObjectHandle.h>
 #include <maya/MPlug.h>
 #include <maya/MPlugArray.h>
@@ -65,6 +69,16 @@
 #include <pxr/imaging/hd/rprim.h>
 #include <pxr/usdImaging/usdImaging/tokens.h>
 
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/parallel_sort.h>
+
+#include <algorithm>
+#include <atomic>
+#include <map>
+#include <set>
+#include <tuple>
+
 namespace
 {
 // Pick handler for the Maya scene index.  As the Maya pick handler and the
@@ -100,10 +114,23 @@ public:
     bool inSingleNodeComponentsPick(const HdxPickHit& hit) const override {
         // Is the picked node in components selection mode?  If so it is in the
         // hilite list.
-        MSelectionList hiliteList;
-        MGlobal::getHiliteList(hiliteList);
-        return !hiliteList.isEmpty() && 
-            _mayaSceneIndex.IsPickedNodeInComponentsPickingMode(hit);
+        _mayaSceneIndex.UpdateHilitedMeshes();
+        return _mayaSceneIndex.IsPickedNodeInComponentsPickingMode(hit);
+    }
+
+    const HdxPickHit* findSingleNodeComponentsPickHit(
+        const BatchInput& pickInput
+    ) const override
+    {
+        // Maya does not notify hilite list changes, so the hilited meshes are
+        // fetched once per run of hits, after which testing each hit is a lookup.
+        _mayaSceneIndex.UpdateHilitedMeshes();
+        for (const HdxPickHit* pickHit : pickInput.pickHits) {
+            if (_mayaSceneIndex.IsPickedNodeInComponentsPickingMode(*pickHit)) {
+                return pickHit;
+            }
+        }
+        return nullptr;
     }
 };
 
@@ -154,6 +181,12 @@ TF_DEFINE_ENV_SETTING(MAYA_HYDRA_USE_MESH_ADAPTER, false,
 TF_DEFINE_ENV_SETTING(MAYA_HYDRA_PASS_NORMALS_TO_HYDRA, true,
     "Pass the normals to Hydra (works for both render item and mesh adapters).");
 
+TF_DEFINE_ENV_SETTING(MAYA_HYDRA_PARALLEL_RENDER_ITEM_UPDATE, true,
+    "Translate the render items vertex and index buffers to Hydra in parallel.");
+
+TF_DEFINE_ENV_SETTING(MAYA_HYDRA_SHARE_INSTANCED_GEOMETRY, true,
+    "Share the vertex and index buffers of the render items of the instances of a Maya shape.");
+
 TF_DEFINE_PRIVATE_TOKENS(
     _tokens,
 
@@ -175,6 +208,27 @@ namespace {
         return uma;
     }
 
+    std::atomic_bool& parallelRenderItemUpdateFlag()
+    {
+        static std::atomic_bool flag { TfGetEnvSetting(MAYA_HYDRA_PARALLEL_RENDER_ITEM_UPDATE) };
+        return flag;
+    }
+
+    std::atomic_bool& shareInstancedGeometryFlag()
+    {
+        static std::atomic_bool flag { TfGetEnvSetting(MAYA_HYDRA_SHARE_INSTANCED_GEOMETRY) };
+        return flag;
+    }
+
+    const std::string kNbRenderItemDeltas = "MayaHydraSceneIndex:NbRenderItemDeltas";
+    const std::string kRenderItemDeltasTime = "MayaHydraSceneIndex:RenderItemDeltasTime";
+    const std::string kNbDirtyNotifications = "MayaHydraSceneIndex:NbDirtyNotifications";
+    const std::string kNbPopulatedPrims = "MayaHydraSceneIndex:NbPopulatedPrims";
+    const std::string kNbAddedPrimsNotifications = "MayaHydraSceneIndex:NbAddedPrimsNotifications";
+    const std::string kPopulateTime = "MayaHydraSceneIndex:PopulateTime";
+    const std::string kNbRenderItemBytesCopied = "MayaHydraSceneIndex:NbRenderItemBytesCopied";
+    const std::string kNbSharedRenderItemGeometries = "MayaHydraSceneIndex:NbSharedRenderItemGeometries";
+
     bool filterMesh(const MRenderItem& ri) {
         return useMeshAdapter() ?
             // Filter our mesh render items, and let the mesh adapter handle Maya
@@ -384,6 +438,16 @@ namespace {
         reinterpret_cast<MayaHydraSceneIndex*>(clientData)->OnDagNodeRemoved(obj);
     }
 
+    void _onNameChanged(MObject& node, const MString& prevName, void* clientData)
+    {
+        reinterpret_cast<MayaHydraSceneIndex*>(clientData)->OnNodeRenamed(node, prevName);
+    }
+
+    void _onDagChanged(MDagMessage::DagMessage msgType, MDagPath& child, MDagPath& parent, void* clientData)
+    {
+        reinterpret_cast<MayaHydraSceneIndex*>(clientData)->OnDagChanged(child, parent);
+    }
+
     const MString defaultLightSet("defaultLightSet");
 
     void _connectionChanged(MPlug& srcPlug, MPlug& destPlug, bool made, void* clientData)
@@ -570,6 +634,9 @@ MayaHydraSceneIndex::~MayaHydraSceneIndex()
 
 void MayaHydraSceneIndex::HandleCompleteViewportScene(const MDataServerOperation::MViewportScene& scene, MFrameContext::DisplayStyle ds)
 {
+    // Send all the prims dirtied by the render items changes downstream in a single notification.
+    _DirtyPrimsBatch dirtyPrimsBatch(*this);
+
     const bool playbackRunning = MAnimControl::isPlaying();
 
     if (_isPlaybackRunning != playbackRunning) {
@@ -596,9 +663,60 @@ void MayaHydraSceneIndex::HandleCompleteViewportScene(const MDataServerOperation
         assert(ria != nullptr);
     }
 
-    // My version, does minimal update
-    // This loop could, in theory, be parallelized.  Unclear how large the gains would be, but maybe
-    // nothing to lose unless there is some internal contention in USD.
+    // Minimal update, done in three phases :
+    // 1) Serial : look up or create the render item adapters, resolve their material and make
+    //    every Maya API call, as the Maya API is not thread safe : wireframe color, matrix
+    //    evaluated under a DG context, render item queries and mapping of the vertex and index
+    //    buffers.
+    // 2) Parallel : convert and copy the mapped buffers of each render item into its adapter,
+    //    without calling the Maya API. Each adapter only touches its own data, so this is done
+    //    concurrently.
+    //    Render items of instanced shapes have the same geometry for every instance : only the
+    //    first one of each group reads the Maya buffers, the others share its (copy on write)
+    //    arrays and topology in a second pass. This saves the copies and conversions on the CPU
+    //    only : Storm already shares the GPU buffers of identical static primvars and topologies
+    //    by hashing their content, whether or not the arrays are shared (see the
+    //    InstancedGeometry.gpuMemory test). Each instance keeps its own rprim, for picking,
+    //    selection highlighting, visibility and per-instance materials.
+    // 3) Serial : unmap the Maya buffers and notify the scene index of the dirtied prims.
+    FVP_INSTRUMENTS_SCOPED_TIMER(kRenderItemDeltasTime);
+
+    struct RenderItemDelta
+    {
+        MayaHydraRenderItemAdapterPtr ria;
+        MRenderItem*                  ri = nullptr;
+        unsigned int                  flags = 0;
+        MColor                        wireframeColor;
+        const MayaHydraRenderItemAdapter* geometrySource = nullptr;
+        MayaHydraRenderItemAdapter::DeltaBuffers buffers;
+        HdDirtyBits                   dirtyBits = 0;
+        size_t                        nbBytesCopied = 0;
+
+        MayaHydraRenderItemAdapter::UpdateFromDeltaData Data()
+        {
+            MayaHydraRenderItemAdapter::UpdateFromDeltaData data(*ri, flags, wireframeColor);
+            data._nbBytesCopied = &nbBytesCopied;
+            data._geometrySource = geometrySource;
+            return data;
+        }
+    };
+    std::vector<RenderItemDelta> deltas;
+    deltas.reserve(scene.mCount);
+
+    // Render items with identical geometry : same shape node, render item name, primitive and
+    // material. The value is the index in deltas of the render item which reads the Maya buffers.
+    using SharedGeometryKey = std::tuple<unsigned int, std::string, int, SdfPath>;
+    std::map<SharedGeometryKey, size_t> sharedGeometrySources;
+    std::vector<size_t> sharedGeometryDeltas;
+    constexpr unsigned int kGeometryFlags = MDataServerOperation::MViewportScene::MVS_changedGeometry
+        | MDataServerOperation::MViewportScene::MVS_changedTopo;
+    const bool shareGeometry = shareInstancedGeometry();
+
+    // Add the prims of the new render items and their materials in a single notification, e.g.
+    // all the render items of the scene on the first frame. It ends before the dirtied prims
+    // batch, so that the prims are added before being dirtied.
+    _AddedPrimsBatch addedPrimsBatch(*this);
+
     for (size_t i = 0; i < scene.mCount; i++) {
         auto flags = scene.mFlags[i];
         if (flags == 0) {
@@ -643,6 +761,7 @@ void MayaHydraSceneIndex::HandleCompleteViewportScene(const MDataServerOperation
 
         if (flags & MDataServerOperation::MViewportScene::MVS_changedEffect) {
             ria->SetMaterial(material);
+            _BindMaterial(ria->GetID(), material);
         }
 
         MColor                   wireframeColor;
@@ -654,27 +773,116 @@ void MayaHydraSceneIndex::HandleCompleteViewportScene(const MDataServerOperation
             // point
         }
 
-        const MayaHydraRenderItemAdapter::UpdateFromDeltaData data(
-            ri, flags, wireframeColor);
-        ria->UpdateFromDelta(data);
         if (flags & MDataServerOperation::MViewportScene::MVS_changedMatrix) {
             ria->UpdateTransform(ri);
         }
+
+        deltas.push_back({ ria, &ri, flags, wireframeColor });
+
+        if (shareGeometry && dagPath.isValid() && dagPath.isInstanced() && (flags & kGeometryFlags)) {
+            const MObject    shapeNode = dagPath.node();
+            SharedGeometryKey key(
+                MObjectHandle(shapeNode).hashCode(),
+                ri.name().asChar(),
+                static_cast<int>(ri.primitive()),
+                material);
+            const auto found = sharedGeometrySources.find(key);
+            if (found == sharedGeometrySources.end()) {
+                sharedGeometrySources.emplace(std::move(key), deltas.size() - 1);
+            } else {
+                const RenderItemDelta& source = deltas[found->second];
+                // Guard against hash code collisions, and only share from a render item whose
+                // buffers are read in this update.
+                if (source.ri->sourceDagPath().node() == shapeNode
+                    && (source.flags & kGeometryFlags) == (flags & kGeometryFlags)) {
+                    deltas.back().geometrySource = source.ria.get();
+                    sharedGeometryDeltas.push_back(deltas.size() - 1);
+                }
+            }
+        }
+    }
+
+    for (auto& delta : deltas) {
+        delta.ria->MapDeltaBuffers(delta.Data(), delta.buffers);
+    }
+
+    auto translateDelta = [](RenderItemDelta& delta) {
+        delta.dirtyBits = delta.ria->TranslateFromDelta(delta.Data(), delta.buffers);
+    };
+
+    // Below this number of changed render items, the overhead of spawning tasks is not worth it.
+    constexpr size_t kMinParallelRenderItems = 32;
+    auto translateDeltas = [&deltas, &translateDelta](bool sharingGeometry) {
+        auto translateIfInPass = [&translateDelta, sharingGeometry](RenderItemDelta& delta) {
+            if ((delta.geometrySource != nullptr) == sharingGeometry) {
+                translateDelta(delta);
+            }
+        };
+        if (parallelRenderItemUpdate() && deltas.size() >= kMinParallelRenderItems) {
+            tbb::parallel_for(
+                tbb::blocked_range<size_t>(0, deltas.size()),
+                [&deltas, &translateIfInPass](const tbb::blocked_range<size_t>& r) {
+                    for (size_t i = r.begin(); i < r.end(); ++i) {
+                        translateIfInPass(deltas[i]);
+                    }
+                });
+        } else {
+            for (auto& delta : deltas) {
+                translateIfInPass(delta);
+            }
+        }
+    };
+    // Geometry sources must be up to date before the render items sharing their geometry.
+    translateDeltas(false);
+    if (!sharedGeometryDeltas.empty()) {
+        translateDeltas(true);
+    }
+
+    size_t nbBytesCopied = 0;
+    for (auto& delta : deltas) {
+        MayaHydraRenderItemAdapter::UnmapDeltaBuffers(delta.buffers);
+        delta.ria->MarkDirty(delta.dirtyBits);
+        nbBytesCopied += delta.nbBytesCopied;
     }
+
+    static auto& nbRenderItemDeltas = Fvp::Instruments::instance().counter(kNbRenderItemDeltas);
+    nbRenderItemDeltas.add(deltas.size());
+    static auto& nbRenderItemBytesCopied = Fvp::Instruments::instance().counter(kNbRenderItemBytesCopied);
+    nbRenderItemBytesCopied.add(nbBytesCopied);
+    static auto& nbSharedRenderItemGeometries
+        = Fvp::Instruments::instance().counter(kNbSharedRenderItemGeometries);
+    nbSharedRenderItemGeometries.add(sharedGeometryDeltas.size());
 }
 
 void MayaHydraSceneIndex::Populate()
 {
+    // The population is completed by the first frame, which creates the
+    // render items and the lights, see PostFrame().
+    _isPopulating = true;
+    FVP_INSTRUMENTS_SCOPED_TIMER(kPopulateTime);
+    _currentFrame = MAnimControl::currentTime().value();
+
     MayaHydraAdapterRegistry::LoadAllPlugin();
 
     MStatus status;
     MItDag dagIt(MItDag::kDepthFirst);
     dagIt.traverseUnderWorld(true);
     if (useMeshAdapter()) {
+        // Collect the DAG paths first, then create the adapters, whose prims
+        // are added in a single batch rather than one notification each.
+        // Creating and populating an adapter calls the Maya API, which is not
+        // thread safe: like render item translation, this stays serial on the
+        // main thread, and only the added prims notification is batched.
+        MDagPathArray dagPaths;
         for (; !dagIt.isDone(); dagIt.next()) {
             MDagPath path;
             dagIt.getPath(path);
-            InsertDag(path);
+            dagPaths.append(path);
+        }
+
+        _AddedPrimsBatch addedPrimsBatch(*this);
+        for (unsigned int i = 0; i < dagPaths.length(); ++i) {
+            InsertDag(dagPaths[i]);
         }
     }
     else {
@@ -698,6 +906,19 @@ void MayaHydraSceneIndex::Populate()
     if (status) {
         _callbacks.push_back(id);
     }
+
+    // Renaming or reparenting any DAG node can change the scene index path
+    // of the UFE paths below it.
+    MObject allNodes; // A null node registers the callback for all nodes.
+    id = MNodeMessage::addNameChangedCallback(allNodes, _onNameChanged, this, &status);
+    if (status) {
+        _callbacks.push_back(id);
+    }
+    id = MDagMessage::addAllDagChangesCallback(_onDagChanged, this, &status);
+    if (status) {
+        _callbacks.push_back(id);
+    }
+    InvalidateUfePathCache();
 }
 
 void MayaHydraSceneIndex::SetDefaultLightEnabled(const bool enabled)
@@ -808,17 +1029,45 @@ Fvp::PrimSelections MayaHydraSceneIndex::UfePathToPrimSelections(const Ufe::Path
         return {};
     }
 
-    // Not the best implementation performance-wise, as ufeToDagPath converts
-    // the UFE path to a string, then does a Dag path lookup with the string.
-    
-    auto dagPath = UfeExtensions::ufeToDagPath(appPath);
-    const bool extendToShape = _UseTheShapeDagPath(dagPath);//For Hydra some prims, we need to use the shape dag path not the transform, as this is what gets translated to an hydra path
-    const bool isSprim = _IsDagPathRegisteredInHydraSPrims(dagPath);
+    static auto& nbCacheHits = Fvp::Instruments::instance().counter("MayaHydraSceneIndex:NbUfePathCacheHits");
+    static auto& nbCacheMisses = Fvp::Instruments::instance().counter("MayaHydraSceneIndex:NbUfePathCacheMisses");
+
+    _UfePathCacheEntry entry;
+    bool               isCached = false;
+    {
+        std::lock_guard<std::mutex> lock(_ufePathCacheMutex);
+        auto found = _primPathsByUfePath.find(appPath);
+        if (found != _primPathsByUfePath.end()) {
+            entry = found->second;
+            isCached = true;
+        }
+    }
+
+    if (isCached) {
+        nbCacheHits.add(1);
+    } else {
+        nbCacheMisses.add(1);
+
+        // ufeToDagPath converts the UFE path to a string, then does a Dag
+        // path lookup with the string, hence the cache.
+        auto dagPath = UfeExtensions::ufeToDagPath(appPath);
+        const bool extendToShape = _UseTheShapeDagPath(dagPath);//For Hydra some prims, we need to use the shape dag path not the transform, as this is what gets translated to an hydra path
+        const bool isSprim = _IsDagPathRegisteredInHydraSPrims(dagPath);
+
+        MDagPath   shapeDagPath(dagPath);
+        shapeDagPath.extendToShape();
 
-    MDagPath   shapeDagPath(dagPath);
-    shapeDagPath.extendToShape();
+        entry.primPath = GetPrimPath((extendToShape) ? shapeDagPath : dagPath, isSprim);
+        entry.shapeNodeHashCode = MObjectHandle(shapeDagPath.node()).hashCode();
 
-    SdfPath primPath = GetPrimPath((extendToShape) ? shapeDagPath : dagPath, isSprim);
+        // Paths of nodes which do not exist yet are not cached.
+        if (dagPath.isValid()) {
+            std::lock_guard<std::mutex> lock(_ufePathCacheMutex);
+            _primPathsByUfePath.emplace(appPath, entry);
+        }
+    }
+
+    SdfPath primPath = entry.primPath;
     
     //Check if this maya node has a special SdfPath associated with it, this is for custom or maya usd data producers scene indices.
     //The class MhDataProducersMayaNodeToSdfPathRegistry does a mapping between Maya nodes and USD paths.
@@ -827,7 +1076,7 @@ Fvp::PrimSelections MayaHydraSceneIndex::UfePathToPrimSelections(const Ufe::Path
     //maya nodes to return the matching SdfPath so that all prims child of this maya node are
     //highlighted.
     
-    const SdfPath matchingPath = FVP_NS::DataProducersNodeHashCodeToSdfPathRegistry::Instance().GetPath(MObjectHandle(shapeDagPath.node()).hashCode());
+    const SdfPath matchingPath = FVP_NS::DataProducersNodeHashCodeToSdfPathRegistry::Instance().GetPath(entry.shapeNodeHashCode);
     if (! matchingPath.IsEmpty()) {
         primPath = matchingPath;
     }
@@ -853,7 +1102,22 @@ Fvp::PrimSelections MayaHydraSceneIndex::UfePathToPrimSelectionsLit(
         return {};
     }
 
-    SdfPath primPath = GetLightedPrimsRootPath().AppendPath(toSdfPath(UfeExtensions::ufeToDagPath(appPath)).MakeRelativePath(SdfPath::AbsoluteRootPath()));
+    SdfPath primPath;
+    {
+        std::lock_guard<std::mutex> lock(_ufePathCacheMutex);
+        auto found = _litPrimPathsByUfePath.find(appPath);
+        if (found != _litPrimPathsByUfePath.end()) {
+            primPath = found->second;
+        }
+    }
+    if (primPath.IsEmpty()) {
+        const auto dagPath = UfeExtensions::ufeToDagPath(appPath);
+        primPath = GetLightedPrimsRootPath().AppendPath(toSdfPath(dagPath).MakeRelativePath(SdfPath::AbsoluteRootPath()));
+        if (dagPath.isValid()) {
+            std::lock_guard<std::mutex> lock(_ufePathCacheMutex);
+            _litPrimPathsByUfePath.emplace(appPath, primPath);
+        }
+    }
     TF_DEBUG(MAYAHYDRALIB_SCENE_INDEX)
         .Msg("    mapped to scene index path %s.\n", primPath.GetText());
 
@@ -871,12 +1135,24 @@ SdfPath MayaHydraSceneIndex::SetCameraViewport(const MDagPath& camPath, const Gf
     return {};
 }
 
-bool MayaHydraSceneIndex::IsPickedNodeInComponentsPickingMode(const HdxPickHit& hit)const
+void MayaHydraSceneIndex::UpdateHilitedMeshes()
 {
-    // Is the picked node in components selection mode ? If so it is in the hilite list
+    _hilitedMeshes.clear();
+
     MSelectionList hiliteList;
     MGlobal::getHiliteList(hiliteList);
-    if (hiliteList.isEmpty()){
+    MItSelectionList selListIter(hiliteList, MFn::kMesh); // Iterate on meshes only
+    for (; !selListIter.isDone(); selListIter.next()) {
+        MDagPath dagPath;
+        selListIter.getDagPath(dagPath);
+        _hilitedMeshes.insert({ MObjectHandle(dagPath.node()), dagPath.instanceNumber() });
+    }
+}
+
+bool MayaHydraSceneIndex::IsPickedNodeInComponentsPickingMode(const HdxPickHit& hit)const
+{
+    // Is the picked node in components selection mode ? If so it is in the hilite list
+    if (_hilitedMeshes.empty()){
         return false;
     }
 
@@ -886,22 +1162,14 @@ bool MayaHydraSceneIndex::IsPickedNodeInComponentsPickingMode(const HdxPickHit&
     if (hitId.HasPrefix(GetRprimPath())) {
         _FindAdapter<MayaHydraRenderItemAdapter>(
             hitId,
-            [&hit, &hiliteList, &isOneMayaNodeInComponentsPickingMode](
+            [this, &isOneMayaNodeInComponentsPickingMode](
                 MayaHydraRenderItemAdapter* a) {
                 // prepare the selection path of the hit item, the transform path is expected if
                 // available
                 const auto& itemPath = a->GetDagPath();
 
-                // Is the picked node in components selection mode ? If so it is in the hilite list
-                MItSelectionList selListIter(hiliteList, MFn::kMesh); // Iterate on meshes only
-                for (; !selListIter.isDone(); selListIter.next()) {
-                    MDagPath dagPath;
-                    selListIter.getDagPath(dagPath);
-                    if (itemPath == dagPath) {
-                        isOneMayaNodeInComponentsPickingMode = true;
-                        return;
-                    }
-                }
+                isOneMayaNodeInComponentsPickingMode = _hilitedMeshes.count(
+                    { MObjectHandle(itemPath.node()), itemPath.instanceNumber() }) > 0;
             },
             _renderItemsAdapters);
         return isOneMayaNodeInComponentsPickingMode;
@@ -969,6 +1237,10 @@ LightDagPathMap MayaHydraSceneIndex::_GetGlobalLightPaths() const
 
 void MayaHydraSceneIndex::PreFrame(const MHWRender::MDrawContext& context)
 {
+    _DirtyPrimsBatch dirtyPrimsBatch(*this);
+
+    _currentFrame = MAnimControl::currentTime().value();
+
     const bool xRayEnabled = (context.getDisplayStyle() & MHWRender::MFrameContext::kXray);
     if (xRayEnabled != _xRayEnabled) {
         _xRayEnabled = xRayEnabled;
@@ -982,13 +1254,8 @@ void MayaHydraSceneIndex::PreFrame(const MHWRender::MDrawContext& context)
                     id,
                     [](MayaHydraMaterialAdapter* a) { return a->UpdateMaterialTag(); },
                     _materialAdapters)) {
-                    auto& renderIndex = GetRenderIndex();
-                    for (const auto& rprimId : renderIndex.GetRprimIds()) {
-                        const auto* rprim = renderIndex.GetRprim(rprimId);
-                        if (rprim != nullptr && rprim->GetMaterialId() == id) {
-                            RebuildAdapterOnIdle(
-                                rprim->GetId(), MayaHydraSceneIndex::RebuildFlagPrim);
-                        }
+                    for (const auto& rprimId : GetMaterialUsers(id)) {
+                        RebuildAdapterOnIdle(rprimId, MayaHydraSceneIndex::RebuildFlagPrim);
                     }
                 }
             }
@@ -997,6 +1264,7 @@ void MayaHydraSceneIndex::PreFrame(const MHWRender::MDrawContext& context)
     }
 
     if (!_lightsToAdd.empty()) {
+        _AddedPrimsBatch addedPrimsBatch(*this);
         for (auto& lightToAdd : _lightsToAdd) {
             MDagPath dag;
             MStatus  status = MDagPath::getAPathTo(lightToAdd.first, dag);
@@ -1163,6 +1431,7 @@ bool MayaHydraSceneIndex::GetPlaybackRunning() const
 
 void MayaHydraSceneIndex::PostFrame()
 {
+    _isPopulating = false;
 }
 
 void MayaHydraSceneIndex::InsertPrim(
@@ -1184,8 +1453,15 @@ void MayaHydraSceneIndex::InsertPrim(
     // which for HdSceneIndexPrim is an invalid prim with a null data source.
     // Therefore, insert missing ancestors ourselves, with a non-null data
     // source and empty type.
+    if (_addedPrimsBatchDepth > 0) {
+        _pendingAddedPrims.push_back({ id, typeId, dataSource });
+        return;
+    }
+
+    // Keep the notifications ordered : prims dirtied so far are sent before this one is added.
+    _FlushDirtiedPrims();
     _AddPrimAncestors(id);
-    AddPrims({ { id, typeId, dataSource } });
+    _SendAddedPrims({ { id, typeId, dataSource } });
 }
 
 void MayaHydraSceneIndex::_AddPrimAncestors(const SdfPath& path)
@@ -1194,7 +1470,7 @@ void MayaHydraSceneIndex::_AddPrimAncestors(const SdfPath& path)
     if (!GetPrim(parentPath).dataSource) {
         // Add a parent prim with an empty type and an empty data source, and
         // recurse up to the next ancestor level.
-        AddPrims(
+        _SendAddedPrims(
             {{ parentPath, TfToken(), HdRetainedContainerDataSource::New() }});
         _AddPrimAncestors(parentPath);
     }
@@ -1228,13 +1504,153 @@ void MayaHydraSceneIndex::_MarkPrimDirty(
     HdSceneIndexPrim prim = GetPrim(id);
     HdDataSourceLocatorSet locators;
     dirtyBitsToLocatorsFunc(prim.primType, dirtyBits, &locators);
-    if (!locators.IsEmpty()) {
-        DirtyPrims({ {id, locators} });
+    if (locators.IsEmpty()) {
+        return;
+    }
+
+    // Cached data sources must be rebuilt from the adapter for the dirtied locators.
+    if (auto dataSource = std::dynamic_pointer_cast<MayaHydraDataSource>(prim.dataSource)) {
+        dataSource->Invalidate(locators);
+    }
+
+    // Prims added in a batch are not known downstream yet : they are dirtied once added.
+    if (_dirtyPrimsBatchDepth == 0 && _addedPrimsBatchDepth == 0) {
+        _SendDirtiedPrims({ {id, locators} });
+        return;
+    }
+
+    // Coalesce the locators of a prim dirtied several times in the batch.
+    const auto found = _pendingDirtiedPrimsIndices.find(id);
+    if (found != _pendingDirtiedPrimsIndices.end()) {
+        _pendingDirtiedPrims[found->second].dirtyLocators.insert(locators);
+    } else {
+        _pendingDirtiedPrimsIndices.emplace(id, _pendingDirtiedPrims.size());
+        _pendingDirtiedPrims.emplace_back(id, locators);
+    }
+}
+
+void MayaHydraSceneIndex::_SendDirtiedPrims(const HdSceneIndexObserver::DirtiedPrimEntries& entries)
+{
+    DirtyPrims(entries);
+    static auto& nbDirtyNotifications = Fvp::Instruments::instance().counter(kNbDirtyNotifications);
+    nbDirtyNotifications.add();
+}
+
+void MayaHydraSceneIndex::_FlushDirtiedPrims()
+{
+    // Prims are added before being dirtied.
+    _FlushAddedPrims();
+    if (_pendingDirtiedPrims.empty()) {
+        return;
+    }
+
+    HdSceneIndexObserver::DirtiedPrimEntries entries;
+    entries.swap(_pendingDirtiedPrims);
+    _pendingDirtiedPrimsIndices.clear();
+    _SendDirtiedPrims(entries);
+}
+
+MayaHydraSceneIndex::_DirtyPrimsBatch::_DirtyPrimsBatch(MayaHydraSceneIndex& sceneIndex)
+    : _sceneIndex(sceneIndex)
+{
+    ++_sceneIndex._dirtyPrimsBatchDepth;
+}
+
+MayaHydraSceneIndex::_DirtyPrimsBatch::~_DirtyPrimsBatch()
+{
+    if (--_sceneIndex._dirtyPrimsBatchDepth == 0) {
+        _sceneIndex._FlushDirtiedPrims();
+    }
+}
+
+void MayaHydraSceneIndex::_FlushAddedPrims()
+{
+    if (_pendingAddedPrims.empty()) {
+        return;
+    }
+
+    HdRetainedSceneIndex::AddedPrimEntries pendingPrims;
+    pendingPrims.swap(_pendingAddedPrims);
+
+    // Sort the prims by path, in parallel as comparing paths is not cheap on
+    // large scenes.  The insertion order breaks ties, so that the last
+    // insertion of a prim wins, as with separate AddPrims calls.
+    std::vector<std::pair<SdfPath, size_t>> order(pendingPrims.size());
+    for (size_t i = 0; i < pendingPrims.size(); ++i) {
+        order[i] = { pendingPrims[i].primPath, i };
+    }
+    tbb::parallel_sort(order.begin(), order.end());
+
+    HdRetainedSceneIndex::AddedPrimEntries entries;
+    entries.reserve(order.size());
+    for (size_t i = 0; i < order.size(); ++i) {
+        if (i + 1 < order.size() && order[i + 1].first == order[i].first) {
+            continue;
+        }
+        entries.push_back(pendingPrims[order[i].second]);
+    }
+
+    // Add the missing ancestors, see InsertPrim(), each once, walking up from
+    // each prim until a known ancestor is found.
+    std::set<SdfPath> ancestors;
+    const auto isPending = [&entries](const SdfPath& path) {
+        auto found = std::lower_bound(entries.begin(), entries.end(), path,
+            [](const auto& entry, const SdfPath& primPath) { return entry.primPath < primPath; });
+        return found != entries.end() && found->primPath == path;
+    };
+    for (const auto& entry : entries) {
+        for (SdfPath parentPath = entry.primPath.GetParentPath();
+             !parentPath.IsEmpty() && !ancestors.count(parentPath) && !isPending(parentPath)
+             && !GetPrim(parentPath).dataSource;
+             parentPath = parentPath.GetParentPath()) {
+            ancestors.insert(parentPath);
+        }
+    }
+
+    HdRetainedSceneIndex::AddedPrimEntries ancestorEntries;
+    ancestorEntries.reserve(ancestors.size() + entries.size());
+    for (const auto& ancestor : ancestors) {
+        ancestorEntries.push_back({ ancestor, TfToken(), HdRetainedContainerDataSource::New() });
+    }
+    entries.insert(entries.begin(), ancestorEntries.begin(), ancestorEntries.end());
+
+    if (_isPopulating) {
+        static auto& nbPopulatedPrims = Fvp::Instruments::instance().counter(kNbPopulatedPrims);
+        nbPopulatedPrims.add(entries.size());
+    }
+    _SendAddedPrims(entries);
+}
+
+void MayaHydraSceneIndex::_SendAddedPrims(const HdRetainedSceneIndex::AddedPrimEntries& entries)
+{
+    AddPrims(entries);
+    static auto& nbAddedPrimsNotifications
+        = Fvp::Instruments::instance().counter(kNbAddedPrimsNotifications);
+    nbAddedPrimsNotifications.add();
+}
+
+MayaHydraSceneIndex::_AddedPrimsBatch::_AddedPrimsBatch(MayaHydraSceneIndex& sceneIndex)
+    : _sceneIndex(sceneIndex)
+{
+    ++_sceneIndex._addedPrimsBatchDepth;
+}
+
+MayaHydraSceneIndex::_AddedPrimsBatch::~_AddedPrimsBatch()
+{
+    if (--_sceneIndex._addedPrimsBatchDepth == 0) {
+        _sceneIndex._FlushAddedPrims();
+        // Send the prims dirtied during the batch, unless a dirtied prims batch does it.
+        if (_sceneIndex._dirtyPrimsBatchDepth == 0) {
+            _sceneIndex._FlushDirtiedPrims();
+        }
     }
 }
 
 void MayaHydraSceneIndex::RemovePrim(const SdfPath& id)
 {
+    // Keep the notifications ordered : prims added and dirtied so far are sent before this one is
+    // removed.
+    _FlushDirtiedPrims();
     RemovePrims({ id });
 }
 
@@ -1338,14 +1754,16 @@ SdfPath MayaHydraSceneIndex::GetMaterialId(const SdfPath& id)
         }
         auto material = shapeAdapter->get()->GetMaterial();
         if (material == MObject::kNullObj) {
+            _BindMaterial(id, _fallbackMaterial);
             return _fallbackMaterial;
         }
         auto materialId = GetMaterialPath(material);
-        if (TfMapLookupPtr(_materialAdapters, materialId) != nullptr) {
-            return materialId;
+        if (TfMapLookupPtr(_materialAdapters, materialId) == nullptr
+            && !_CreateMaterial(materialId, material)) {
+            materialId = _fallbackMaterial;
         }
-
-        return _CreateMaterial(materialId, material) ? materialId : _fallbackMaterial;
+        _BindMaterial(id, materialId);
+        return materialId;
     }
 
     return _fallbackMaterial;
@@ -1375,6 +1793,7 @@ void MayaHydraSceneIndex::RemoveAdapter(const SdfPath& id)
         TF_WARN(
             "MayaHydraSceneIndex::RemoveAdapter(%s) -- Adapter does not exists", id.GetText());
     }
+    _UnbindMaterial(id);
 }
 
 void MayaHydraSceneIndex::RecreateAdapterOnIdle(const SdfPath& id, const MObject& obj)
@@ -1421,6 +1840,7 @@ void MayaHydraSceneIndex::_RemoveRenderItem(const MayaHydraRenderItemAdapterPtr&
 {
     const SdfPath& primPath = ria->GetID();
     _renderItemsAdaptersFast.erase(ria->GetFastID());
+    _UnbindMaterial(primPath);
     _renderItemsAdapters.erase(primPath);
 }
 
@@ -1518,6 +1938,7 @@ void MayaHydraSceneIndex::RecreateAdapter(const SdfPath& id, const MObject& obj)
             a->RemovePrim();
         },
         _shapeAdapters)) {
+        _UnbindMaterial(id);
         MFnDagNode dgNode(obj);
         MDagPath   path;
         dgNode.getPath(path);
@@ -1534,12 +1955,8 @@ void MayaHydraSceneIndex::RecreateAdapter(const SdfPath& id, const MObject& obj)
             a->RemovePrim();
         },
         _materialAdapters)) {
-        auto& renderIndex = GetRenderIndex();
-        for (const auto& rprimId : renderIndex.GetRprimIds()) {
-            const auto* rprim = renderIndex.GetRprim(rprimId);
-            if (rprim != nullptr && rprim->GetMaterialId() == id) {
-                MarkRprimDirty(rprimId, HdChangeTracker::DirtyMaterialId);
-            }
+        for (const auto& rprimId : GetMaterialUsers(id)) {
+            MarkRprimDirty(rprimId, HdChangeTracker::DirtyMaterialId);
         }
         if (MObjectHandle(obj).isValid()) {
             _CreateMaterial(GetMaterialPath(obj), obj);
@@ -1621,8 +2038,89 @@ void MayaHydraSceneIndex::OnDagNodeAdded(const MObject& obj)
     }
 }
 
+void MayaHydraSceneIndex::InvalidateUfePathCache()
+{
+    std::lock_guard<std::mutex> lock(_ufePathCacheMutex);
+    _primPathsByUfePath.clear();
+    _litPrimPathsByUfePath.clear();
+}
+
+void MayaHydraSceneIndex::_EraseUfePathCacheEntries(const std::function<bool(const Ufe::Path&)>& isStale)
+{
+    std::lock_guard<std::mutex> lock(_ufePathCacheMutex);
+    for (auto it = _primPathsByUfePath.begin(); it != _primPathsByUfePath.end();) {
+        it = isStale(it->first) ? _primPathsByUfePath.erase(it) : std::next(it);
+    }
+    for (auto it = _litPrimPathsByUfePath.begin(); it != _litPrimPathsByUfePath.end();) {
+        it = isStale(it->first) ? _litPrimPathsByUfePath.erase(it) : std::next(it);
+    }
+}
+
+void MayaHydraSceneIndex::_EraseUfePathCacheSubtrees(const MObject& obj)
+{
+    MDagPathArray dagPaths;
+    if (!MDagPath::getAllPathsTo(obj, dagPaths) || dagPaths.length() == 0) {
+        InvalidateUfePathCache();
+        return;
+    }
+    std::vector<Ufe::Path> roots;
+    for (unsigned int i = 0; i < dagPaths.length(); ++i) {
+        roots.emplace_back(UfeExtensions::dagPathToUfePathSegment(dagPaths[i]));
+    }
+    _EraseUfePathCacheEntries([&roots](const Ufe::Path& path) {
+        return std::any_of(roots.begin(), roots.end(),
+            [&path](const Ufe::Path& root) { return path.startsWith(root); });
+    });
+}
+
+void MayaHydraSceneIndex::OnNodeRenamed(const MObject& node, const MString& prevName)
+{
+    if (!node.hasFn(MFn::kDagNode)) {
+        return;
+    }
+    // The previous paths of the node and of its descendants hold its previous
+    // name. Nodes of the same name elsewhere are erased as well, which only
+    // costs converting them again.
+    std::string name(prevName.asChar());
+    name = name.substr(name.find_last_of('|') + 1);
+    if (name.empty()) {
+        return;
+    }
+    _EraseUfePathCacheEntries([&name](const Ufe::Path& path) {
+        for (const auto& segment : path.getSegments()) {
+            for (const auto& component : segment.components()) {
+                if (component.string() == name) {
+                    return true;
+                }
+            }
+        }
+        return false;
+    });
+}
+
+void MayaHydraSceneIndex::OnDagChanged(const MDagPath& child, const MDagPath& parent)
+{
+    // On removal the child was under parent, on addition it now is : erase
+    // the conversions under that location.
+    MStatus     status;
+    MFnDagNode  childNode(child.node(), &status);
+    const auto  parentSegment = UfeExtensions::dagPathToUfePathSegment(parent);
+    if (!status || parentSegment.empty()) {
+        InvalidateUfePathCache();
+        return;
+    }
+    auto components = parentSegment.components();
+    components.emplace_back(childNode.name().asChar());
+    const Ufe::Path childPath(
+        Ufe::PathSegment(components, UfeExtensions::getMayaRunTimeId(), '|'));
+    _EraseUfePathCacheEntries(
+        [&childPath](const Ufe::Path& path) { return path.startsWith(childPath); });
+}
+
 void MayaHydraSceneIndex::OnDagNodeRemoved(const MObject& obj)
 {
+    _EraseUfePathCacheSubtrees(obj);
+
     const auto it
         = std::remove_if(_lightsToAdd.begin(), _lightsToAdd.end(), [&obj](const auto& item) {
         return item.first == obj;
@@ -1679,6 +2177,7 @@ void MayaHydraSceneIndex::InsertDag(const MDagPath& dag)
             if (TfMapLookupPtr(_materialAdapters, materialId) == nullptr) {
                 _CreateMaterial(materialId, material);
             }
+            _BindMaterial(adapter->GetID(), materialId);
         }
     }
 }
@@ -1698,6 +2197,55 @@ void MayaHydraSceneIndex::UpdateLightVisibility(const MDagPath& dag)
         _lightAdapters);
 }
 
+void MayaHydraSceneIndex::_BindMaterial(const SdfPath& rprimId, const SdfPath& materialId)
+{
+    std::lock_guard<std::mutex> lock(_materialBindingsMutex);
+    auto                        found = _materialByRprim.find(rprimId);
+    if (found != _materialByRprim.end()) {
+        if (found->second == materialId) {
+            return;
+        }
+        auto users = _rprimsByMaterial.find(found->second);
+        if (users != _rprimsByMaterial.end()) {
+            users->second.erase(rprimId);
+            if (users->second.empty()) {
+                _rprimsByMaterial.erase(users);
+            }
+        }
+        found->second = materialId;
+    } else {
+        _materialByRprim.emplace(rprimId, materialId);
+    }
+    _rprimsByMaterial[materialId].insert(rprimId);
+}
+
+void MayaHydraSceneIndex::_UnbindMaterial(const SdfPath& rprimId)
+{
+    std::lock_guard<std::mutex> lock(_materialBindingsMutex);
+    auto                        found = _materialByRprim.find(rprimId);
+    if (found == _materialByRprim.end()) {
+        return;
+    }
+    auto users = _rprimsByMaterial.find(found->second);
+    if (users != _rprimsByMaterial.end()) {
+        users->second.erase(rprimId);
+        if (users->second.empty()) {
+            _rprimsByMaterial.erase(users);
+        }
+    }
+    _materialByRprim.erase(found);
+}
+
+SdfPathVector MayaHydraSceneIndex::GetMaterialUsers(const SdfPath& materialId) const
+{
+    std::lock_guard<std::mutex> lock(_materialBindingsMutex);
+    auto                        users = _rprimsByMaterial.find(materialId);
+    if (users == _rprimsByMaterial.end()) {
+        return {};
+    }
+    return SdfPathVector(users->second.begin(), users->second.end());
+}
+
 SdfPath MayaHydraSceneIndex::GetMaterialPath(const MObject& obj)
 {
     return _GetMaterialPath(_materialPath, obj);
@@ -1782,6 +2330,26 @@ bool MayaHydraSceneIndex::passNormalsToHydra()
     return val;
 }
 
+bool MayaHydraSceneIndex::parallelRenderItemUpdate()
+{
+    return parallelRenderItemUpdateFlag().load();
+}
+
+void MayaHydraSceneIndex::setParallelRenderItemUpdate(bool enable)
+{
+    parallelRenderItemUpdateFlag().store(enable);
+}
+
+bool MayaHydraSceneIndex::shareInstancedGeometry()
+{
+    return shareInstancedGeometryFlag().load();
+}
+
+void MayaHydraSceneIndex::setShareInstancedGeometry(bool enable)
+{
+    shareInstancedGeometryFlag().store(enable);
+}
+
 VtValue MayaHydraSceneIndex::_CreateDefaultMaterialFallback()
 {
     static const MColor kDefaultGrayColor = MColor(0.5f, 0.5f, 0.5f) * 0.8f;
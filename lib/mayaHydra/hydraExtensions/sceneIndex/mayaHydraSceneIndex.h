@@ -20,6 +20,7 @@
 #include <maya/MDagPath.h>
 #include <maya/MFrameContext.h>
 #include <maya/MObject.h>
+#include <maya/MObjectHandle.h>
 #include <maya/MSelectionList.h>
 #include <maya/MViewport2Renderer.h>
 #include <maya/MDrawContext.h>
@@ -29,6 +30,7 @@
 #include <mayaHydraLib/adapters/shapeAdapter.h>
 #include <mayaHydraLib/adapters/renderItemAdapter.h>
 #include <mayaHydraLib/adapters/materialAdapter.h>
+#include <mayaHydraLib/adapters/materialNodeCache.h>
 #include <mayaHydraLib/adapters/lightAdapter.h>
 #include <mayaHydraLib/adapters/cameraAdapter.h>
 #include <mayaHydraLib/sceneIndex/mayaHydraDefaultLightDataSource.h>
@@ -37,7 +39,10 @@
 #include "flowViewport/sceneIndex/fvpPathInterface.h"
 #include <flowViewport/selection/fvpPathMapperFwd.h>
 
+#include <ufe/path.h>
+
 #include <pxr/pxr.h>
+#include <pxr/base/tf/hash.h>
 #include <pxr/usd/sdf/path.h>
 #include <pxr/imaging/hdx/pickTask.h>
 #include <pxr/imaging/hd/changeTracker.h>
@@ -50,7 +55,10 @@
 #include <pxr/imaging/hd/retainedSceneIndex.h>
 #include "pxr/imaging/hd/dirtyBitsTranslator.h"
 
+#include <functional>
+#include <mutex>
 #include <unordered_map>
+#include <unordered_set>
 
 namespace FVP_NS_DEF {
 class RenderIndexProxy;
@@ -125,6 +133,11 @@ public:
         MSelectionList& selectionList,
         MPointArray& worldSpaceHitPts);
 
+    /// Fetch the hilited meshes from the Maya hilite list.  Must be called
+    /// at the start of each pick, before IsPickedNodeInComponentsPickingMode(),
+    /// as Maya does not notify hilite list changes.
+    void UpdateHilitedMeshes();
+
     bool IsPickedNodeInComponentsPickingMode(const HdxPickHit& hit)const;
     
 
@@ -201,9 +214,22 @@ public:
 
     bool GetPlaybackRunning() const;
 
+    /// Current Maya frame, updated from the main thread before each frame : it can be read from
+    /// the sync threads, where MAnimControl must not be called.
+    double GetCurrentFrame() const { return _currentFrame; }
+
     Fvp::PrimSelections UfePathToPrimSelections(const Ufe::Path& appPath) const override;
     Fvp::PrimSelections UfePathToPrimSelectionsLit(const Ufe::Path& appPath) const;
 
+    /// Called on Maya DAG changes (rename, reparent, instancing) which change
+    /// the UFE path to scene index path mapping : only the cached conversions
+    /// of the changed node and of its descendants are erased.
+    void OnNodeRenamed(const MObject& node, const MString& prevName);
+    void OnDagChanged(const MDagPath& child, const MDagPath& parent);
+
+    /// Erase all the cached UFE path to scene index path conversions.
+    void InvalidateUfePathCache();
+
     //Sdfpath of the maya default material
     SdfPath GetDefaultMaterialPath() const{return _mayaDefaultMaterialPath;}
 
@@ -212,6 +238,15 @@ public:
     //Is the exclusion list of materials that should be skipped when using the default material
     SdfPathVector GetDefaultMaterialExclusionPaths()const{ return {_mayaFacesSelectionMaterialPath};}
 
+    //! Path of the material of a Maya shading engine node.
+    SdfPath GetMaterialPath(const MObject& obj);
+
+    //! Rprims bound to a material.
+    SdfPathVector GetMaterialUsers(const SdfPath& materialId) const;
+
+    //! Converted shading nodes, shared by the material adapters of this scene index.
+    MayaHydraMaterialNodeCache& GetMaterialNodeCache() { return _materialNodeCache; }
+
     // Common function to return templated sample types
     template <typename T, typename Getter>
     size_t SampleValues(size_t maxSampleCount, float* times, T* samples, Getter getValue)
@@ -232,13 +267,16 @@ public:
         // For sample size of 1 tStep is unused and we match USD and to provide t=shutterOpen
         // sample.
         const double tStep = maxSampleCount > 1 ? (shutter.GetSize() / (maxSampleCount - 1)) : 0;
-        const MTime  mayaTime = MAnimControl::currentTime();
+        const MTime  mayaTime(_currentFrame, MTime::uiUnit());
         size_t       nSamples = 0;
         double       relTime = shutter.GetMin();
 
         for (size_t i = 0; i < maxSampleCount; ++i) {
             T sample;
-            {
+            if (relTime == 0.0) {
+                // No need to switch the DG context for the current frame.
+                sample = getValue();
+            } else {
                 MDGContextGuard guard(mayaTime + relTime);
                 sample = getValue();
             }
@@ -257,6 +295,16 @@ public:
     /// Is using an environment variable to tell if we should pass normals to Hydra when using the render item and mesh adapters
     static bool passNormalsToHydra();
 
+    /// Is using an environment variable to tell if render item buffers are translated in parallel in HandleCompleteViewportScene.
+    /// Can be changed at runtime, e.g. to compare with the serial translation.
+    static bool parallelRenderItemUpdate();
+    static void setParallelRenderItemUpdate(bool enable);
+
+    /// Is using an environment variable to tell if the render items of the instances of a shape share their buffers.
+    /// Can be changed at runtime, e.g. to compare with unshared buffers.
+    static bool shareInstancedGeometry();
+    static void setShareInstancedGeometry(bool enable);
+
     ///Create the default material from the "standardSurface1" maya material or create a fallback material if it cannot be found
     void CreateMayaDefaultMaterialData();
 
@@ -280,13 +328,19 @@ private:
 
     // Utilites
     bool _GetRenderItem(int fastId, MayaHydraRenderItemAdapterPtr& adapter);
+    void _EraseUfePathCacheEntries(const std::function<bool(const Ufe::Path&)>& isStale);
+    void _EraseUfePathCacheSubtrees(const MObject& obj);
     void _AddPrimAncestors(const SdfPath& path);
     void _AddRenderItem(const MayaHydraRenderItemAdapterPtr& ria);
     void _RemoveRenderItem(const MayaHydraRenderItemAdapterPtr& ria);
     bool _GetRenderItemMaterial(const MRenderItem& ri, SdfPath& material, MObject& shadingEngineNode);
     SdfPath _GetRenderItemPrimPath(const MRenderItem& ri);
-    SdfPath GetMaterialPath(const MObject& obj);
     bool _CreateMaterial(const SdfPath& id, const MObject& obj);
+
+    // Material bindings of the rprims, indexed by material to find the users of a material without
+    // traversing the render index.
+    void          _BindMaterial(const SdfPath& rprimId, const SdfPath& materialId);
+    void          _UnbindMaterial(const SdfPath& rprimId);
     
     using LightDagPathMap = std::unordered_map<std::string, MDagPath>;
     LightDagPathMap _GetGlobalLightPaths() const;
@@ -299,6 +353,36 @@ private:
         const SdfPath&          id,
         HdDirtyBits             dirtyBits,
         DirtyBitsToLocatorsFunc dirtyBitsToLocatorsFunc);
+
+    // Dirty notifications batching : while a _DirtyPrimsBatch is alive, dirtied prims are
+    // accumulated, with their locators coalesced per path, and sent downstream in a single
+    // DirtyPrims call when the outermost batch ends.
+    class _DirtyPrimsBatch
+    {
+    public:
+        _DirtyPrimsBatch(MayaHydraSceneIndex& sceneIndex);
+        ~_DirtyPrimsBatch();
+
+    private:
+        MayaHydraSceneIndex& _sceneIndex;
+    };
+    void _SendDirtiedPrims(const HdSceneIndexObserver::DirtiedPrimEntries& entries);
+    void _FlushDirtiedPrims();
+
+    // Prim insertion batching : while an _AddedPrimsBatch is alive, inserted prims are
+    // accumulated, and added with their missing ancestors in a single sorted AddPrims call
+    // when the outermost batch ends.
+    class _AddedPrimsBatch
+    {
+    public:
+        _AddedPrimsBatch(MayaHydraSceneIndex& sceneIndex);
+        ~_AddedPrimsBatch();
+
+    private:
+        MayaHydraSceneIndex& _sceneIndex;
+    };
+    void _FlushAddedPrims();
+    void _SendAddedPrims(const HdRetainedSceneIndex::AddedPrimEntries& entries);
 private:
     // ------------------------------------------------------------------------
     // HdSceneIndexBase implementations
@@ -315,6 +399,9 @@ private:
 
     HdRenderIndex* _renderIndex = nullptr;
 
+    // Declared before the adapters, so that it outlives the material adapters using it.
+    MayaHydraMaterialNodeCache _materialNodeCache;
+
     // Adapters
     AdapterMap<MayaHydraLightAdapterPtr> _lightAdapters;
     AdapterMap<MayaHydraCameraAdapterPtr> _cameraAdapters;
@@ -332,6 +419,11 @@ private:
     std::vector<std::pair<MObject, LightAdapterCreator>> _lightsToAdd;
     std::vector<SdfPath> _materialTagsChanged;
 
+    // GetMaterialId() binds the materials of shape adapters, and may be called from several threads.
+    mutable std::mutex                                     _materialBindingsMutex;
+    std::unordered_map<SdfPath, SdfPathSet, SdfPath::Hash> _rprimsByMaterial;
+    std::unordered_map<SdfPath, SdfPath, SdfPath::Hash>    _materialByRprim;
+
     bool _defaultMaterialCreated = false;
     static SdfPath _fallbackMaterial;
     /// _mayaDefaultMaterialPath is common to all scene indexes
@@ -348,11 +440,56 @@ private:
     bool _useMayaDefaultLight = false;
     static SdfPath _mayaDefaultLightPath;
 
+    // Hilited mesh DAG paths, identified by node and instance number, so
+    // that testing a pick hit for components picking mode is a lookup
+    // rather than a walk of the hilite list.
+    struct _DagPathKey
+    {
+        MObjectHandle node;
+        unsigned int  instanceNumber;
+        bool operator==(const _DagPathKey& other) const {
+            return node == other.node && instanceNumber == other.instanceNumber;
+        }
+    };
+    struct _HashDagPathKey
+    {
+        size_t operator()(const _DagPathKey& key) const {
+            return TfHash::Combine(key.node.hashCode(), key.instanceNumber);
+        }
+    };
+
+    // Scene index paths of Maya UFE paths, which are costly to compute
+    // (UFE path to string to DAG path, and DAG path to sanitized SdfPath).
+    // The entries at or below a renamed, reparented or removed node are
+    // erased.  The data producer registry is looked up on each
+    // query with the shape node hash code, as it changes independently.
+    struct _UfePathCacheEntry
+    {
+        SdfPath       primPath;
+        unsigned long shapeNodeHashCode = 0;
+    };
+    mutable std::mutex                                         _ufePathCacheMutex;
+    mutable std::unordered_map<Ufe::Path, _UfePathCacheEntry>  _primPathsByUfePath;
+    mutable std::unordered_map<Ufe::Path, SdfPath>             _litPrimPathsByUfePath;
+    std::unordered_set<_DagPathKey, _HashDagPathKey> _hilitedMeshes;
+
     bool _xRayEnabled = false;
     bool _isPlaybackRunning = false;
+    double _currentFrame = 0.0;
     bool _lightsEnabled = true;
     bool _isHdSt = false;
 
+    // Dirty notifications batching, see _DirtyPrimsBatch.
+    int                                       _dirtyPrimsBatchDepth = 0;
+    HdSceneIndexObserver::DirtiedPrimEntries  _pendingDirtiedPrims;
+    std::unordered_map<SdfPath, size_t, SdfPath::Hash> _pendingDirtiedPrimsIndices;
+
+    // Prim insertion batching, see _AddedPrimsBatch.
+    int                                       _addedPrimsBatchDepth = 0;
+    HdRetainedSceneIndex::AddedPrimEntries    _pendingAddedPrims;
+    // From Populate() to the end of the first frame.
+    bool                                      _isPopulating = false;
+
     SdfPath _rprimPath;
     SdfPath _sprimPath;
     SdfPath _materialPath;
@@ -0,0 +1,53 @@
+//
+// Copyright 2024 Autodesk, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include "mayaHydraXformDataSource.h"
+
+#include <mayaHydraLib/adapters/adapter.h>
+#include <mayaHydraLib/sceneIndex/mayaHydraSceneIndex.h>
+
+#include <flowViewport/fvpInstruments.h>
+
+PXR_NAMESPACE_OPEN_SCOPE
+
+MayaHydraXformMatrixDataSource::MayaHydraXformMatrixDataSource(MayaHydraAdapter* adapter)
+    : _samples([adapter](size_t maxSampleCount, float* times, GfMatrix4d* samples) -> size_t {
+        static auto& nbAdapterGetsCounter
+            = Fvp::Instruments::instance().counter("MayaHydraDataSource:NbAdapterGets");
+        nbAdapterGetsCounter.add();
+        return adapter->SampleTransform(maxSampleCount, times, samples);
+    }, adapter->GetMayaHydraSceneIndex()->GetCurrentFrame())
+{
+}
+
+GfMatrix4d MayaHydraXformMatrixDataSource::GetTypedValue(Time shutterOffset)
+{
+    return _samples.GetValue(shutterOffset);
+}
+
+VtValue MayaHydraXformMatrixDataSource::GetValue(Time shutterOffset)
+{
+    return VtValue(GetTypedValue(shutterOffset));
+}
+
+bool MayaHydraXformMatrixDataSource::GetContributingSampleTimesForInterval(
+    Time startTime, Time endTime,
+    std::vector<Time>* outSampleTimes)
+{
+    return _samples.GetContributingSampleTimesForInterval(startTime, endTime, outSampleTimes);
+}
+
+PXR_NAMESPACE_CLOSE_SCOPE
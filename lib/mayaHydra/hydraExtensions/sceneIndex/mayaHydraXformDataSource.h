@@ -0,0 +1,56 @@
+//
+// Copyright 2024 Autodesk, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#ifndef MAYAHYDRAXFORMDATASOURCE_H
+#define MAYAHYDRAXFORMDATASOURCE_H
+
+#include <mayaHydraLib/sceneIndex/mayaHydraMotionSamples.h>
+
+#include <pxr/pxr.h>
+#include <pxr/base/gf/matrix4d.h>
+#include <pxr/imaging/hd/dataSource.h>
+#include <pxr/imaging/hd/dataSourceTypeDefs.h>
+
+PXR_NAMESPACE_OPEN_SCOPE
+
+class MayaHydraAdapter;
+
+/**
+ * \brief A matrix data source providing the motion samples of the transform of an adapter
+ */
+class MayaHydraXformMatrixDataSource : public HdMatrixDataSource
+{
+public:
+    HD_DECLARE_DATASOURCE(MayaHydraXformMatrixDataSource);
+
+    GfMatrix4d GetTypedValue(Time shutterOffset) override;
+    VtValue GetValue(Time shutterOffset) override;
+
+    bool GetContributingSampleTimesForInterval(
+        Time startTime, Time endTime,
+        std::vector<Time>* outSampleTimes) override;
+
+private:
+    MayaHydraXformMatrixDataSource(MayaHydraAdapter* adapter);
+
+    MayaHydraMotionSamples<GfMatrix4d> _samples;
+};
+
+HD_DECLARE_DATASOURCE_HANDLES(MayaHydraXformMatrixDataSource);
+
+PXR_NAMESPACE_CLOSE_SCOPE
+
+#endif // MAYAHYDRAXFORMDATASOURCE_H
@@ -41,6 +41,7 @@
 #include <flowViewport/colorPreferences/fvpColorPreferences.h>
 #include <flowViewport/colorPreferences/fvpColorPreferencesTokens.h>
 #include <flowViewport/debugCodes.h>
+#include <flowViewport/fvpInstruments.h>
 #include <flowViewport/sceneIndex/fvpRenderIndexProxy.h>
 #include <flowViewport/selection/fvpSelectionTask.h>
 #include <flowViewport/selection/fvpSelection.h>
@@ -114,6 +115,7 @@
 #include <maya/MFnCamera.h>
 #include <maya/MFileIO.h>
 
+#include <algorithm>
 #include <atomic>
 #include <chrono>
 #include <exception>
@@ -566,7 +568,32 @@ MStatus MtohRenderOverride::Render(
     //     }
     // }
     TF_DEBUG(MAYAHYDRALIB_RENDEROVERRIDE_RENDER).Msg("MtohRenderOverride::Render()\n");
+
+    //This code with strings comparison will go away if we have multiple render proxies when doing multi viewports
+    MString panelName;
+    auto framecontext = getFrameContext();
+    if (framecontext){
+        framecontext->renderingDestination(panelName);
+    }
+
+    // Account for this panel render in the instruments frame on every exit
+    // path, failures included.
+    struct PanelRenderScope
+    {
+        PanelRenderScope(MtohRenderOverride& renderOverride, const MString& panelName)
+            : _renderOverride(renderOverride), _panelName(panelName)
+        {
+            _renderOverride._BeginPanelRender(_panelName);
+        }
+        ~PanelRenderScope() { _renderOverride._EndPanelRender(_panelName); }
+
+        MtohRenderOverride& _renderOverride;
+        const MString&      _panelName;
+    } panelRenderScope(*this, panelName);
+
     auto renderFrame = [&](bool markTime = false) {
+        FVP_INSTRUMENTS_SCOPED_TIMER("Render:Frame");
+
         HdTaskSharedPtrVector tasks = _taskController->GetRenderingTasks();
 
         // For playblasting, a glReadPixels is going to occur sometime after we return.
@@ -624,16 +651,20 @@ MStatus MtohRenderOverride::Render(
 
         if (scene.changed()) {
             if (_mayaHydraSceneIndex) {
+                FVP_INSTRUMENTS_SCOPED_TIMER("Render:SceneDelta");
                 _mayaHydraSceneIndex->HandleCompleteViewportScene(
                     scene, static_cast<MFrameContext::DisplayStyle>(drawContext.getDisplayStyle()));
             }
         }
 
         // Update plugin data producers
-        for (auto& viewportData : Fvp::ViewportInformationAndSceneIndicesPerViewportDataManager::Get().GetAllViewportInfoAndData()) {
-            for (auto& dataProducer : viewportData.GetDataProducerSceneIndicesData()) {
-                dataProducer->UpdateVisibility();
-                dataProducer->UpdateTransform();
+        {
+            FVP_INSTRUMENTS_SCOPED_TIMER("Render:DataProducersUpdate");
+            for (auto& viewportData : Fvp::ViewportInformationAndSceneIndicesPerViewportDataManager::Get().GetAllViewportInfoAndData()) {
+                for (auto& dataProducer : viewportData.GetDataProducerSceneIndicesData()) {
+                    dataProducer->UpdateVisibility();
+                    dataProducer->UpdateTransform();
+                }
             }
         }
 
@@ -650,10 +681,14 @@ MStatus MtohRenderOverride::Render(
             }
         }
         if (!rendererNamesToUpdate.empty()) {
-            Fvp::FilteringSceneIndicesChainManager::get().updateFilteringSceneIndicesChain(rendererNamesToUpdate);
+            FVP_INSTRUMENTS_SCOPED_TIMER("Render:FilteringChainUpdate");
+            Fvp::FilteringSceneIndicesChainManager::get().updateFilteringSceneIndicesVisibility(rendererNamesToUpdate);
         }
 
-        _engine.Execute(_renderIndex, &tasks);
+        {
+            FVP_INSTRUMENTS_SCOPED_TIMER("Render:Execute");
+            _engine.Execute(_renderIndex, &tasks);
+        }
 
         // HdTaskController will query all of the tasks it can for IsConverged.
         // This includes HdRenderPass::IsConverged and HdRenderBuffer::IsConverged (via colorizer).
@@ -685,12 +720,8 @@ MStatus MtohRenderOverride::Render(
 
     MFrameContext::LightingMode currentMayaLightingMode = MFrameContext::LightingMode::kSceneLights;
 
-    //This code with strings comparison will go away if we have multiple render proxies when doing multi viewports
-    MString panelName;
     std::string panelNameStr;
-    auto framecontext = getFrameContext();
     if (framecontext){
-        framecontext->renderingDestination(panelName);
         panelNameStr = std::string(panelName.asChar());
 
         TF_DEBUG(MAYAHYDRALIB_RENDEROVERRIDE_SCENE_INDEX_CHAIN_MGMT)
@@ -1033,6 +1064,12 @@ void MtohRenderOverride::_InitHydraResources(const MHWRender::MDrawContext& draw
     if (!_renderIndex)
         return;
     GetMayaHydraLibInterface().RegisterTerminalSceneIndex(_renderIndex->GetTerminalSceneIndex());
+    {
+        HdRenderIndex* renderIndex = _renderIndex;
+        _pickBoundsIndex = Fvp::PrimBoundsIndex::New(
+            _renderIndex->GetTerminalSceneIndex(),
+            [renderIndex](const TfToken& primType) { return renderIndex->IsRprimTypeSupported(primType); });
+    }
 
     _taskController = new HdxTaskController(
         _renderIndex,
@@ -1172,6 +1209,8 @@ void MtohRenderOverride::ClearHydraResources(bool fullReset)
         _taskController = nullptr;
     }
 
+    _pickBoundsIndex.Reset();
+
     if (_renderIndex != nullptr) {
         GetMayaHydraLibInterface().UnregisterTerminalSceneIndex(_renderIndex->GetTerminalSceneIndex());
 #ifndef CODE_COVERAGE_WORKAROUND
@@ -1287,6 +1326,9 @@ void MtohRenderOverride::_RemovePanel(MString panelName)
         Fvp::ViewportInformationAndSceneIndicesPerViewportDataManager::Get().RemoveViewportInformation(std::string(panelName.asChar()));
         _renderPanelCallbacks.erase(foundPanelCallbacks);
     }
+    _panelsRenderedInFrame.erase(
+        std::remove(_panelsRenderedInFrame.begin(), _panelsRenderedInFrame.end(), panelName),
+        _panelsRenderedInFrame.end());
 
     if (_renderPanelCallbacks.empty()) {
         constexpr bool fullReset = false;
@@ -1294,6 +1336,32 @@ void MtohRenderOverride::_RemovePanel(MString panelName)
     }
 }
 
+void MtohRenderOverride::_BeginPanelRender(const MString& panelName)
+{
+    // A panel rendering again means the previous Maya frame is complete, even
+    // if some of the other panels did not render it (e.g. hidden panels).
+    if (std::find(_panelsRenderedInFrame.begin(), _panelsRenderedInFrame.end(), panelName)
+        != _panelsRenderedInFrame.end()) {
+        Fvp::Instruments::instance().endFrame();
+        _panelsRenderedInFrame.clear();
+    }
+}
+
+void MtohRenderOverride::_EndPanelRender(const MString& panelName)
+{
+    // An instruments frame is a Maya frame : it is complete once every panel
+    // using this render override has rendered, not after each panel render.
+    _panelsRenderedInFrame.push_back(panelName);
+    for (const auto& panelCallbacks : _renderPanelCallbacks) {
+        if (std::find(_panelsRenderedInFrame.begin(), _panelsRenderedInFrame.end(), panelCallbacks.first)
+            == _panelsRenderedInFrame.end()) {
+            return;
+        }
+    }
+    Fvp::Instruments::instance().endFrame();
+    _panelsRenderedInFrame.clear();
+}
+
 void MtohRenderOverride::SelectionChanged(
     const Ufe::SelectionChanged& notification
 )
@@ -1473,19 +1541,39 @@ void MtohRenderOverride::_PopulateSelectionList(
 
     PickHandler::Output pickOutput(selectionList, worldSpaceHitPts, _ufeSn);
 
-    MStatus status;
+    // Batch the consecutive hits of the same pick handler, so that each pick
+    // handler resolves its hits together while the UFE and Maya selections
+    // are still appended to in pick order.
+    std::vector<std::pair<PickHandlerConstPtr, std::vector<const HdxPickHit*>>> batches;
     for (const HdxPickHit& hit : hits) {
-        PickHandler::Input pickInput(hit, selectInfo, hits.size() == 1u);
-
         auto pickHandler = _PickHandler(hit);
-        if (TF_VERIFY(pickHandler, "No pick handler found for pick hit %s!", hit.objectId.GetText())) {
-
-            if (pickHandler->inSingleNodeComponentsPick(hit)) {
-                isOneMayaNodeInComponentsPickingMode = true;
-                return;
-            }
+        if (!TF_VERIFY(pickHandler, "No pick handler found for pick hit %s!", hit.objectId.GetText())) {
+            continue;
+        }
 
-            pickHandler->handlePickHit(pickInput, pickOutput);
+        if (batches.empty() || batches.back().first != pickHandler) {
+            batches.emplace_back(pickHandler, std::vector<const HdxPickHit*>());
+        }
+        batches.back().second.push_back(&hit);
+    }
+
+    // The hits are handled up to the first one, in pick order, on a node in
+    // components picking mode.  Batches are in pick order, so the first
+    // batch which has such a hit is the last one handled.
+    for (auto& [pickHandler, batchHits] : batches) {
+        PickHandler::BatchInput componentsPickInput(batchHits, selectInfo, hits.size() == 1u);
+        const HdxPickHit* firstComponentsPickHit = pickHandler->findSingleNodeComponentsPickHit(componentsPickInput);
+        if (firstComponentsPickHit) {
+            isOneMayaNodeInComponentsPickingMode = true;
+            batchHits.erase(
+                std::find(batchHits.begin(), batchHits.end(), firstComponentsPickHit), batchHits.end());
+        }
+        if (!batchHits.empty()) {
+            PickHandler::BatchInput pickInput(batchHits, selectInfo, hits.size() == 1u);
+            pickHandler->handlePickHits(pickInput, pickOutput);
+        }
+        if (firstComponentsPickHit) {
+            break;
         }
     }
 }
@@ -1540,6 +1628,21 @@ void MtohRenderOverride::_PickByRegion(
     pickParams.collection = _renderCollection;
     pickParams.collection.SetExcludePaths(_wireframeSelectionHighlightSceneIndex->GetSelectionHighlightMirrorPaths());
     pickParams.outHits = &outHits;
+
+    // Only pick the prims whose bounds intersect the pick region frustum. The
+    // restricted collection makes the pick task gather its draw items again
+    // when the candidates change, so above Fvp::PrimBoundsIndex's maximum
+    // candidates ratio the unchanged full collection is picked instead.
+    SdfPathVector candidatePrims;
+    const bool    prefiltered = _pickBoundsIndex
+        && _pickBoundsIndex->GetCandidatePrims(
+            GfMatrix4d(viewMatrix.matrix) * GfMatrix4d(adjustedProjMatrix.matrix), candidatePrims);
+    if (prefiltered && candidatePrims.empty()) {
+        return;
+    }
+    if (prefiltered) {
+        pickParams.collection.SetRootPaths(candidatePrims);
+    }
     
     if (geomSubsetsPickMode == GeomSubsetsPickModeTokens->Faces) {
         pickParams.pickTarget = HdxPickTokens->pickFaces;
@@ -1554,6 +1657,9 @@ void MtohRenderOverride::_PickByRegion(
         auto selectionHighlightPaths = _wireframeSelectionHighlightSceneIndex->GetSelectionHighlightMirrorPaths();
         excludePaths.insert(excludePaths.end(), selectionHighlightPaths.begin(), selectionHighlightPaths.end());
         pickParams.collection.SetExcludePaths(excludePaths);
+        if (prefiltered) {
+            pickParams.collection.SetRootPaths(candidatePrims);
+        }
     }
 
     // Execute picking tasks.
@@ -1577,6 +1683,8 @@ bool MtohRenderOverride::select(
         "MtohRenderOverride::select",
         "MtohRenderOverride::select");
 #endif
+    FVP_INSTRUMENTS_SCOPED_TIMER("Render:Picking");
+
     /*
     * There are 2 modes of selection picking for components in maya :
     * 1) You can be in components picking mode, this setting is global.This is detected in the function "isInComponentsPickingMode(selectInfo)"
@@ -53,6 +53,7 @@
 #include <flowViewport/sceneIndex/fvpBlockPrimRemovalPropagationSceneIndex.h>
 #include <flowViewport/sceneIndex/fvpWireframeSelectionHighlightSceneIndex.h>
 #include <flowViewport/sceneIndex/fvpLightsManagementSceneIndex.h>
+#include <flowViewport/sceneIndex/fvpPrimBoundsIndex.h>
 
 #include <pxr/base/tf/singleton.h>
 #include <pxr/imaging/hd/driver.h>
@@ -168,6 +169,8 @@ private:
 
     void              _InitHydraResources(const MHWRender::MDrawContext& drawContext);
     void              _RemovePanel(MString panelName);
+    void              _BeginPanelRender(const MString& panelName);
+    void              _EndPanelRender(const MString& panelName);
     void              _DetectMayaDefaultLighting(const MHWRender::MDrawContext& drawContext);
     HdRenderDelegate* _GetRenderDelegate();   
     void              _ClearMayaHydraSceneIndex();
@@ -246,6 +249,8 @@ private:
     MCallbackIdArray                             _callbacks;
     MCallbackId                                  _timerCallback = 0;
     PanelCallbacksList                           _renderPanelCallbacks;
+    // Panels rendered since the last completed instruments frame.
+    std::vector<MString>                         _panelsRenderedInFrame;
     const MtohRenderGlobals&                     _globals;
 
 #ifdef MAYA_HAS_VIEW_SELECTED_OBJECT_API
@@ -281,6 +286,8 @@ private:
     Fvp::WireframeSelectionHighlightSceneIndexRefPtr  _wireframeSelectionHighlightSceneIndex;
     Fvp::BlockPrimRemovalPropagationSceneIndexRefPtr  _blockPrimRemovalPropagationSceneIndex;
     Fvp::LightsManagementSceneIndexRefPtr _lightsManagementSceneIndex;
+    // Bounds of the render index prims, to pre-filter region picking.
+    Fvp::PrimBoundsIndexRefPtr            _pickBoundsIndex;
 
     // Naming this identifier _ufeSelection clashes with UFE's selection.h
     // include guard and produces
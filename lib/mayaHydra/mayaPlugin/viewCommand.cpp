@@ -24,6 +24,8 @@
 #include <mayaHydraLib/mayaHydra.h>
 #include <mayaHydraLib/mixedUtils.h>
 
+#include <flowViewport/fvpInstruments.h>
+
 #include <maya/MArgDatabase.h>
 #include <maya/MGlobal.h>
 #include <maya/MSyntax.h>
@@ -74,6 +76,18 @@ constexpr auto _visibleOnlyLong = "-visibleOnly";
 constexpr auto _sceneDelegateId = "-sid";
 constexpr auto _sceneDelegateIdLong = "-sceneDelegateId";
 
+constexpr auto _instrumentsReport = "-ir";
+constexpr auto _instrumentsReportLong = "-instrumentsReport";
+
+constexpr auto _instrumentsTracing = "-it";
+constexpr auto _instrumentsTracingLong = "-instrumentsTracing";
+
+constexpr auto _instrumentsTraceFile = "-itf";
+constexpr auto _instrumentsTraceFileLong = "-instrumentsTraceFile";
+
+constexpr auto _instrumentsCounter = "-ic";
+constexpr auto _instrumentsCounterLong = "-instrumentsCounter";
+
 // Versioning and build information.
 constexpr auto _majorVersion = "-mjv";
 constexpr auto _minorVersion = "-mnv";
@@ -138,6 +152,14 @@ MSyntax MtohViewCmd::createSyntax()
 
     syntax.addFlag(_sceneDelegateId, _sceneDelegateIdLong, MSyntax::kString);
 
+    syntax.addFlag(_instrumentsReport, _instrumentsReportLong);
+
+    syntax.addFlag(_instrumentsTracing, _instrumentsTracingLong, MSyntax::kBoolean);
+
+    syntax.addFlag(_instrumentsTraceFile, _instrumentsTraceFileLong, MSyntax::kString);
+
+    syntax.addFlag(_instrumentsCounter, _instrumentsCounterLong, MSyntax::kString);
+
     // Versioning and build information flags.
 
     syntax.addFlag(_majorVersion, _majorVersionLong);
@@ -254,6 +276,28 @@ MStatus MtohViewCmd::doIt(const MArgList& args)
         SdfPath delegateId = MtohRenderOverride::RendererSceneDelegateId(
             renderDelegateName, TfToken(sceneDelegateName.asChar()));
         setResult(MString(delegateId.GetText()));
+    } else if (db.isFlagSet(_instrumentsReport)) {
+        setResult(MString(Fvp::Instruments::instance().report().c_str()));
+    } else if (db.isFlagSet(_instrumentsTracing)) {
+        bool enable = false;
+        CHECK_MSTATUS_AND_RETURN_IT(db.getFlagArgument(_instrumentsTracing, 0, enable));
+        Fvp::Instruments::instance().setTracing(enable);
+    } else if (db.isFlagSet(_instrumentsTraceFile)) {
+        MString filePath;
+        CHECK_MSTATUS_AND_RETURN_IT(db.getFlagArgument(_instrumentsTraceFile, 0, filePath));
+        setResult(Fvp::Instruments::instance().writeChromeTrace(filePath.asChar()));
+    } else if (db.isFlagSet(_instrumentsCounter)) {
+        MString counterName;
+        CHECK_MSTATUS_AND_RETURN_IT(db.getFlagArgument(_instrumentsCounter, 0, counterName));
+        // Value of the last completed frame, 0 for counters not updated yet.
+        const auto* counter = Fvp::Instruments::instance().findCounter(counterName.asChar());
+        const int64_t frameValue = counter ? counter->frameValue(0) : 0;
+        if (counter && counter->unit() == Fvp::Instruments::Counter::Unit::Nanoseconds) {
+            // Times are in ms, as in the report.
+            setResult(frameValue * 1e-6);
+        } else {
+            setResult(int(frameValue));
+        }
     } else if (db.isFlagSet(_majorVersion)) {
         setResult(MAYAHYDRA_MAJOR_VERSION);
     } else if (db.isFlagSet(_minorVersion)) {
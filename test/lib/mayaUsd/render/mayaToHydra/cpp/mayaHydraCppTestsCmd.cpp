@@ -26,6 +26,8 @@
 
 #include <gtest/gtest.h>
 
+#include <string>
+
 namespace 
 {
 constexpr auto _filter = "-f";
@@ -148,7 +150,21 @@ MStatus mayaHydraInstruments::doIt( const MArgList& args )
         return MS::kFailure;
     }
 
-    auto value = Fvp::Instruments::instance().get(instruments[0].asChar());
+    const std::string name = instruments[0].asChar();
+    auto value = Fvp::Instruments::instance().get(name);
+
+    // Counters are queried for the last completed frame, times being in ms.
+    if (value.IsEmpty()) {
+        if (const auto* counter = Fvp::Instruments::instance().findCounter(name)) {
+            const int64_t frameValue = counter->frameValue(0);
+            if (counter->unit() == Fvp::Instruments::Counter::Unit::Nanoseconds) {
+                setResult(frameValue * 1e-6);
+            } else {
+                setResult(int(frameValue));
+            }
+            return MS::kSuccess;
+        }
+    }
     
     if (value.IsEmpty()) {
         displayError("Queried instrument has no value.");
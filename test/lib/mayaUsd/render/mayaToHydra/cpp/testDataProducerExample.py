@@ -135,6 +135,41 @@ class TestDataProducerExample(mtohUtils.MayaHydraBaseTestCase):
         cmds.redo()
         assertTranslationAlmostEqual([3, 4, 5])
 
+    def test_ParentDrivenVisibility(self):
+        # Drive the parent visibility with an expression : no UFE notification
+        # is sent when the driver changes, the data producer must still follow.
+        driver = cmds.createNode('transform', name='visibilityDriver')
+        cmds.expression(s='transform1.visibility = ' + driver + '.translateX < 1;')
+        cmds.refresh()
+        cmds.mayaHydraCppTest(self.cube222PathString(), f='TestHydraPrim.isFound')
+
+        cmds.setAttr(driver + '.translateX', 2)
+        cmds.refresh()
+        cmds.mayaHydraCppTest(self.cube222PathString(), f='TestHydraPrim.isNotFound')
+
+        cmds.setAttr(driver + '.translateX', 0)
+        cmds.refresh()
+        cmds.mayaHydraCppTest(self.cube222PathString(), f='TestHydraPrim.isFound')
+
+    def test_ParentDrivenMove(self):
+        # Drive the parent translation with a connection : moving the driver
+        # sends no UFE notification for the data producer, which must still
+        # follow its parent.
+        driver = cmds.createNode('transform', name='translateDriver')
+        cmds.connectAttr(driver + '.translate', 'transform1.translate')
+
+        def assertTranslationAlmostEqual(expected):
+            cmds.refresh()
+            cmds.mayaHydraCppTest(self.cube000PathString(), str(expected[0]),
+                                  str(expected[1]), str(expected[2]),
+                                  f='TestHydraPrim.translation')
+
+        assertTranslationAlmostEqual([0, 0, 0])
+        cmds.setAttr(driver + '.translate', 3, 4, 5)
+        assertTranslationAlmostEqual([3, 4, 5])
+        cmds.setAttr(driver + '.translate', -1, 2, 0)
+        assertTranslationAlmostEqual([-1, 2, 0])
+
     def test_SelectPrototype(self):
         # Enable instancing
         cmds.setAttr(self._locator + '.cubesUseInstancing', True)
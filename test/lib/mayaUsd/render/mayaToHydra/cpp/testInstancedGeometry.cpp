@@ -0,0 +1,189 @@
+// Copyright 2024 Autodesk
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include "testUtils.h"
+
+#include <mayaHydraLib/sceneIndex/mayaHydraSceneIndex.h>
+
+#include <flowViewport/fvpInstruments.h>
+#include <flowViewport/sceneIndex/fvpMergingSceneIndex.h>
+
+#include <pxr/imaging/hd/perfLog.h>
+#include <pxr/imaging/hd/renderDelegate.h>
+#include <pxr/imaging/hd/selectionsSchema.h>
+#include <pxr/imaging/hd/tokens.h>
+
+#include <maya/MGlobal.h>
+#include <maya/MSelectionList.h>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <iostream>
+#include <string>
+
+PXR_NAMESPACE_USING_DIRECTIVE
+using namespace MayaHydra;
+
+namespace {
+
+const std::string kNbRenderItemBytesCopied = "MayaHydraSceneIndex:NbRenderItemBytesCopied";
+const std::string kNbSharedRenderItemGeometries = "MayaHydraSceneIndex:NbSharedRenderItemGeometries";
+
+MayaHydraSceneIndexRefPtr getMayaSceneIndex()
+{
+    const auto& sceneIndices = GetTerminalSceneIndices();
+    if (sceneIndices.empty()) {
+        return {};
+    }
+    auto mergingSi = TfDynamic_cast<Fvp::MergingSceneIndexRefPtr>(findSceneIndexInTree(
+        sceneIndices.front(), SceneIndexDisplayNamePred("Flow Viewport Merging Scene Index")));
+    if (!mergingSi) {
+        return {};
+    }
+    auto producers = mergingSi->GetInputScenes();
+    auto found = std::find_if(
+        producers.begin(), producers.end(), SceneIndexDisplayNamePred("MayaHydraSceneIndex"));
+    return (found == producers.end()) ? MayaHydraSceneIndexRefPtr()
+                                      : TfDynamic_cast<MayaHydraSceneIndexRefPtr>(*found);
+}
+
+int64_t lastFrameValue(const std::string& counterName)
+{
+    const auto* counter = Fvp::Instruments::instance().findCounter(counterName);
+    return counter ? counter->frameValue(0) : 0;
+}
+
+size_t gpuMemoryUsed(const MayaHydraSceneIndexRefPtr& mayaSi)
+{
+    const VtDictionary stats = mayaSi->GetRenderIndex().GetRenderDelegate()->GetRenderStats();
+    const auto         found = stats.find(HdPerfTokens->gpuMemoryUsed.GetString());
+    return (found == stats.end()) ? 0 : found->second.GetWithDefault<size_t>(0);
+}
+
+// Mesh prims of the render items of an instance, identified by the name of its
+// top-level transform.
+PrimEntriesVector instanceMeshPrims(const std::string& instanceName)
+{
+    SceneIndexInspector inspector(GetTerminalSceneIndices().front());
+    return inspector.FindPrims(
+        [instanceName](const HdSceneIndexBaseRefPtr& sceneIndex, const SdfPath& primPath) -> bool {
+            return primPath.GetAsString().find(instanceName) != std::string::npos
+                && sceneIndex->GetPrim(primPath).primType == HdPrimTypeTokens->mesh;
+        });
+}
+
+bool isSelected(const PrimEntriesVector& primEntries)
+{
+    return std::any_of(primEntries.begin(), primEntries.end(), [](const PrimEntry& primEntry) {
+        return HdSelectionsSchema::GetFromParent(primEntry.prim.dataSource).GetNumElements() > 0u;
+    });
+}
+
+bool isVisible(const PrimEntriesVector& primEntries)
+{
+    return std::any_of(primEntries.begin(), primEntries.end(), [](const PrimEntry& primEntry) {
+        return visibility(GetTerminalSceneIndices().front(), primEntry.primPath);
+    });
+}
+
+} // namespace
+
+// Instanced spheres, see testInstancedGeometry.py : compare the bytes copied
+// and the GPU memory used when all the instances change, with and without
+// sharing the geometry of the instances.
+TEST(InstancedGeometry, gpuMemory)
+{
+    auto mayaSi = getMayaSceneIndex();
+    ASSERT_TRUE(mayaSi);
+    const bool wasSharing = MayaHydraSceneIndex::shareInstancedGeometry();
+
+    struct Measure
+    {
+        int64_t nbBytesCopied = 0;
+        int64_t nbShared = 0;
+        size_t  gpuMemoryUsed = 0;
+    };
+    auto measure = [&mayaSi](bool share, int subdivisions) {
+        MayaHydraSceneIndex::setShareInstancedGeometry(share);
+        MGlobal::executeCommand(
+            MString("setAttr sphereSource.subdivisionsAxis ") + subdivisions + "; refresh -f;");
+        Measure result { lastFrameValue(kNbRenderItemBytesCopied),
+                         lastFrameValue(kNbSharedRenderItemGeometries) };
+        // Let Storm release the buffers of the previous geometry.
+        MGlobal::executeCommand("refresh -f;");
+        result.gpuMemoryUsed = gpuMemoryUsed(mayaSi);
+        return result;
+    };
+
+    // Same geometry in both runs.
+    measure(false, 30);
+    const Measure unshared = measure(false, 40);
+    measure(true, 30);
+    const Measure shared = measure(true, 40);
+    MayaHydraSceneIndex::setShareInstancedGeometry(wasSharing);
+
+    std::cout << "Instanced geometry, unshared : " << unshared.nbBytesCopied << " bytes copied, "
+              << unshared.gpuMemoryUsed << " bytes of GPU memory" << std::endl;
+    std::cout << "Instanced geometry, shared   : " << shared.nbBytesCopied << " bytes copied, "
+              << shared.gpuMemoryUsed << " bytes of GPU memory, " << shared.nbShared
+              << " shared render items" << std::endl;
+
+    EXPECT_EQ(unshared.nbShared, 0);
+    EXPECT_GT(shared.nbShared, 0);
+    EXPECT_LT(shared.nbBytesCopied, unshared.nbBytesCopied);
+    // Storm shares identical buffers by content : sharing the arrays saves the
+    // CPU copies, and must not use more GPU memory.
+    EXPECT_LE(shared.gpuMemoryUsed, unshared.gpuMemoryUsed + unshared.gpuMemoryUsed / 20);
+}
+
+// Two instances of a cube, instB with its own material, see testInstancedGeometry.py.
+TEST(InstancedGeometry, instancesSelectHideAndMaterials)
+{
+    auto mayaSi = getMayaSceneIndex();
+    ASSERT_TRUE(mayaSi);
+    ASSERT_FALSE(instanceMeshPrims("instA").empty());
+    ASSERT_FALSE(instanceMeshPrims("instB").empty());
+
+    // Each instance is selected on its own.
+    MGlobal::executeCommand("select -r instB; refresh -f;");
+    EXPECT_TRUE(isSelected(instanceMeshPrims("instB")));
+    EXPECT_FALSE(isSelected(instanceMeshPrims("instA")));
+    MGlobal::executeCommand("select -r instA; refresh -f;");
+    EXPECT_TRUE(isSelected(instanceMeshPrims("instA")));
+    EXPECT_FALSE(isSelected(instanceMeshPrims("instB")));
+    MGlobal::executeCommand("select -cl; refresh -f;");
+
+    // Each instance has its own material.
+    MSelectionList sel;
+    sel.add("matBSG");
+    MObject shadingEngine;
+    sel.getDependNode(0, shadingEngine);
+    const auto matBUsers = mayaSi->GetMaterialUsers(mayaSi->GetMaterialPath(shadingEngine));
+    auto usedBy = [&matBUsers](const std::string& instanceName) {
+        return std::any_of(matBUsers.begin(), matBUsers.end(), [&instanceName](const SdfPath& p) {
+            return p.GetAsString().find(instanceName) != std::string::npos;
+        });
+    };
+    EXPECT_TRUE(usedBy("instB"));
+    EXPECT_FALSE(usedBy("instA"));
+
+    // Each instance is hidden on its own.
+    MGlobal::executeCommand("setAttr instB.visibility 0; refresh -f;");
+    EXPECT_FALSE(isVisible(instanceMeshPrims("instB")));
+    EXPECT_TRUE(isVisible(instanceMeshPrims("instA")));
+    MGlobal::executeCommand("setAttr instB.visibility 1; refresh -f;");
+    EXPECT_TRUE(isVisible(instanceMeshPrims("instB")));
+}
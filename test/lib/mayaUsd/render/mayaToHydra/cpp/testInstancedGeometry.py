@@ -0,0 +1,55 @@
+# Copyright 2024 Autodesk
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+import maya.cmds as cmds
+import fixturesUtils
+import mtohUtils
+from testUtils import PluginLoaded
+
+class TestInstancedGeometry(mtohUtils.MayaHydraBaseTestCase):
+    # MayaHydraBaseTestCase.setUpClass requirement.
+    _file = __file__
+
+    NB_INSTANCES = 100
+
+    def test_GpuMemory(self):
+        self.setHdStormRenderer()
+        sphere, source = cmds.polySphere(subdivisionsAxis=30, subdivisionsHeight=30)
+        cmds.rename(source, "sphereSource")
+        for i in range(self.NB_INSTANCES):
+            instance = cmds.instance(sphere)[0]
+            cmds.move(i % 10 * 2, 0, i // 10 * 2, instance)
+        cmds.refresh()
+        with PluginLoaded('mayaHydraCppTests'):
+            cmds.mayaHydraCppTest(f="InstancedGeometry.gpuMemory")
+
+    def test_InstancesSelectHideAndMaterials(self):
+        self.setHdStormRenderer()
+        cube = cmds.polyCube(name="protoCube")[0]
+        cmds.group(cube, name="instA")
+        cmds.instance("instA", name="instB")
+        cmds.move(3, 0, 0, "instB")
+
+        shader = cmds.shadingNode("lambert", asShader=True, name="matB")
+        shadingEngine = cmds.sets(renderable=True, noSurfaceShader=True, empty=True, name="matBSG")
+        cmds.connectAttr(shader + ".outColor", shadingEngine + ".surfaceShader")
+        # Per-instance assignment.
+        cmds.sets("instB|protoCube|protoCubeShape", edit=True, forceElement="matBSG")
+        cmds.select(clear=True)
+        cmds.refresh()
+        with PluginLoaded('mayaHydraCppTests'):
+            cmds.mayaHydraCppTest(f="InstancedGeometry.instancesSelectHideAndMaterials")
+
+if __name__ == '__main__':
+    fixturesUtils.runTests(globals())
@@ -0,0 +1,61 @@
+// Copyright 2024 Autodesk
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include "testUtils.h"
+
+#include <pxr/imaging/hd/light.h>
+#include <pxr/imaging/hd/lightSchema.h>
+#include <pxr/imaging/hd/tokens.h>
+
+#include <gtest/gtest.h>
+
+#include <string>
+
+PXR_NAMESPACE_USING_DIRECTIVE
+using namespace MayaHydra;
+
+namespace {
+
+// The lights management scene index disables a light by zeroing its diffuse
+// contribution.
+bool isLightEnabled(const HdSceneIndexPrim& prim)
+{
+    auto diffuse = HdTypedSampledDataSource<float>::Cast(HdContainerDataSource::Get(
+        prim.dataSource, HdLightSchema::GetDefaultLocator().Append(HdLightTokens->diffuse)));
+    return !diffuse || diffuse->GetTypedValue(0.0f) != 0.0f;
+}
+
+} // namespace
+
+TEST(LightsManagement, lightEnabled)
+{
+    const auto& sceneIndices = GetTerminalSceneIndices();
+    ASSERT_GT(sceneIndices.size(), 0u);
+    SceneIndexInspector inspector(sceneIndices.front());
+
+    auto [argc, argv] = getTestingArgs();
+    ASSERT_EQ(argc, 2);
+    const std::string lightName(argv[0]);
+    const bool        expectedEnabled = (std::string(argv[1]) == "1");
+
+    auto lights = inspector.FindPrims(
+        [&lightName](const HdSceneIndexBasePtr& sceneIndex, const SdfPath& primPath) {
+            return primPath.GetName() == lightName
+                && HdPrimTypeIsLight(sceneIndex->GetPrim(primPath).primType);
+        },
+        1);
+    ASSERT_EQ(lights.size(), 1u);
+    ASSERT_EQ(isLightEnabled(lights.front().prim), expectedEnabled);
+}
@@ -0,0 +1,62 @@
+# Copyright 2024 Autodesk
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+import maya.cmds as cmds
+import fixturesUtils
+import mtohUtils
+from testUtils import PluginLoaded
+
+class TestLightsManagement(mtohUtils.MayaHydraBaseTestCase):
+    # MayaHydraBaseTestCase.setUpClass requirement.
+    _file = __file__
+
+    def assertLightEnabled(self, lightName, enabled):
+        cmds.refresh()
+        cmds.mayaHydraCppTest(lightName, "1" if enabled else "0",
+                              f="LightsManagement.lightEnabled")
+
+    def test_SelectedLightsOnly(self):
+        self.setHdStormRenderer()
+        cmds.polyCube()
+        lightShape = cmds.pointLight()
+        lightTransform = cmds.listRelatives(lightShape, parent=True)[0]
+        cmds.modelEditor('modelPanel4', edit=True, displayLights='active')
+        cmds.select(clear=True)
+
+        with PluginLoaded('mayaHydraCppTests'):
+            # Select, deselect.
+            self.assertLightEnabled(lightShape, False)
+            cmds.select(lightTransform, replace=True)
+            self.assertLightEnabled(lightShape, True)
+            cmds.select(clear=True)
+            self.assertLightEnabled(lightShape, False)
+
+            # Renaming and reparenting the selected light change its scene
+            # index path : it must stay enabled at its new path.
+            cmds.select(lightTransform, replace=True)
+            self.assertLightEnabled(lightShape, True)
+            lightTransform = cmds.rename(lightTransform, "renamedLight")
+            self.assertLightEnabled(lightShape, True)
+            group = cmds.group(empty=True, name="lightGroup")
+            cmds.parent(lightTransform, group)
+            cmds.select(group + "|" + lightTransform, replace=True)
+            self.assertLightEnabled(lightShape, True)
+
+            cmds.select(clear=True)
+            self.assertLightEnabled(lightShape, False)
+
+        cmds.modelEditor('modelPanel4', edit=True, displayLights='default')
+
+if __name__ == '__main__':
+    fixturesUtils.runTests(globals())
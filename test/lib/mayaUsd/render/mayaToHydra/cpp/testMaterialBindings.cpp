@@ -0,0 +1,143 @@
+// Copyright 2024 Autodesk
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include "testUtils.h"
+
+#include <mayaHydraLib/sceneIndex/mayaHydraSceneIndex.h>
+
+#include <flowViewport/sceneIndex/fvpMergingSceneIndex.h>
+
+#include <pxr/imaging/hd/materialBindingsSchema.h>
+
+#include <maya/MGlobal.h>
+#include <maya/MSelectionList.h>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <string>
+
+PXR_NAMESPACE_USING_DIRECTIVE
+
+namespace {
+
+MayaHydraSceneIndexRefPtr getMayaSceneIndex()
+{
+    const auto& sceneIndices = GetTerminalSceneIndices();
+    if (sceneIndices.empty()) {
+        return {};
+    }
+    auto mergingSi = TfDynamic_cast<Fvp::MergingSceneIndexRefPtr>(findSceneIndexInTree(
+        sceneIndices.front(), SceneIndexDisplayNamePred("Flow Viewport Merging Scene Index")));
+    if (!mergingSi) {
+        return {};
+    }
+    auto producers = mergingSi->GetInputScenes();
+    auto found = std::find_if(
+        producers.begin(), producers.end(), SceneIndexDisplayNamePred("MayaHydraSceneIndex"));
+    return (found == producers.end()) ? MayaHydraSceneIndexRefPtr()
+                                      : TfDynamic_cast<MayaHydraSceneIndexRefPtr>(*found);
+}
+
+SdfPath materialPath(const MayaHydraSceneIndexRefPtr& mayaSi, const char* shadingEngineName)
+{
+    MSelectionList sel;
+    sel.add(shadingEngineName);
+    MObject shadingEngine;
+    sel.getDependNode(0, shadingEngine);
+    return mayaSi->GetMaterialPath(shadingEngine);
+}
+
+// Number of users of the material coming from the given Maya object.
+size_t nbUsersFrom(
+    const MayaHydraSceneIndexRefPtr& mayaSi,
+    const SdfPath&                   material,
+    const std::string&               objectName)
+{
+    size_t nbUsers = 0;
+    for (const auto& user : mayaSi->GetMaterialUsers(material)) {
+        if (user.GetString().find(objectName) != std::string::npos) {
+            ++nbUsers;
+        }
+    }
+    return nbUsers;
+}
+
+// Whether the material binding of a prim coming from the given Maya object was dirtied.
+bool materialBindingDirtied(
+    SceneIndexNotificationsAccumulator& notifsAccumulator,
+    const std::string&                  objectName)
+{
+    for (const auto& entry : notifsAccumulator.GetDirtiedPrimEntries()) {
+        if (entry.primPath.GetString().find(objectName) != std::string::npos
+            && entry.dirtyLocators.Intersects(HdMaterialBindingsSchema::GetDefaultLocator())) {
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace
+
+// Both cubes are initially bound to matASG, see testMaterialBindings.py.
+TEST(MaterialBindings, reassignUnassignDelete)
+{
+    auto mayaSi = getMayaSceneIndex();
+    ASSERT_TRUE(mayaSi);
+    const SdfPath matA = materialPath(mayaSi, "matASG");
+    const SdfPath matB = materialPath(mayaSi, "matBSG");
+    ASSERT_FALSE(matA.IsEmpty());
+    ASSERT_FALSE(matB.IsEmpty());
+
+    EXPECT_GT(nbUsersFrom(mayaSi, matA, "cubeA"), 0u);
+    EXPECT_GT(nbUsersFrom(mayaSi, matA, "cubeB"), 0u);
+    EXPECT_TRUE(mayaSi->GetMaterialUsers(matB).empty());
+
+    // Reassign : only the reassigned cube is dirtied, and it moves from one
+    // material to the other.
+    {
+        SceneIndexNotificationsAccumulator notifsAccumulator(GetTerminalSceneIndices().front());
+        MGlobal::executeCommand("sets -e -forceElement matBSG cubeA; refresh -f;");
+        EXPECT_TRUE(materialBindingDirtied(notifsAccumulator, "cubeA"));
+        EXPECT_FALSE(materialBindingDirtied(notifsAccumulator, "cubeB"));
+    }
+    EXPECT_EQ(nbUsersFrom(mayaSi, matA, "cubeA"), 0u);
+    EXPECT_GT(nbUsersFrom(mayaSi, matA, "cubeB"), 0u);
+    EXPECT_GT(nbUsersFrom(mayaSi, matB, "cubeA"), 0u);
+
+    // Unassign : the cube no longer uses the material.
+    {
+        SceneIndexNotificationsAccumulator notifsAccumulator(GetTerminalSceneIndices().front());
+        MGlobal::executeCommand("sets -e -remove matBSG cubeAShape; refresh -f;");
+        EXPECT_TRUE(materialBindingDirtied(notifsAccumulator, "cubeA"));
+        EXPECT_FALSE(materialBindingDirtied(notifsAccumulator, "cubeB"));
+    }
+    EXPECT_TRUE(mayaSi->GetMaterialUsers(matB).empty());
+
+    // Delete : the users of the deleted material are dirtied, and nothing is
+    // bound to it anymore.
+    {
+        SceneIndexNotificationsAccumulator notifsAccumulator(GetTerminalSceneIndices().front());
+        MGlobal::executeCommand("delete matASG; refresh -f;");
+        EXPECT_TRUE(materialBindingDirtied(notifsAccumulator, "cubeB"));
+    }
+    EXPECT_TRUE(mayaSi->GetMaterialUsers(matA).empty());
+
+    // Deleting the cubes leaves no binding behind.
+    MGlobal::executeCommand("sets -e -forceElement matBSG cubeA cubeB; refresh -f;");
+    EXPECT_GT(nbUsersFrom(mayaSi, matB, "cubeB"), 0u);
+    MGlobal::executeCommand("delete cubeA cubeB; refresh -f;");
+    EXPECT_TRUE(mayaSi->GetMaterialUsers(matB).empty());
+}
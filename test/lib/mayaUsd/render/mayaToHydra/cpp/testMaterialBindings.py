@@ -0,0 +1,43 @@
+# Copyright 2024 Autodesk
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+import maya.cmds as cmds
+import fixturesUtils
+import mtohUtils
+from testUtils import PluginLoaded
+
+class TestMaterialBindings(mtohUtils.MayaHydraBaseTestCase):
+    # MayaHydraBaseTestCase.setUpClass requirement.
+    _file = __file__
+
+    def setupScene(self):
+        self.setHdStormRenderer()
+        cmds.polyCube(name="cubeA")
+        cmds.polyCube(name="cubeB")
+        cmds.move(2, 0, 0, "cubeB")
+        for name in ["matA", "matB"]:
+            shader = cmds.shadingNode("lambert", asShader=True, name=name)
+            shadingEngine = cmds.sets(renderable=True, noSurfaceShader=True, empty=True, name=name + "SG")
+            cmds.connectAttr(shader + ".outColor", shadingEngine + ".surfaceShader")
+        cmds.sets("cubeA", "cubeB", edit=True, forceElement="matASG")
+        cmds.select(clear=True)
+        cmds.refresh()
+
+    def test_ReassignUnassignDelete(self):
+        self.setupScene()
+        with PluginLoaded('mayaHydraCppTests'):
+            cmds.mayaHydraCppTest(f="MaterialBindings.reassignUnassignDelete")
+
+if __name__ == '__main__':
+    fixturesUtils.runTests(globals())
@@ -15,6 +15,7 @@
 
 #include "testUtils.h"
 
+#include <pxr/imaging/hd/primvarsSchema.h>
 #include <pxr/imaging/hd/tokens.h>
 #include <pxr/imaging/hd/xformSchema.h>
 
@@ -22,10 +23,45 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+
 PXR_NAMESPACE_USING_DIRECTIVE
 
 namespace {
 const std::string kCubeName = "testCube";
+
+SdfPath findCubeMeshPrim(const HdSceneIndexBaseRefPtr& sceneIndex)
+{
+    SceneIndexInspector inspector(sceneIndex);
+    PrimEntriesVector   primEntries = inspector.FindPrims(
+        [](const HdSceneIndexBaseRefPtr& sceneIndex, const SdfPath& primPath) -> bool {
+            return primPath.GetName() == kCubeName + "Shape"
+                && sceneIndex->GetPrim(primPath).primType == HdPrimTypeTokens->mesh;
+        },
+        1);
+    return primEntries.empty() ? SdfPath() : primEntries.front().primPath;
+}
+
+double translateX(const HdSceneIndexBaseRefPtr& sceneIndex, const SdfPath& primPath)
+{
+    auto matrix = HdXformSchema::GetFromParent(sceneIndex->GetPrim(primPath).dataSource).GetMatrix();
+    return matrix ? matrix->GetTypedValue(0.0f).ExtractTranslation()[0] : 0.0;
+}
+
+float maxPointX(const HdSceneIndexBaseRefPtr& sceneIndex, const SdfPath& primPath)
+{
+    auto primvar = HdPrimvarsSchema::GetFromParent(sceneIndex->GetPrim(primPath).dataSource)
+                       .GetPrimvar(HdTokens->points);
+    auto value = primvar.GetPrimvarValue();
+    if (!value) {
+        return 0.0f;
+    }
+    float maxX = 0.0f;
+    for (const auto& point : value->GetValue(0.0f).GetWithDefault<VtVec3fArray>()) {
+        maxX = std::max(maxX, point[0]);
+    }
+    return maxX;
+}
 } // namespace
 
 TEST(MeshAdapterTransform, testDirtying)
@@ -54,3 +90,29 @@ TEST(MeshAdapterTransform, testDirtying)
     }
     EXPECT_TRUE(cubeXformWasDirtied);
 }
+
+TEST(MeshAdapterTransform, testCachedDataSourcesRebuilt)
+{
+    const SceneIndicesVector& sceneIndices = GetTerminalSceneIndices();
+    ASSERT_GT(sceneIndices.size(), 0u);
+    const auto&   sceneIndex = sceneIndices.front();
+    const SdfPath cubePath = findCubeMeshPrim(sceneIndex);
+    ASSERT_FALSE(cubePath.IsEmpty());
+
+    // Each query caches the data sources of the prim : after an attribute
+    // edit, the next query must return the new value.
+    for (int x = 1; x <= 3; ++x) {
+        translateX(sceneIndex, cubePath);
+        MGlobal::executeCommand(MString("setAttr ") + kCubeName.c_str() + ".translateX " + x);
+        EXPECT_DOUBLE_EQ(translateX(sceneIndex, cubePath), x);
+    }
+
+    // Same for the points, which are cached separately from the other primvars.
+    for (int width = 2; width <= 4; ++width) {
+        maxPointX(sceneIndex, cubePath);
+        MGlobal::executeCommand(
+            MString("string $history[] = `listHistory -type polyCube ") + kCubeName.c_str()
+            + "`; setAttr ($history[0] + \".width\") " + width + "; refresh -f;");
+        EXPECT_FLOAT_EQ(maxPointX(sceneIndex, cubePath), width * 0.5f);
+    }
+}
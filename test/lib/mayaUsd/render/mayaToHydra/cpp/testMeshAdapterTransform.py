@@ -31,5 +31,10 @@ class TestMeshAdapterTransform(mtohUtils.MayaHydraBaseTestCase):
         with PluginLoaded('mayaHydraCppTests'):
             cmds.mayaHydraCppTest(f="MeshAdapterTransform.testDirtying")
 
+    def test_CachedDataSourcesRebuilt(self):
+        self.setupScene()
+        with PluginLoaded('mayaHydraCppTests'):
+            cmds.mayaHydraCppTest(f="MeshAdapterTransform.testCachedDataSourcesRebuilt")
+
 if __name__ == '__main__':
     fixturesUtils.runTests(globals())
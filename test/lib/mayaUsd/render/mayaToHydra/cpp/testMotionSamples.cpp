@@ -0,0 +1,85 @@
+// Copyright 2024 Autodesk
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include "testUtils.h"
+
+#include <pxr/imaging/hd/tokens.h>
+#include <pxr/imaging/hd/xformSchema.h>
+
+#include <maya/MGlobal.h>
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+PXR_NAMESPACE_USING_DIRECTIVE
+
+namespace {
+
+// Shutter interval set in the Python driver of this test.
+constexpr float kShutterOpen = -1.0f;
+constexpr float kShutterClose = 1.0f;
+
+HdMatrixDataSourceHandle findMatrixDataSource(const std::string& shapeName)
+{
+    const SceneIndicesVector& sceneIndices = GetTerminalSceneIndices();
+    if (sceneIndices.empty()) {
+        return {};
+    }
+    SceneIndexInspector inspector(sceneIndices.front());
+    PrimEntriesVector   primEntries = inspector.FindPrims(
+        [shapeName](const HdSceneIndexBaseRefPtr& sceneIndex, const SdfPath& primPath) -> bool {
+            return primPath.GetName() == shapeName
+                && sceneIndex->GetPrim(primPath).primType == HdPrimTypeTokens->mesh;
+        },
+        1);
+    if (primEntries.empty()) {
+        return {};
+    }
+    return HdXformSchema::GetFromParent(primEntries.front().prim.dataSource).GetMatrix();
+}
+
+} // namespace
+
+TEST(MotionSamples, animatedAndStaticTransforms)
+{
+    auto animatedMatrix = findMatrixDataSource("animatedCubeShape");
+    auto staticMatrix = findMatrixDataSource("staticCubeShape");
+    ASSERT_TRUE(animatedMatrix);
+    ASSERT_TRUE(staticMatrix);
+
+    // The animated transform changes over the shutter interval : it reports the
+    // shutter open, center and close samples, which are all different.
+    std::vector<HdSampledDataSource::Time> sampleTimes;
+    ASSERT_TRUE(animatedMatrix->GetContributingSampleTimesForInterval(
+        kShutterOpen, kShutterClose, &sampleTimes));
+    ASSERT_EQ(sampleTimes.size(), 3u);
+    EXPECT_FLOAT_EQ(sampleTimes.front(), kShutterOpen);
+    EXPECT_FLOAT_EQ(sampleTimes.back(), kShutterClose);
+    EXPECT_NE(
+        animatedMatrix->GetTypedValue(kShutterOpen), animatedMatrix->GetTypedValue(kShutterClose));
+
+    // The static transform does not change : it reports no sample times.
+    sampleTimes.clear();
+    EXPECT_FALSE(staticMatrix->GetContributingSampleTimesForInterval(
+        kShutterOpen, kShutterClose, &sampleTimes));
+    EXPECT_TRUE(sampleTimes.empty());
+
+    // The samples are taken around the new frame after a time change.
+    const GfMatrix4d before = findMatrixDataSource("animatedCubeShape")->GetTypedValue(0.0f);
+    MGlobal::executeCommand("currentTime 6; refresh -f;");
+    const GfMatrix4d after = findMatrixDataSource("animatedCubeShape")->GetTypedValue(0.0f);
+    EXPECT_NE(before, after);
+}
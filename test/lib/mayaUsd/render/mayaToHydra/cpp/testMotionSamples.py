@@ -0,0 +1,46 @@
+# Copyright 2024 Autodesk
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+import maya.cmds as cmds
+import fixturesUtils
+import mtohUtils
+from testUtils import PluginLoaded
+
+class TestMotionSamples(mtohUtils.MayaHydraBaseTestCase):
+    # MayaHydraBaseTestCase.setUpClass requirement.
+    _file = __file__
+
+    def setupScene(self):
+        self.setHdStormRenderer()
+        cmds.mayaHydra(createRenderGlobals=1)
+        cmds.setAttr("defaultRenderGlobals.mtohMotionSampleStart", -1)
+        cmds.setAttr("defaultRenderGlobals.mtohMotionSampleEnd", 1)
+        cmds.mayaHydra(updateRenderGlobals="mtohMotionSampleStart")
+        cmds.mayaHydra(updateRenderGlobals="mtohMotionSampleEnd")
+
+        cmds.polyCube(name="staticCube")
+        cmds.polyCube(name="animatedCube")
+        cmds.setKeyframe("animatedCube", attribute="translateX", time=1, value=0)
+        cmds.setKeyframe("animatedCube", attribute="translateX", time=10, value=9)
+        cmds.keyTangent("animatedCube", inTangentType="linear", outTangentType="linear")
+        cmds.currentTime(5)
+        cmds.refresh()
+
+    def test_AnimatedAndStaticTransforms(self):
+        self.setupScene()
+        with PluginLoaded('mayaHydraCppTests'):
+            cmds.mayaHydraCppTest(f="MotionSamples.animatedAndStaticTransforms")
+
+if __name__ == '__main__':
+    fixturesUtils.runTests(globals())
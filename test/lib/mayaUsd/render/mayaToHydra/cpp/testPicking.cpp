@@ -15,15 +15,28 @@
 
 #include "testUtils.h"
 
+#include <flowViewport/sceneIndex/fvpPrimBoundsIndex.h>
+
+#include <mayaHydraLib/pick/mhPickHandler.h>
+#include <mayaHydraLib/pick/mhPickHandlerRegistry.h>
+
 #include <pxr/imaging/hd/selectionSchema.h>
 #include <pxr/imaging/hd/selectionsSchema.h>
 #include <pxr/imaging/hd/xformSchema.h>
+#include <pxr/imaging/hdx/pickTask.h>
 
 #include <maya/M3dView.h>
+#include <maya/MDagPath.h>
+#include <maya/MGlobal.h>
 #include <maya/MPoint.h>
+#include <maya/MSelectionList.h>
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+
 PXR_NAMESPACE_USING_DIRECTIVE
 
 using namespace MayaHydra;
@@ -73,53 +86,39 @@ void ensureUnselected(const SceneIndexInspector& inspector, const FindPrimPredic
     }
 }
 
-} // namespace
-
-TEST(TestPicking, pickObject)
+// Is the object selected as a whole in the Maya selection, rather than some
+// of its components?
+bool isObjectSelected(const std::string& objectName)
 {
-    const SceneIndicesVector& sceneIndices = GetTerminalSceneIndices();
-    ASSERT_GT(sceneIndices.size(), 0u);
-    SceneIndexInspector inspector(sceneIndices.front());
-
-    auto [argc, argv] = getTestingArgs();
-    ASSERT_EQ(argc, 2);
-    const std::string objectName(argv[0]);
-    const TfToken primType(argv[1]);
-
-    ensureUnselected(inspector, PrimNamePredicate(objectName));
-
-    PrimEntriesVector prims = inspector.FindPrims(findPickPrimPredicate(objectName, primType));
-    ASSERT_EQ(prims.size(), 1u);
-
-    M3dView active3dView = M3dView::active3dView();
-
-    auto primMouseCoords = getPrimMouseCoords(prims.front().prim, active3dView);
-
-    mouseClick(Qt::MouseButton::LeftButton, active3dView.widget(), primMouseCoords);
-
-    active3dView.refresh();
-
-    ensureSelected(inspector, PrimNamePredicate(objectName));
+    MSelectionList selection;
+    MGlobal::getActiveSelectionList(selection);
+    for (unsigned int i = 0; i < selection.length(); ++i) {
+        MDagPath dagPath;
+        MObject  component;
+        if (selection.getDagPath(i, dagPath, component) && component.isNull()
+            && dagPath.partialPathName() == objectName.c_str()) {
+            return true;
+        }
+    }
+    return false;
 }
 
-TEST(TestPicking, marqueeSelect)
+// Objects to select, each identified by both its name and a prim type.
+std::vector<std::pair<std::string, TfToken>> getObjectsToSelect()
 {
-    const SceneIndicesVector& sceneIndices = GetTerminalSceneIndices();
-    ASSERT_GT(sceneIndices.size(), 0u);
-    SceneIndexInspector inspector(sceneIndices.front());
-
     auto [argc, argv] = getTestingArgs();
-    ASSERT_TRUE(argc % 2 == 0); // Each object is identified by both its name and a type
-    ASSERT_TRUE(argc >= 4); // We need at least two objects to do the marquee selection
     std::vector<std::pair<std::string, TfToken>> objectsToSelect;
-    for (int iArg = 0; iArg < argc; iArg += 2) {
+    for (int iArg = 0; iArg + 1 < argc; iArg += 2) {
         objectsToSelect.push_back(std::make_pair(std::string(argv[iArg]), TfToken(argv[iArg + 1])));
     }
+    return objectsToSelect;
+}
 
-    for (const auto& object : objectsToSelect) {
-        ensureUnselected(inspector, PrimNamePredicate(object.first));
-    }
-
+// Marquee select a rectangle which fits all the objects.
+void marqueeSelectObjects(
+    const SceneIndexInspector&                          inspector,
+    const std::vector<std::pair<std::string, TfToken>>& objectsToSelect)
+{
     M3dView active3dView = M3dView::active3dView();
 
     // We get the first prim's mouse coordinates and initialize the selection rectangle
@@ -163,8 +162,242 @@ TEST(TestPicking, marqueeSelect)
     mouseRelease(Qt::MouseButton::LeftButton, active3dView.widget(), bottomRightMouseCoords);
 
     active3dView.refresh();
+}
+
+// Prefix under which the pick handler of the argument prim is registered.
+SdfPath pickHandlerPrefix(const SdfPath& primPath)
+{
+    for (const auto& prefix : primPath.GetPrefixes()) {
+        if (PickHandlerRegistry::Instance().GetHandler(prefix)) {
+            return prefix;
+        }
+    }
+    return {};
+}
+
+// Pick handler which records the hits it handles, and forwards them to the
+// wrapped pick handler.
+class RecordingPickHandler : public PickHandler
+{
+public:
+    RecordingPickHandler(const PickHandlerConstPtr& wrapped, std::vector<const HdxPickHit*>& handledHits)
+        : _wrapped(wrapped), _handledHits(handledHits) {}
+
+    bool handlePickHit(const Input& pickInput, Output& pickOutput) const override {
+        _handledHits.push_back(&pickInput.pickHit);
+        return _wrapped->handlePickHit(pickInput, pickOutput);
+    }
+
+    bool handlePickHits(const BatchInput& pickInput, Output& pickOutput) const override {
+        _handledHits.insert(_handledHits.end(), pickInput.pickHits.begin(), pickInput.pickHits.end());
+        return _wrapped->handlePickHits(pickInput, pickOutput);
+    }
+
+    bool inSingleNodeComponentsPick(const HdxPickHit& hit) const override {
+        return _wrapped->inSingleNodeComponentsPick(hit);
+    }
+
+    const HdxPickHit* findSingleNodeComponentsPickHit(const BatchInput& pickInput) const override {
+        return _wrapped->findSingleNodeComponentsPickHit(pickInput);
+    }
+
+private:
+    const PickHandlerConstPtr        _wrapped;
+    std::vector<const HdxPickHit*>& _handledHits;
+};
+
+} // namespace
+
+TEST(TestPicking, pickObject)
+{
+    const SceneIndicesVector& sceneIndices = GetTerminalSceneIndices();
+    ASSERT_GT(sceneIndices.size(), 0u);
+    SceneIndexInspector inspector(sceneIndices.front());
+
+    auto [argc, argv] = getTestingArgs();
+    ASSERT_EQ(argc, 2);
+    const std::string objectName(argv[0]);
+    const TfToken primType(argv[1]);
+
+    ensureUnselected(inspector, PrimNamePredicate(objectName));
+
+    PrimEntriesVector prims = inspector.FindPrims(findPickPrimPredicate(objectName, primType));
+    ASSERT_EQ(prims.size(), 1u);
+
+    M3dView active3dView = M3dView::active3dView();
+
+    auto primMouseCoords = getPrimMouseCoords(prims.front().prim, active3dView);
+
+    mouseClick(Qt::MouseButton::LeftButton, active3dView.widget(), primMouseCoords);
+
+    active3dView.refresh();
+
+    ensureSelected(inspector, PrimNamePredicate(objectName));
+}
+
+TEST(TestPicking, marqueeSelect)
+{
+    const SceneIndicesVector& sceneIndices = GetTerminalSceneIndices();
+    ASSERT_GT(sceneIndices.size(), 0u);
+    SceneIndexInspector inspector(sceneIndices.front());
+
+    auto objectsToSelect = getObjectsToSelect();
+    ASSERT_GE(objectsToSelect.size(), 2u); // We need at least two objects to do the marquee selection
+
+    for (const auto& object : objectsToSelect) {
+        ensureUnselected(inspector, PrimNamePredicate(object.first));
+    }
+
+    marqueeSelectObjects(inspector, objectsToSelect);
+
+    for (const auto& object : objectsToSelect) {
+        ensureSelected(inspector, PrimNamePredicate(object.first));
+    }
+}
+
+TEST(TestPicking, marqueeSelectMixedPickOrder)
+{
+    const SceneIndicesVector& sceneIndices = GetTerminalSceneIndices();
+    ASSERT_GT(sceneIndices.size(), 0u);
+    SceneIndexInspector inspector(sceneIndices.front());
+
+    auto objectsToSelect = getObjectsToSelect();
+    ASSERT_GE(objectsToSelect.size(), 2u);
+
+    // Wrap the pick handlers of the objects to record the hits they handle.
+    auto& registry = PickHandlerRegistry::Instance();
+    std::vector<std::pair<SdfPath, PickHandlerConstPtr>> wrappedHandlers;
+    std::vector<const HdxPickHit*> handledHits;
+    for (const auto& object : objectsToSelect) {
+        PrimEntriesVector prims = inspector.FindPrims(findPickPrimPredicate(object.first, object.second));
+        ASSERT_EQ(prims.size(), 1u);
+        const SdfPath prefix = pickHandlerPrefix(prims.front().primPath);
+        ASSERT_FALSE(prefix.IsEmpty());
+        if (std::find_if(wrappedHandlers.begin(), wrappedHandlers.end(),
+                [&prefix](const auto& entry) { return entry.first == prefix; }) != wrappedHandlers.end()) {
+            continue;
+        }
+        auto handler = registry.GetHandler(prefix);
+        wrappedHandlers.emplace_back(prefix, handler);
+        ASSERT_TRUE(registry.Unregister(prefix));
+        ASSERT_TRUE(registry.Register(prefix, std::make_shared<RecordingPickHandler>(handler, handledHits)));
+    }
+
+    marqueeSelectObjects(inspector, objectsToSelect);
+
+    for (const auto& [prefix, handler] : wrappedHandlers) {
+        ASSERT_TRUE(registry.Unregister(prefix));
+        ASSERT_TRUE(registry.Register(prefix, handler));
+    }
 
     for (const auto& object : objectsToSelect) {
         ensureSelected(inspector, PrimNamePredicate(object.first));
     }
+
+    // The hits point into the pick hits vector : the handlers must have been
+    // given the hits, and appended to the selection, in pick order.
+    ASSERT_GE(wrappedHandlers.size(), 2u);
+    ASSERT_GE(handledHits.size(), objectsToSelect.size());
+    EXPECT_TRUE(std::is_sorted(handledHits.begin(), handledHits.end()));
+}
+
+TEST(TestPicking, prefilterTimings)
+{
+    const SceneIndicesVector& sceneIndices = GetTerminalSceneIndices();
+    ASSERT_GT(sceneIndices.size(), 0u);
+    SceneIndexInspector inspector(sceneIndices.front());
+
+    auto [argc, argv] = getTestingArgs();
+    ASSERT_EQ(argc, 3);
+    const std::string objectName(argv[0]);
+    const TfToken primType(argv[1]);
+    const int nbPicks = std::stoi(argv[2]);
+
+    PrimEntriesVector prims = inspector.FindPrims(findPickPrimPredicate(objectName, primType));
+    ASSERT_EQ(prims.size(), 1u);
+
+    M3dView active3dView = M3dView::active3dView();
+    const auto primMouseCoords = getPrimMouseCoords(prims.front().prim, active3dView);
+    const QPoint viewTopLeft(1, 1);
+    const QPoint viewBottomRight(active3dView.portWidth() - 2, active3dView.portHeight() - 2);
+
+    // Alternate a click on the object, which has few candidate prims, and a
+    // marquee over the whole view, which has most of the prims as candidates.
+    auto timePicks = [&]() {
+        const auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < nbPicks; ++i) {
+            mouseClick(Qt::MouseButton::LeftButton, active3dView.widget(), primMouseCoords);
+            active3dView.refresh();
+            EXPECT_TRUE(isObjectSelected(objectName));
+
+            mousePress(Qt::MouseButton::LeftButton, active3dView.widget(), viewTopLeft);
+            mouseMoveTo(active3dView.widget(), viewBottomRight);
+            mouseRelease(Qt::MouseButton::LeftButton, active3dView.widget(), viewBottomRight);
+            active3dView.refresh();
+        }
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    };
+
+    const double defaultRatio = Fvp::PrimBoundsIndex::GetMaxCandidatesRatio();
+
+    // Always restricting the pick collection to the candidates.
+    Fvp::PrimBoundsIndex::SetMaxCandidatesRatio(1.0);
+    const double alwaysRestrictedMs = timePicks();
+
+    Fvp::PrimBoundsIndex::SetMaxCandidatesRatio(defaultRatio);
+    const double defaultRatioMs = timePicks();
+
+    std::cout << "Picking " << nbPicks << " times a click and a marquee : "
+              << alwaysRestrictedMs << " ms always restricting the pick collection, "
+              << defaultRatioMs << " ms with a maximum candidates ratio of " << defaultRatio
+              << std::endl;
+}
+
+TEST(TestPicking, enterAndLeaveComponentsPickingMode)
+{
+    const SceneIndicesVector& sceneIndices = GetTerminalSceneIndices();
+    ASSERT_GT(sceneIndices.size(), 0u);
+    SceneIndexInspector inspector(sceneIndices.front());
+
+    auto [argc, argv] = getTestingArgs();
+    ASSERT_EQ(argc, 2);
+    const std::string objectName(argv[0]);
+    const TfToken primType(argv[1]);
+
+    PrimEntriesVector prims = inspector.FindPrims(findPickPrimPredicate(objectName, primType));
+    ASSERT_EQ(prims.size(), 1u);
+
+    M3dView active3dView = M3dView::active3dView();
+
+    auto primMouseCoords = getPrimMouseCoords(prims.front().prim, active3dView);
+
+    // A hilited object is in components picking mode : picking it is left to
+    // Maya, which does not select the object itself.
+    MGlobal::executeCommand(MString("hilite ") + objectName.c_str());
+    active3dView.refresh();
+
+    mouseClick(Qt::MouseButton::LeftButton, active3dView.widget(), primMouseCoords);
+    active3dView.refresh();
+
+    EXPECT_FALSE(isObjectSelected(objectName));
+
+    // Leaving components picking mode only changes the hilite list, the next
+    // pick must select the object.
+    MGlobal::executeCommand(MString("hilite -u ") + objectName.c_str());
+    active3dView.refresh();
+
+    mouseClick(Qt::MouseButton::LeftButton, active3dView.widget(), primMouseCoords);
+    active3dView.refresh();
+
+    EXPECT_TRUE(isObjectSelected(objectName));
+    ensureSelected(inspector, PrimNamePredicate(objectName));
+
+    // Entering components picking mode again, with the object still selected.
+    MGlobal::executeCommand(MString("hilite ") + objectName.c_str());
+    active3dView.refresh();
+
+    mouseClick(Qt::MouseButton::LeftButton, active3dView.widget(), primMouseCoords);
+    active3dView.refresh();
+
+    EXPECT_FALSE(isObjectSelected(objectName));
 }
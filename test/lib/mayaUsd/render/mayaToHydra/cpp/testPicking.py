@@ -83,6 +83,11 @@ class TestPicking(mtohUtils.MayaHydraBaseTestCase):
         with PluginLoaded('mayaHydraCppTests'):
             cmds.mayaHydraCppTest(cubeObjectName, "mesh", f="TestPicking.pickObject")
 
+    def test_PickMayaMeshComponentsPickingMode(self):
+        cubeObjectName = self.createMayaCube()
+        with PluginLoaded('mayaHydraCppTests'):
+            cmds.mayaHydraCppTest(cubeObjectName, "mesh", f="TestPicking.enterAndLeaveComponentsPickingMode")
+
     def test_PickMayaLight(self):
         directionalLightObjectName = self.createMayaDirectionalLight()
         with PluginLoaded('mayaHydraCppTests'):
@@ -126,5 +131,33 @@ class TestPicking(mtohUtils.MayaHydraBaseTestCase):
                 usdRectLightName, "rectLight",
                 f="TestPicking.marqueeSelect")
 
+    def test_MarqueeSelectionMixedPickOrder(self):
+        import mayaUsd_createStageWithNewLayer
+        stagePath = mayaUsd_createStageWithNewLayer.createStageWithNewLayer()
+        mayaCubeName = self.createMayaCube()
+        usdMayaCubeName = self.createUsdCubeFromMaya(stagePath)
+        otherMayaCubeName = cmds.polyCube(name="otherMayaCube")[0]
+        cmds.move(-2, 0, 1)
+        usdCubeName = self.createUsdCube(stagePath)
+        with PluginLoaded('mayaHydraCppTests'):
+            cmds.mayaHydraCppTest(
+                mayaCubeName, "mesh",
+                usdMayaCubeName, "mesh",
+                otherMayaCubeName, "mesh",
+                usdCubeName, "mesh",
+                f="TestPicking.marqueeSelectMixedPickOrder")
+
+    def test_PrefilterTimings(self):
+        # Enough prims for restricting the pick collection to matter.
+        for i in range(400):
+            cube = cmds.polyCube()[0]
+            cmds.move(i % 20 - 10, i // 20 - 10, -5, cube)
+        mayaCubeName = self.createMayaCube()
+        cmds.viewFit(all=True)
+        cmds.refresh()
+        with PluginLoaded('mayaHydraCppTests'):
+            cmds.mayaHydraCppTest(mayaCubeName, "mesh", "20",
+                f="TestPicking.prefilterTimings")
+
 if __name__ == '__main__':
     fixturesUtils.runTests(globals())
@@ -0,0 +1,151 @@
+// Copyright 2024 Autodesk
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include "testUtils.h"
+
+#include <mayaHydraLib/adapters/topologyCache.h>
+#include <mayaHydraLib/sceneIndex/mayaHydraSceneIndex.h>
+
+#include <flowViewport/fvpInstruments.h>
+
+#include <maya/MGlobal.h>
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <iostream>
+#include <string>
+
+PXR_NAMESPACE_USING_DIRECTIVE
+
+namespace {
+
+const std::string kNbRenderItemDeltas = "MayaHydraSceneIndex:NbRenderItemDeltas";
+const std::string kRenderItemDeltasTime = "MayaHydraSceneIndex:RenderItemDeltasTime";
+const std::string kNbRenderItemBytesCopied = "MayaHydraSceneIndex:NbRenderItemBytesCopied";
+const std::string kNbTopologyCacheHits = "MayaHydraTopologyCache:NbHits";
+const std::string kNbPopulatedPrims = "MayaHydraSceneIndex:NbPopulatedPrims";
+const std::string kNbAddedPrimsNotifications = "MayaHydraSceneIndex:NbAddedPrimsNotifications";
+
+constexpr int kNbFrames = 10;
+
+// Sum of the values of a counter for the last completed frames.
+int64_t lastFramesValue(const std::string& counterName, size_t nbFrames)
+{
+    int64_t value = 0;
+    if (const auto* counter = Fvp::Instruments::instance().findCounter(counterName)) {
+        for (size_t age = 0; age < nbFrames; ++age) {
+            value += counter->frameValue(age);
+        }
+    }
+    return value;
+}
+
+// Value of a counter for the last completed frame.
+int64_t lastFrameValue(const std::string& counterName) { return lastFramesValue(counterName, 1); }
+
+struct DeltaStats
+{
+    double timeMs = 0.0;
+    size_t nbDirtied = 0;
+    size_t nbBytesCopied = 0;
+};
+
+// Deform every sphere of the scene on each frame, so that all their render
+// items have their positions and normals changed, and accumulate the time
+// spent translating the render item changes. Every run starts from the same
+// radius, so that serial and parallel runs translate the same changes.
+DeltaStats deformSpheres(bool parallel)
+{
+    MayaHydraSceneIndex::setParallelRenderItemUpdate(parallel);
+    MGlobal::executeCommand("setAttr \"sphereSource.radius\" 0.5; refresh -f;");
+
+    const SceneIndicesVector& sceneIndices = GetTerminalSceneIndices();
+    SceneIndexNotificationsAccumulator notifsAccumulator(sceneIndices.front());
+
+    DeltaStats stats;
+    for (int frame = 0; frame < kNbFrames; ++frame) {
+        const std::string cmd = "setAttr \"sphereSource.radius\" "
+            + std::to_string(1.0 + frame * 0.1) + "; refresh -f;";
+        MGlobal::executeCommand(cmd.c_str());
+        stats.timeMs += lastFrameValue(kRenderItemDeltasTime) * 1e-6;
+        stats.nbBytesCopied += lastFrameValue(kNbRenderItemBytesCopied);
+    }
+    stats.nbDirtied = notifsAccumulator.GetDirtiedPrimEntries().size();
+    return stats;
+}
+
+} // namespace
+
+TEST(RenderItemDeltaTranslation, parallelVsSerial)
+{
+    const SceneIndicesVector& sceneIndices = GetTerminalSceneIndices();
+    ASSERT_GT(sceneIndices.size(), 0u);
+
+    // The Python driver has created many instances of the same deformed sphere
+    // as independent meshes, all connected to the "sphereSource" creator node.
+    const bool initialParallel = MayaHydraSceneIndex::parallelRenderItemUpdate();
+
+    const auto serial = deformSpheres(false);
+    const auto nbDeltasSerial = lastFrameValue(kNbRenderItemDeltas);
+    const auto parallel = deformSpheres(true);
+    const auto nbDeltasParallel = lastFrameValue(kNbRenderItemDeltas);
+
+    MayaHydraSceneIndex::setParallelRenderItemUpdate(initialParallel);
+
+    // Both translations must produce the same changes.
+    EXPECT_GT(nbDeltasParallel, 0);
+    EXPECT_EQ(nbDeltasSerial, nbDeltasParallel);
+    EXPECT_EQ(serial.nbDirtied, parallel.nbDirtied);
+    EXPECT_GT(parallel.nbBytesCopied, 0u);
+    EXPECT_EQ(serial.nbBytesCopied, parallel.nbBytesCopied);
+
+    // Timings are reported, not asserted on, as they depend on the machine.
+    std::cout << "Render item delta translation over " << kNbFrames << " frames of "
+              << nbDeltasParallel << " render items : serial "
+              << serial.timeMs << " ms, parallel " << parallel.timeMs << " ms, speedup "
+              << (parallel.timeMs > 0.0 ? serial.timeMs / parallel.timeMs : 0.0) << ", "
+              << parallel.nbBytesCopied / kNbFrames << " bytes copied per frame" << std::endl;
+}
+
+TEST(RenderItemDeltaTranslation, topologyCache)
+{
+    // All the spheres created by the Python driver have the same topology : their render items
+    // must share a few cached topologies, instead of each having its own. Changing the topology
+    // of all the spheres in a single frame looks all their new topologies up.
+    MGlobal::executeCommand("setAttr \"sphereSource.subdivisionsAxis\" 48; refresh -f;");
+
+    const size_t size = MayaHydraTopologyCache::GetInstance().GetSize();
+    EXPECT_GT(size, 0u);
+    EXPECT_LT(size, 50u);
+    EXPECT_GT(lastFrameValue(kNbTopologyCacheHits), 400);
+}
+
+TEST(RenderItemDeltaTranslation, initialPopulation)
+{
+    // The Python driver has switched the viewport back to Viewport 2.0, which released the Hydra
+    // resources : switching it to Hydra again populates a new Maya scene index.
+    const size_t firstFrame = Fvp::Instruments::instance().nbFrames();
+    MGlobal::executeCommand("modelEditor -e -rendererOverrideName "
+                            "\"mayaHydraRenderOverride_HdStormRendererPlugin\" "
+                            "`playblast -activeEditor`; refresh -f;");
+    const size_t nbFrames = Fvp::Instruments::instance().nbFrames() - firstFrame;
+    ASSERT_GT(nbFrames, 0u);
+
+    // The scene has no lights : the render items of all the spheres, their materials and their
+    // ancestors are added downstream in a single notification.
+    EXPECT_GT(lastFramesValue(kNbPopulatedPrims, nbFrames), 400);
+    EXPECT_EQ(lastFramesValue(kNbAddedPrimsNotifications, nbFrames), 1);
+}
@@ -0,0 +1,57 @@
+# Copyright 2024 Autodesk
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+import maya.cmds as cmds
+import fixturesUtils
+import mtohUtils
+from testUtils import PluginLoaded
+
+class TestRenderItemDeltaTranslation(mtohUtils.MayaHydraBaseTestCase):
+    # MayaHydraBaseTestCase.setUpClass requirement.
+    _file = __file__
+
+    NB_SPHERES = 400
+
+    def setupScene(self):
+        self.setHdStormRenderer()
+        # Synthetic render items : many dense spheres that all deform when the
+        # radius of a single creator node changes, and all change topology
+        # when its number of subdivisions changes.
+        source = cmds.polySphere(subdivisionsAxis=64, subdivisionsHeight=64)[1]
+        cmds.rename(source, "sphereSource")
+        for i in range(self.NB_SPHERES):
+            sphere = cmds.polySphere(subdivisionsAxis=64, subdivisionsHeight=64)
+            cmds.connectAttr("sphereSource.radius", sphere[1] + ".radius")
+            cmds.connectAttr("sphereSource.subdivisionsAxis", sphere[1] + ".subdivisionsAxis")
+            cmds.move(i % 20 * 2, 0, i // 20 * 2, sphere[0])
+        cmds.refresh()
+
+    def test_ParallelVsSerial(self):
+        self.setupScene()
+        with PluginLoaded('mayaHydraCppTests'):
+            cmds.mayaHydraCppTest(f="RenderItemDeltaTranslation.parallelVsSerial")
+
+    def test_TopologyCache(self):
+        self.setupScene()
+        with PluginLoaded('mayaHydraCppTests'):
+            cmds.mayaHydraCppTest(f="RenderItemDeltaTranslation.topologyCache")
+
+    def test_InitialPopulation(self):
+        self.setupScene()
+        self.setViewport2Renderer()
+        with PluginLoaded('mayaHydraCppTests'):
+            cmds.mayaHydraCppTest(f="RenderItemDeltaTranslation.initialPopulation")
+
+if __name__ == '__main__':
+    fixturesUtils.runTests(globals())
@@ -31,5 +31,23 @@ class TestSceneIndexDirtying(mtohUtils.MayaHydraBaseTestCase):
         with PluginLoaded('mayaHydraCppTests'):
             cmds.mayaHydraCppTest(f="SceneIndexDirtying.testDirtyingNew")
 
+    def test_BatchedDirtyNotifications(self):
+        self.setHdStormRenderer()
+        # Deform many meshes in the same frame, through a single creator node.
+        source = cmds.polySphere()[1]
+        for i in range(50):
+            sphere = cmds.polySphere()
+            cmds.connectAttr(source + ".radius", sphere[1] + ".radius")
+        cmds.refresh()
+
+        with PluginLoaded('mayaHydraCppTests'):
+            cmds.setAttr(source + ".radius", 2)
+            cmds.refresh()
+            # All the dirtied render items of the frame are sent downstream
+            # in a handful of notifications, instead of one per render item.
+            nbNotifications = cmds.mayaHydraInstruments("MayaHydraSceneIndex:NbDirtyNotifications", q=True)
+            self.assertGreater(nbNotifications, 0)
+            self.assertLess(nbNotifications, 10)
+
 if __name__ == '__main__':
     fixturesUtils.runTests(globals())
@@ -0,0 +1,83 @@
+// Copyright 2024 Autodesk
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "testUtils.h"
+
+#include <mayaHydraLib/sceneIndex/mayaHydraSceneIndex.h>
+
+#include <flowViewport/sceneIndex/fvpMergingSceneIndex.h>
+
+#include <maya/MSelectionList.h>
+
+#include <ufe/pathString.h>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <string>
+
+PXR_NAMESPACE_USING_DIRECTIVE
+
+namespace {
+
+MayaHydraSceneIndexRefPtr getMayaSceneIndex()
+{
+    const auto& sceneIndices = GetTerminalSceneIndices();
+    if (sceneIndices.empty()) {
+        return {};
+    }
+    auto mergingSi = TfDynamic_cast<Fvp::MergingSceneIndexRefPtr>(findSceneIndexInTree(
+        sceneIndices.front(), SceneIndexDisplayNamePred("Flow Viewport Merging Scene Index")));
+    if (!mergingSi) {
+        return {};
+    }
+    auto producers = mergingSi->GetInputScenes();
+    auto found = std::find_if(
+        producers.begin(), producers.end(), SceneIndexDisplayNamePred("MayaHydraSceneIndex"));
+    return (found == producers.end()) ? MayaHydraSceneIndexRefPtr()
+                                      : TfDynamic_cast<MayaHydraSceneIndexRefPtr>(*found);
+}
+
+} // namespace
+
+TEST(UfePathCache, selectedPrimPaths)
+{
+    const auto& sceneIndices = GetTerminalSceneIndices();
+    ASSERT_GT(sceneIndices.size(), 0u);
+    const auto snSi = findSelectionSceneIndexInTree(sceneIndices.front());
+    ASSERT_TRUE(snSi);
+    auto mayaSi = getMayaSceneIndex();
+    ASSERT_TRUE(mayaSi);
+
+    // Each argument is the full DAG path of a selected node.
+    auto [argc, argv] = getTestingArgs();
+    ASSERT_GT(argc, 0);
+    const auto selectedPaths = snSi->GetFullySelectedPaths();
+    for (int i = 0; i < argc; ++i) {
+        const std::string dagPathString(argv[i]);
+        MSelectionList    sel;
+        ASSERT_TRUE(sel.add(dagPathString.c_str()));
+        MDagPath dagPath;
+        ASSERT_TRUE(sel.getDagPath(0, dagPath));
+
+        // The possibly cached conversion matches the conversion of the
+        // current DAG path, and is the selected prim path.
+        const SdfPath expected = mayaSi->GetPrimPath(dagPath, false);
+        const auto primSelections
+            = mayaSi->UfePathToPrimSelections(Ufe::PathString::path("|world" + dagPathString));
+        ASSERT_EQ(primSelections.size(), 1u);
+        EXPECT_EQ(primSelections.front().primPath, expected);
+        EXPECT_NE(std::find(selectedPaths.begin(), selectedPaths.end(), expected), selectedPaths.end());
+    }
+}
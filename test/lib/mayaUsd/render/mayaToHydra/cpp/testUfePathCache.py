@@ -0,0 +1,67 @@
+# Copyright 2024 Autodesk
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+import maya.cmds as cmds
+import fixturesUtils
+import mtohUtils
+from testUtils import PluginLoaded
+
+class TestUfePathCache(mtohUtils.MayaHydraBaseTestCase):
+    # MayaHydraBaseTestCase.setUpClass requirement.
+    _file = __file__
+
+    def assertSelectedPrimPaths(self, *dagPaths):
+        cmds.select(clear=True)
+        cmds.select(*dagPaths, replace=True)
+        cmds.refresh()
+        cmds.mayaHydraCppTest(*dagPaths, f="UfePathCache.selectedPrimPaths")
+
+    def nbCacheMisses(self):
+        return cmds.mayaHydraInstruments("MayaHydraSceneIndex:NbUfePathCacheMisses", q=True)
+
+    def test_RenameAndReparent(self):
+        self.setHdStormRenderer()
+        cmds.polyCube(name="cubeA")
+        cmds.group("cubeA", name="groupA")
+        cmds.polyCube(name="cubeB")
+        cmds.group("cubeB", name="groupB")
+        cmds.polyCube(name="cubeC")
+        cmds.select(clear=True)
+        cmds.refresh()
+
+        with PluginLoaded('mayaHydraCppTests'):
+            self.assertSelectedPrimPaths("|groupA|cubeA", "|groupB|cubeB")
+
+            # Renaming an unrelated node keeps the selected paths cached.
+            cmds.rename("cubeC", "cubeRenamedC")
+            self.assertSelectedPrimPaths("|groupA|cubeA", "|groupB|cubeB")
+            self.assertEqual(self.nbCacheMisses(), 0)
+
+            cmds.rename("|groupA|cubeA", "cubeRenamed")
+            self.assertSelectedPrimPaths("|groupA|cubeRenamed", "|groupB|cubeB")
+
+            # Renaming an ancestor changes the paths below it.
+            cmds.rename("groupA", "groupRenamed")
+            self.assertSelectedPrimPaths("|groupRenamed|cubeRenamed", "|groupB|cubeB")
+
+            cmds.parent("|groupB|cubeB", "groupRenamed")
+            self.assertSelectedPrimPaths("|groupRenamed|cubeRenamed", "|groupRenamed|cubeB")
+
+            # Reparenting an unrelated node keeps the selected paths cached.
+            cmds.parent("cubeRenamedC", "groupB")
+            self.assertSelectedPrimPaths("|groupRenamed|cubeRenamed", "|groupRenamed|cubeB")
+            self.assertEqual(self.nbCacheMisses(), 0)
+
+if __name__ == '__main__':
+    fixturesUtils.runTests(globals())
@@ -36,5 +36,21 @@ class TestMaterialXOnNative(mtohUtils.MayaHydraBaseTestCase):
         self.setHdStormRenderer()
         self.verifySnapshot("RedMtlxSphere.png")
 
+    def test_MaterialXNetworkCache(self):
+        mayaUtils.openTestScene("testMaterialX", "RedMtlxSphere.ma")
+        self.setBasicCam(2)
+        self.setHdStormRenderer()
+        cmds.refresh()
+
+        # Toggling X-Ray dirties all materials : the MaterialX network must
+        # come from the cache, and still render the same.
+        panel = mayaUtils.activeModelPanel()
+        cmds.modelEditor(panel, edit=True, xray=True)
+        cmds.refresh()
+        nbHits = cmds.mayaHydra(instrumentsCounter="MayaHydraMaterialXNetworkCache:NbHits")
+        self.assertGreater(nbHits, 0)
+        cmds.modelEditor(panel, edit=True, xray=False)
+        self.verifySnapshot("RedMtlxSphere.png")
+
 if __name__ == '__main__':
     fixturesUtils.runTests(globals())
@@ -66,6 +66,65 @@ class TestMayaHydraRender(mtohUtils.MayaHydraBaseTestCase):
         cmds.select(self.cubeTrans)
         self.assertSnapshotEqual("cube_selected.png", imageVersion)
 
+    def test_sharedShadingNetwork(self):
+        self.makeCubeScene(camDist=6)
+        otherCube = cmds.polyCube()[0]
+        cmds.move(2, 0, 0, otherCube)
+
+        # Two materials sharing the same texture node.
+        texture = cmds.shadingNode("file", asTexture=True)
+        for cube in [self.cubeTrans, otherCube]:
+            shader = cmds.shadingNode("lambert", asShader=True)
+            cmds.connectAttr(texture + ".outColor", shader + ".color")
+            cmds.select(cube)
+            cmds.hyperShade(assign=shader)
+        cmds.select(clear=True)
+        cmds.refresh()
+
+        # The texture node is the only node shared by the two materials : it
+        # was converted once, and reused by the second material.
+        nbSharedNodes = 1
+        self.assertGreaterEqual(self._lastFrameCounterValue("NbNodeCacheHits"), nbSharedNodes)
+
+        # Changing the texture must not reuse its stale conversion : only the
+        # texture and the two shaders downstream of it are converted again,
+        # the second material reusing the new texture conversion.
+        cmds.setAttr(texture + ".defaultColor", 1, 0, 0, type='float3')
+        cmds.refresh()
+        nbEditedAndDownstreamNodes = 3
+        self.assertEqual(self._lastFrameCounterValue("NbNodeCacheMisses"), nbEditedAndDownstreamNodes)
+        self.assertGreaterEqual(self._lastFrameCounterValue("NbNodeCacheHits"), nbSharedNodes)
+
+    def test_cachedNodeChangedWithoutMaterial(self):
+        self.makeCubeScene(camDist=6)
+
+        texture = cmds.shadingNode("file", asTexture=True)
+        shader = cmds.shadingNode("lambert", asShader=True)
+        cmds.connectAttr(texture + ".outColor", shader + ".color")
+        cmds.select(self.cubeTrans)
+        cmds.hyperShade(assign=shader)
+        cmds.select(clear=True)
+        cmds.refresh()
+
+        # No material uses the texture anymore when it is changed : the cached
+        # conversion must still be dropped.
+        cmds.delete(shader)
+        cmds.refresh()
+        cmds.setAttr(texture + ".defaultColor", 1, 0, 0, type='float3')
+        cmds.refresh()
+
+        otherShader = cmds.shadingNode("lambert", asShader=True)
+        cmds.connectAttr(texture + ".outColor", otherShader + ".color")
+        cmds.select(self.cubeTrans)
+        cmds.hyperShade(assign=otherShader)
+        cmds.select(clear=True)
+        cmds.refresh()
+        nbNewAndEditedNodes = 2
+        self.assertEqual(self._lastFrameCounterValue("NbNodeCacheMisses"), nbNewAndEditedNodes)
+
+    def _lastFrameCounterValue(self, counterName):
+        return cmds.mayaHydra(instrumentsCounter="MayaHydraMaterialNetworkConverter:" + counterName)
+
 
 if __name__ == '__main__':
     fixturesUtils.runTests(globals())
@@ -0,0 +1,163 @@
+//
+// Copyright 2024 Autodesk
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include <mayaHydraLib/mhBufferKernels.h>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using namespace MayaHydra::BufferKernels;
+
+namespace {
+
+// Size of the index buffer of a 2M triangles mesh, and of its vertex buffers.
+constexpr size_t kNbIndices = 6000000;
+constexpr size_t kNbVertices = 1000000;
+
+std::vector<int> randomIndices(size_t count, int nbVertices)
+{
+    std::mt19937                       generator(42);
+    std::uniform_int_distribution<int> distribution(0, nbVertices - 1);
+    std::vector<int>                   indices(count);
+    for (auto& index : indices) {
+        index = distribution(generator);
+    }
+    return indices;
+}
+
+std::vector<float> randomFloats(size_t count)
+{
+    std::mt19937                          generator(7);
+    std::uniform_real_distribution<float> distribution(-1.f, 1.f);
+    std::vector<float>                    values(count);
+    for (auto& value : values) {
+        value = distribution(generator);
+    }
+    return values;
+}
+
+double timeMs(const std::function<void()>& f)
+{
+    const auto                                      start = std::chrono::steady_clock::now();
+    f();
+    const std::chrono::duration<double, std::milli> elapsed
+        = std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+}
+
+// Median times in ms of the scalar and SIMD versions of a kernel, after a warm up run of each.
+// The run order alternates, so that neither version always runs on a cache warmed by the other.
+std::pair<double, double>
+medianTimesMs(const std::function<void()>& scalar, const std::function<void()>& simd)
+{
+    constexpr size_t kNbRuns = 7;
+    scalar();
+    simd();
+    std::vector<double> scalarTimes;
+    std::vector<double> simdTimes;
+    for (size_t run = 0; run < kNbRuns; ++run) {
+        if (run % 2) {
+            simdTimes.push_back(timeMs(simd));
+            scalarTimes.push_back(timeMs(scalar));
+        } else {
+            scalarTimes.push_back(timeMs(scalar));
+            simdTimes.push_back(timeMs(simd));
+        }
+    }
+    auto median = [](std::vector<double>& times) {
+        std::nth_element(times.begin(), times.begin() + times.size() / 2, times.end());
+        return times[times.size() / 2];
+    };
+    return { median(scalarTimes), median(simdTimes) };
+}
+
+} // namespace
+
+TEST(BufferKernels, maxIndex)
+{
+    EXPECT_EQ(maxIndex(nullptr, 0), 0);
+
+    // Cover all the remainder sizes of the SIMD loops.
+    for (size_t count = 1; count < 70; ++count) {
+        const auto indices = randomIndices(count, 1000);
+        EXPECT_EQ(maxIndex(indices.data(), count), maxIndexScalar(indices.data(), count));
+    }
+
+    // The maximum in the last, non SIMD, elements.
+    std::vector<int> indices(37, 3);
+    indices.back() = 12;
+    EXPECT_EQ(maxIndex(indices.data(), indices.size()), 12);
+
+    // Negative values are ignored.
+    const std::vector<int> negatives(40, -5);
+    EXPECT_EQ(maxIndex(negatives.data(), negatives.size()), 0);
+}
+
+TEST(BufferKernels, gather)
+{
+    constexpr int nbVertices = 100;
+    // UVs are 2 floats, tangents 3 floats with an optional 4th one.
+    const std::vector<std::pair<size_t, size_t>> componentsAndStrides
+        = { { 2, 2 }, { 2, 3 }, { 3, 3 }, { 3, 4 }, { 4, 4 } };
+    for (const auto& [nbComponents, stride] : componentsAndStrides) {
+        const auto src = randomFloats(nbVertices * stride);
+        for (size_t count = 0; count < 20; ++count) {
+            const auto         indices = randomIndices(count, nbVertices);
+            std::vector<float> dst(count * nbComponents);
+            gather(dst.data(), src.data(), indices.data(), count, nbComponents, stride);
+            for (size_t i = 0; i < count; ++i) {
+                for (size_t c = 0; c < nbComponents; ++c) {
+                    ASSERT_EQ(dst[i * nbComponents + c], src[indices[i] * stride + c]);
+                }
+            }
+        }
+    }
+}
+
+TEST(BufferKernels, benchmark)
+{
+    // Only the shapes which have a SIMD path are benchmarked : the max index scan, and the
+    // gather of 2 floats elements (UVs). 3 and 4 floats elements (tangents) always use the
+    // scalar loop.
+    const auto indices = randomIndices(kNbIndices, int(kNbVertices));
+    const auto uvs = randomFloats(kNbVertices * 2);
+
+    int expectedMax = 0;
+    int resultMax = 0;
+    const auto [maxScalar, maxSimd] = medianTimesMs(
+        [&]() { expectedMax = maxIndexScalar(indices.data(), kNbIndices); },
+        [&]() { resultMax = maxIndex(indices.data(), kNbIndices); });
+    EXPECT_EQ(expectedMax, resultMax);
+
+    std::vector<float> expected(kNbIndices * 2);
+    std::vector<float> result(kNbIndices * 2);
+    const auto [uvsScalar, uvsSimd] = medianTimesMs(
+        [&]() { gatherScalar(expected.data(), uvs.data(), indices.data(), kNbIndices, 2, 2); },
+        [&]() { gather(result.data(), uvs.data(), indices.data(), kNbIndices, 2, 2); });
+    EXPECT_EQ(expected, result);
+
+    // Timings are reported, not asserted on, as they depend on the machine.
+    std::cout << "Buffer kernels on " << kNbIndices << " indices (AVX2 "
+              << (isAvx2Supported() ? "on" : "off") << "), median times : max index "
+              << maxScalar << " ms scalar, " << maxSimd << " ms; UVs " << uvsScalar
+              << " ms scalar, " << uvsSimd << " ms" << std::endl;
+}
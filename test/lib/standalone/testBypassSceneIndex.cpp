@@ -0,0 +1,157 @@
+//
+// Copyright 2024 Autodesk
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include <flowViewport/sceneIndex/fvpBypassSceneIndex.h>
+
+#include <pxr/imaging/hd/retainedDataSource.h>
+#include <pxr/imaging/hd/retainedSceneIndex.h>
+#include <pxr/imaging/hd/tokens.h>
+
+#include <gtest/gtest.h>
+
+PXR_NAMESPACE_USING_DIRECTIVE
+
+using Fvp::BypassSceneIndex;
+
+namespace {
+
+class RecordingObserver : public HdSceneIndexObserver
+{
+public:
+    void PrimsAdded(const HdSceneIndexBase&, const AddedPrimEntries& entries) override
+    {
+        for (const auto& entry : entries) {
+            added.push_back(entry.primPath);
+        }
+    }
+    void PrimsRemoved(const HdSceneIndexBase&, const RemovedPrimEntries& entries) override
+    {
+        for (const auto& entry : entries) {
+            removed.push_back(entry.primPath);
+        }
+    }
+    void PrimsDirtied(const HdSceneIndexBase&, const DirtiedPrimEntries& entries) override
+    {
+        for (const auto& entry : entries) {
+            dirtied.push_back(entry.primPath);
+        }
+    }
+    void PrimsRenamed(const HdSceneIndexBase&, const RenamedPrimEntries&) override { }
+
+    void clear()
+    {
+        added.clear();
+        removed.clear();
+        dirtied.clear();
+    }
+
+    SdfPathVector added;
+    SdfPathVector removed;
+    SdfPathVector dirtied;
+};
+
+} // namespace
+
+TEST(BypassSceneIndex, onlyNotifiesDifferingPrims)
+{
+    const HdContainerDataSourceHandle unchanged = HdRetainedContainerDataSource::New();
+    const HdContainerDataSourceHandle original = HdRetainedContainerDataSource::New();
+    const HdContainerDataSourceHandle filtered = HdRetainedContainerDataSource::New();
+
+    // Unfiltered scene : /a, /a/mesh1, /a/mesh2, /b/mesh3.
+    auto bypassScene = HdRetainedSceneIndex::New();
+    bypassScene->AddPrims({ { SdfPath("/a"), TfToken(), unchanged },
+                            { SdfPath("/a/mesh1"), HdPrimTypeTokens->mesh, original },
+                            { SdfPath("/a/mesh2"), HdPrimTypeTokens->mesh, unchanged },
+                            { SdfPath("/b/mesh3"), HdPrimTypeTokens->mesh, unchanged } });
+
+    // Filtered scene : /a/mesh1 is overridden, /b is pruned, /c is added and /a/mesh2 is passed
+    // through.
+    auto filteredScene = HdRetainedSceneIndex::New();
+    filteredScene->AddPrims({ { SdfPath("/a"), TfToken(), unchanged },
+                              { SdfPath("/a/mesh1"), HdPrimTypeTokens->mesh, filtered },
+                              { SdfPath("/a/mesh2"), HdPrimTypeTokens->mesh, unchanged },
+                              { SdfPath("/c"), HdPrimTypeTokens->sphereLight, unchanged } });
+
+    auto bypass = BypassSceneIndex::New(filteredScene, bypassScene, false);
+    RecordingObserver observer;
+    bypass->AddObserver(HdSceneIndexObserverPtr(&observer));
+
+    EXPECT_EQ(bypass->GetPrim(SdfPath("/a/mesh1")).dataSource, filtered);
+
+    bypass->SetBypassed(true);
+    EXPECT_TRUE(bypass->IsBypassed());
+    EXPECT_EQ(bypass->GetPrim(SdfPath("/a/mesh1")).dataSource, original);
+    EXPECT_EQ(observer.dirtied, SdfPathVector({ SdfPath("/a/mesh1") }));
+    EXPECT_EQ(observer.removed, SdfPathVector({ SdfPath("/c") }));
+    EXPECT_EQ(observer.added, SdfPathVector({ SdfPath("/b"), SdfPath("/b/mesh3") }));
+
+    // Notices from the inactive input are not forwarded.
+    observer.clear();
+    filteredScene->DirtyPrims({ { SdfPath("/a/mesh2"), HdDataSourceLocatorSet::UniversalSet() } });
+    EXPECT_TRUE(observer.dirtied.empty());
+    bypassScene->DirtyPrims({ { SdfPath("/a/mesh2"), HdDataSourceLocatorSet::UniversalSet() } });
+    EXPECT_EQ(observer.dirtied, SdfPathVector({ SdfPath("/a/mesh2") }));
+
+    observer.clear();
+    bypass->SetBypassed(true);
+    EXPECT_TRUE(observer.added.empty() && observer.removed.empty() && observer.dirtied.empty());
+
+    bypass->SetBypassed(false);
+    EXPECT_EQ(observer.dirtied, SdfPathVector({ SdfPath("/a/mesh1") }));
+    EXPECT_EQ(observer.removed, SdfPathVector({ SdfPath("/b") }));
+    EXPECT_EQ(observer.added, SdfPathVector({ SdfPath("/c") }));
+
+    bypass->RemoveObserver(HdSceneIndexObserverPtr(&observer));
+}
+
+TEST(BypassSceneIndex, onlyComparesAffectedPaths)
+{
+    const HdContainerDataSourceHandle unchanged = HdRetainedContainerDataSource::New();
+    const HdContainerDataSourceHandle original = HdRetainedContainerDataSource::New();
+    const HdContainerDataSourceHandle filtered = HdRetainedContainerDataSource::New();
+
+    auto bypassScene = HdRetainedSceneIndex::New();
+    bypassScene->AddPrims({ { SdfPath("/a/mesh1"), HdPrimTypeTokens->mesh, original },
+                            { SdfPath("/b/mesh2"), HdPrimTypeTokens->mesh, original },
+                            { SdfPath("/c/mesh3"), HdPrimTypeTokens->mesh, unchanged } });
+
+    // The filter declares it only changes /a and /c : /b is not compared, its
+    // difference is not notified. /c is pruned by the filter.
+    auto filteredScene = HdRetainedSceneIndex::New();
+    filteredScene->AddPrims({ { SdfPath("/a/mesh1"), HdPrimTypeTokens->mesh, filtered },
+                              { SdfPath("/b/mesh2"), HdPrimTypeTokens->mesh, filtered } });
+
+    auto bypass = BypassSceneIndex::New(
+        filteredScene, bypassScene, false, { SdfPath("/c"), SdfPath("/a"), SdfPath("/a/mesh1") });
+    EXPECT_EQ(bypass->GetAffectedPaths(), SdfPathVector({ SdfPath("/a"), SdfPath("/c") }));
+
+    RecordingObserver observer;
+    bypass->AddObserver(HdSceneIndexObserverPtr(&observer));
+
+    bypass->SetBypassed(true);
+    EXPECT_EQ(observer.dirtied, SdfPathVector({ SdfPath("/a/mesh1") }));
+    EXPECT_EQ(observer.added, SdfPathVector({ SdfPath("/c"), SdfPath("/c/mesh3") }));
+    EXPECT_TRUE(observer.removed.empty());
+
+    observer.clear();
+    bypass->SetBypassed(false);
+    EXPECT_EQ(observer.dirtied, SdfPathVector({ SdfPath("/a/mesh1") }));
+    EXPECT_EQ(observer.removed, SdfPathVector({ SdfPath("/c") }));
+    EXPECT_TRUE(observer.added.empty());
+
+    bypass->RemoveObserver(HdSceneIndexObserverPtr(&observer));
+}
@@ -0,0 +1,93 @@
+//
+// Copyright 2024 Autodesk
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include <flowViewport/fvpInstruments.h>
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+using Instruments = Fvp::Instruments;
+using Counter = Fvp::Instruments::Counter;
+
+TEST(Instruments, counters)
+{
+    auto& instruments = Instruments::instance();
+    Counter& counter = instruments.counter("testInstruments:counter");
+    EXPECT_EQ(&counter, &instruments.counter("testInstruments:counter"));
+    EXPECT_EQ(&counter, instruments.findCounter("testInstruments:counter"));
+    EXPECT_EQ(instruments.findCounter("testInstruments:doesNotExist"), nullptr);
+
+    // Values are accumulated from several threads without losing any.
+    constexpr int            nbThreads = 4;
+    constexpr int            nbAdds = 10000;
+    std::vector<std::thread> threads;
+    for (int i = 0; i < nbThreads; ++i) {
+        threads.emplace_back([&counter]() {
+            for (int j = 0; j < nbAdds; ++j) {
+                counter.add();
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    EXPECT_EQ(counter.current(), nbThreads * nbAdds);
+
+    const size_t nbFrames = instruments.nbFrames();
+    instruments.endFrame();
+    EXPECT_EQ(instruments.nbFrames(), nbFrames + 1);
+    EXPECT_EQ(counter.current(), 0);
+    EXPECT_EQ(counter.frameValue(0), nbThreads * nbAdds);
+
+    counter.add(3);
+    instruments.endFrame();
+    EXPECT_EQ(counter.frameValue(0), 3);
+    EXPECT_EQ(counter.frameValue(1), nbThreads * nbAdds);
+    EXPECT_EQ(counter.frameValue(Instruments::kNbFramesHistory), 0);
+
+    EXPECT_NE(instruments.report().find("testInstruments:counter"), std::string::npos);
+}
+
+TEST(Instruments, chromeTrace)
+{
+    auto& instruments = Instruments::instance();
+    instruments.setTracing(true);
+    {
+        FVP_INSTRUMENTS_SCOPED_TIMER("testInstruments:timer");
+    }
+    instruments.setTracing(false);
+
+    const Counter* timer = instruments.findCounter("testInstruments:timer");
+    ASSERT_NE(timer, nullptr);
+    EXPECT_EQ(timer->unit(), Counter::Unit::Nanoseconds);
+
+    const std::string filePath = "testInstrumentsTrace.json";
+    ASSERT_TRUE(instruments.writeChromeTrace(filePath));
+    std::ifstream     file(filePath);
+    std::stringstream content;
+    content << file.rdbuf();
+    file.close();
+    std::remove(filePath.c_str());
+
+    EXPECT_EQ(content.str().rfind("{\"traceEvents\":[", 0), 0u);
+    EXPECT_NE(content.str().find("\"name\":\"testInstruments:timer\""), std::string::npos);
+    EXPECT_NE(content.str().find("\"ph\":\"X\""), std::string::npos);
+}
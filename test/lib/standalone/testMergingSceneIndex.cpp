@@ -0,0 +1,120 @@
+//
+// Copyright 2024 Autodesk
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include <flowViewport/sceneIndex/fvpMergingSceneIndex.h>
+
+#include <pxr/imaging/hd/retainedSceneIndex.h>
+
+#include <ufe/path.h>
+#include <ufe/pathSegment.h>
+
+#include <gtest/gtest.h>
+
+#include <map>
+#include <string>
+
+PXR_NAMESPACE_USING_DIRECTIVE
+
+using Fvp::MergingSceneIndex;
+using Fvp::PrimSelections;
+
+namespace {
+
+constexpr Ufe::Rtid kRtid = 1;
+
+Ufe::Path appPath(const std::string& pathString)
+{
+    return Ufe::Path(Ufe::PathSegment(pathString, kRtid, '|'));
+}
+
+// Input scene converting application paths from a table that the tests edit,
+// as a rename or reparent would.
+class TablePathSceneIndex;
+using TablePathSceneIndexRefPtr = TfRefPtr<TablePathSceneIndex>;
+
+class TablePathSceneIndex : public HdRetainedSceneIndex, public Fvp::PathInterface
+{
+public:
+    static TablePathSceneIndexRefPtr New() { return TfCreateRefPtr(new TablePathSceneIndex); }
+
+    PrimSelections UfePathToPrimSelections(const Ufe::Path& path) const override
+    {
+        auto found = paths.find(path.string());
+        if (found == paths.end()) {
+            return PrimSelections();
+        }
+        return PrimSelections({ Fvp::PrimSelection{ found->second } });
+    }
+
+    std::map<std::string, SdfPath> paths;
+
+private:
+    TablePathSceneIndex() = default;
+};
+
+SdfPath convertedPath(const MergingSceneIndex& mergingSceneIndex, const std::string& pathString)
+{
+    const auto primSelections = mergingSceneIndex.UfePathToPrimSelections(appPath(pathString));
+    return primSelections.empty() ? SdfPath() : primSelections.front().primPath;
+}
+
+} // namespace
+
+TEST(MergingSceneIndex, renameAndReparentChangeConversion)
+{
+    auto input = TablePathSceneIndex::New();
+    input->paths["|a"] = SdfPath("/a");
+
+    auto mergingSceneIndex = MergingSceneIndex::New();
+    mergingSceneIndex->AddInputScene(input, SdfPath::AbsoluteRootPath());
+    ASSERT_EQ(convertedPath(*mergingSceneIndex, "|a"), SdfPath("/a"));
+
+    // Rename |a to |b : the old path no longer converts.
+    input->paths.clear();
+    input->paths["|b"] = SdfPath("/b");
+    ASSERT_TRUE(convertedPath(*mergingSceneIndex, "|a").IsEmpty());
+    ASSERT_EQ(convertedPath(*mergingSceneIndex, "|b"), SdfPath("/b"));
+
+    // Reparent |b under |grp.
+    input->paths.clear();
+    input->paths["|grp|b"] = SdfPath("/grp/b");
+    ASSERT_TRUE(convertedPath(*mergingSceneIndex, "|b").IsEmpty());
+    ASSERT_EQ(convertedPath(*mergingSceneIndex, "|grp|b"), SdfPath("/grp/b"));
+}
+
+TEST(MergingSceneIndex, removedInputReturnsNoStaleSelection)
+{
+    auto input1 = TablePathSceneIndex::New();
+    input1->paths["|a"] = SdfPath("/input1/a");
+    auto input2 = TablePathSceneIndex::New();
+    input2->paths["|c"] = SdfPath("/input2/c");
+
+    auto mergingSceneIndex = MergingSceneIndex::New();
+    mergingSceneIndex->AddInputScene(input1, SdfPath::AbsoluteRootPath());
+    mergingSceneIndex->AddInputScene(input2, SdfPath::AbsoluteRootPath());
+
+    // input1 is remembered as the input converting paths of this run-time.
+    ASSERT_EQ(convertedPath(*mergingSceneIndex, "|a"), SdfPath("/input1/a"));
+    ASSERT_EQ(convertedPath(*mergingSceneIndex, "|a"), SdfPath("/input1/a"));
+
+    mergingSceneIndex->RemoveInputScene(input1);
+    ASSERT_TRUE(convertedPath(*mergingSceneIndex, "|a").IsEmpty());
+    ASSERT_EQ(convertedPath(*mergingSceneIndex, "|c"), SdfPath("/input2/c"));
+
+    // The removed input is not used anymore, even once released.
+    input1.Reset();
+    ASSERT_TRUE(convertedPath(*mergingSceneIndex, "|a").IsEmpty());
+}
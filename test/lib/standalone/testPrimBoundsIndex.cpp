@@ -0,0 +1,160 @@
+//
+// Copyright 2024 Autodesk
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include <flowViewport/sceneIndex/fvpPrimBoundsIndex.h>
+
+#include <pxr/base/gf/frustum.h>
+#include <pxr/imaging/hd/extentSchema.h>
+#include <pxr/imaging/hd/retainedDataSource.h>
+#include <pxr/imaging/hd/retainedSceneIndex.h>
+#include <pxr/imaging/hd/tokens.h>
+#include <pxr/imaging/hd/xformSchema.h>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <string>
+
+PXR_NAMESPACE_USING_DIRECTIVE
+
+using Fvp::PrimBoundsIndex;
+
+namespace {
+
+// Unit cube mesh translated to the argument position.
+HdRetainedSceneIndex::AddedPrimEntry meshEntry(const char* path, const GfVec3d& position)
+{
+    GfMatrix4d matrix(1.0);
+    matrix.SetTranslate(position);
+    return { SdfPath(path),
+             HdPrimTypeTokens->mesh,
+             HdRetainedContainerDataSource::New(
+                 HdXformSchema::GetSchemaToken(),
+                 HdXformSchema::Builder()
+                     .SetMatrix(HdRetainedTypedSampledDataSource<GfMatrix4d>::New(matrix))
+                     .Build(),
+                 HdExtentSchema::GetSchemaToken(),
+                 HdExtentSchema::Builder()
+                     .SetMin(HdRetainedTypedSampledDataSource<GfVec3d>::New(GfVec3d(-0.5)))
+                     .SetMax(HdRetainedTypedSampledDataSource<GfVec3d>::New(GfVec3d(0.5)))
+                     .Build()) };
+}
+
+// Camera at the origin looking down -Z, with a 90 degrees field of view.
+GfMatrix4d worldToClip()
+{
+    GfFrustum frustum;
+    frustum.SetPerspective(90.0, 1.0, 1.0, 100.0);
+    return frustum.ComputeViewMatrix() * frustum.ComputeProjectionMatrix();
+}
+
+SdfPathVector sorted(SdfPathVector paths)
+{
+    std::sort(paths.begin(), paths.end());
+    return paths;
+}
+
+} // namespace
+
+TEST(PrimBoundsIndex, frustumTest)
+{
+    const GfMatrix4d identity(1.0);
+    EXPECT_TRUE(PrimBoundsIndex::BoundsMayIntersectFrustum(GfRange3d(GfVec3d(-0.5), GfVec3d(0.5)), identity));
+    EXPECT_TRUE(PrimBoundsIndex::BoundsMayIntersectFrustum(GfRange3d(GfVec3d(-2.0), GfVec3d(2.0)), identity));
+    EXPECT_FALSE(PrimBoundsIndex::BoundsMayIntersectFrustum(GfRange3d(GfVec3d(2.0), GfVec3d(3.0)), identity));
+    EXPECT_FALSE(PrimBoundsIndex::BoundsMayIntersectFrustum(GfRange3d(), identity));
+
+    const GfMatrix4d perspective = worldToClip();
+    // In front of the camera.
+    EXPECT_TRUE(PrimBoundsIndex::BoundsMayIntersectFrustum(GfRange3d(GfVec3d(-1, -1, -11), GfVec3d(1, 1, -9)), perspective));
+    // Behind the camera.
+    EXPECT_FALSE(PrimBoundsIndex::BoundsMayIntersectFrustum(GfRange3d(GfVec3d(-1, -1, 9), GfVec3d(1, 1, 11)), perspective));
+    // Beside the frustum.
+    EXPECT_FALSE(PrimBoundsIndex::BoundsMayIntersectFrustum(GfRange3d(GfVec3d(20, -1, -11), GfVec3d(22, 1, -9)), perspective));
+    // Beyond the far plane.
+    EXPECT_FALSE(PrimBoundsIndex::BoundsMayIntersectFrustum(GfRange3d(GfVec3d(-1, -1, -201), GfVec3d(1, 1, -199)), perspective));
+}
+
+TEST(PrimBoundsIndex, candidatePrims)
+{
+    auto sceneIndex = HdRetainedSceneIndex::New();
+    sceneIndex->AddPrims({ meshEntry("/a/inFront", GfVec3d(0, 0, -10)),
+                           meshEntry("/a/behind", GfVec3d(0, 0, 10)),
+                           { SdfPath("/a/noExtent"), HdPrimTypeTokens->mesh, HdRetainedContainerDataSource::New() },
+                           { SdfPath("/light"), HdPrimTypeTokens->sphereLight, HdRetainedContainerDataSource::New() } });
+    // Enough prims beside the frustum for the hierarchy to have several levels.
+    for (int i = 0; i < 32; ++i) {
+        const std::string path = "/b/mesh" + std::to_string(i);
+        sceneIndex->AddPrims({ meshEntry(path.c_str(), GfVec3d(100 + i, 0, -10)) });
+    }
+
+    auto index = PrimBoundsIndex::New(
+        sceneIndex, [](const TfToken& primType) { return primType == HdPrimTypeTokens->mesh; });
+
+    SdfPathVector candidates;
+    EXPECT_TRUE(index->GetCandidatePrims(worldToClip(), candidates));
+    EXPECT_EQ(sorted(candidates), SdfPathVector({ SdfPath("/a/inFront"), SdfPath("/a/noExtent") }));
+
+    // Prims moved by being added again.
+    sceneIndex->AddPrims({ meshEntry("/a/behind", GfVec3d(0, 0, -20)), meshEntry("/a/inFront", GfVec3d(0, 0, 20)) });
+    EXPECT_TRUE(index->GetCandidatePrims(worldToClip(), candidates));
+    EXPECT_EQ(sorted(candidates), SdfPathVector({ SdfPath("/a/behind"), SdfPath("/a/noExtent") }));
+
+    // Removing a prim removes its descendants.
+    sceneIndex->RemovePrims({ SdfPath("/a") });
+    EXPECT_TRUE(index->GetCandidatePrims(worldToClip(), candidates));
+    EXPECT_TRUE(candidates.empty());
+
+    // Prim moved into the frustum.
+    sceneIndex->AddPrims({ meshEntry("/b/mesh0", GfVec3d(0, 0, -10)) });
+    EXPECT_TRUE(index->GetCandidatePrims(worldToClip(), candidates));
+    EXPECT_EQ(candidates, SdfPathVector({ SdfPath("/b/mesh0") }));
+
+    // No filtering when all the prims are in view.
+    GfMatrix4d zoomOut(1.0);
+    zoomOut.SetScale(0.001);
+    EXPECT_FALSE(index->GetCandidatePrims(zoomOut, candidates));
+    EXPECT_TRUE(candidates.empty());
+}
+
+TEST(PrimBoundsIndex, maxCandidatesRatio)
+{
+    // Half of the prims in the frustum.
+    auto sceneIndex = HdRetainedSceneIndex::New();
+    for (int i = 0; i < 10; ++i) {
+        const std::string inFront = "/inFront" + std::to_string(i);
+        const std::string beside = "/beside" + std::to_string(i);
+        sceneIndex->AddPrims({ meshEntry(inFront.c_str(), GfVec3d(0, 0, -10 - i)),
+                               meshEntry(beside.c_str(), GfVec3d(100 + i, 0, -10)) });
+    }
+
+    auto index = PrimBoundsIndex::New(
+        sceneIndex, [](const TfToken& primType) { return primType == HdPrimTypeTokens->mesh; });
+
+    const double defaultRatio = PrimBoundsIndex::GetMaxCandidatesRatio();
+
+    SdfPathVector candidates;
+    PrimBoundsIndex::SetMaxCandidatesRatio(0.5);
+    EXPECT_TRUE(index->GetCandidatePrims(worldToClip(), candidates));
+    EXPECT_EQ(candidates.size(), 10u);
+
+    // Too many candidates : all the prims are used.
+    PrimBoundsIndex::SetMaxCandidatesRatio(0.25);
+    EXPECT_FALSE(index->GetCandidatePrims(worldToClip(), candidates));
+    EXPECT_TRUE(candidates.empty());
+
+    PrimBoundsIndex::SetMaxCandidatesRatio(defaultRatio);
+}
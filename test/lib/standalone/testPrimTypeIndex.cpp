@@ -0,0 +1,85 @@
+//
+// Copyright 2024 Autodesk
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include <flowViewport/sceneIndex/fvpPrimTypeIndex.h>
+
+#include <pxr/imaging/hd/retainedDataSource.h>
+#include <pxr/imaging/hd/retainedSceneIndex.h>
+#include <pxr/imaging/hd/tokens.h>
+
+#include <gtest/gtest.h>
+
+PXR_NAMESPACE_USING_DIRECTIVE
+
+using Fvp::PrimTypeIndex;
+
+namespace {
+
+HdRetainedSceneIndex::AddedPrimEntry primEntry(const char* path, const TfToken& primType)
+{
+    return { SdfPath(path), primType, HdRetainedContainerDataSource::New() };
+}
+
+SdfPathVector indexedPaths(PrimTypeIndex& index, const HdSceneIndexBaseRefPtr& sceneIndex)
+{
+    SdfPathVector paths;
+    for (const auto& primType : index.GetPrims(sceneIndex)) {
+        paths.push_back(primType.first);
+    }
+    return paths;
+}
+
+} // namespace
+
+TEST(PrimTypeIndex, incrementalUpdates)
+{
+    auto sceneIndex = HdRetainedSceneIndex::New();
+    sceneIndex->AddPrims({ primEntry("/a", TfToken()),
+                           primEntry("/a/mesh1", HdPrimTypeTokens->mesh),
+                           primEntry("/a/light", HdPrimTypeTokens->sphereLight),
+                           primEntry("/b/mesh2", HdPrimTypeTokens->mesh) });
+
+    PrimTypeIndex index([](const TfToken& primType) { return primType == HdPrimTypeTokens->mesh; });
+
+    // Notifications received before the first query are covered by the
+    // initial traversal.
+    index.PrimsAdded({ { SdfPath("/a/mesh1"), HdPrimTypeTokens->mesh } });
+    EXPECT_FALSE(index.IsPopulated());
+    EXPECT_EQ(
+        indexedPaths(index, sceneIndex), SdfPathVector({ SdfPath("/a/mesh1"), SdfPath("/b/mesh2") }));
+    EXPECT_TRUE(index.IsPopulated());
+
+    // Added prims, including a prim added again with another type.
+    index.PrimsAdded({ { SdfPath("/a/mesh3"), HdPrimTypeTokens->mesh },
+                       { SdfPath("/b/mesh2"), HdPrimTypeTokens->basisCurves },
+                       { SdfPath("/c"), HdPrimTypeTokens->material } });
+    EXPECT_EQ(
+        indexedPaths(index, sceneIndex), SdfPathVector({ SdfPath("/a/mesh1"), SdfPath("/a/mesh3") }));
+
+    // Removing a prim removes its descendants, but not its siblings with a
+    // common name prefix.
+    index.PrimsAdded({ { SdfPath("/ab/mesh4"), HdPrimTypeTokens->mesh } });
+    index.PrimsRemoved({ { SdfPath("/a") } });
+    EXPECT_EQ(indexedPaths(index, sceneIndex), SdfPathVector({ SdfPath("/ab/mesh4") }));
+
+    const HdDataSourceLocatorSet locators { HdDataSourceLocator(TfToken("displayStyle")) };
+    const auto entries = index.GetDirtiedEntries(sceneIndex, locators);
+    ASSERT_EQ(entries.size(), 1u);
+    EXPECT_EQ(entries[0].primPath, SdfPath("/ab/mesh4"));
+    EXPECT_EQ(entries[0].dirtyLocators, locators);
+    EXPECT_TRUE(index.GetDirtiedEntries(sceneIndex, locators, [](const SdfPath&) { return false; })
+                    .empty());
+}
@@ -0,0 +1,205 @@
+//
+// Copyright 2024 Autodesk
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include <flowViewport/selection/fvpSelection.h>
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <string>
+
+PXR_NAMESPACE_USING_DIRECTIVE
+
+using Fvp::PrimSelection;
+using Fvp::PrimSelections;
+using Fvp::Selection;
+
+namespace {
+
+// 100 sets of 10 groups of 100 leaves : 100k selected leaves.
+constexpr int kNbSets = 100;
+constexpr int kNbGroups = 10;
+constexpr int kNbLeaves = 100;
+
+SdfPath leafPath(int set, int group, int leaf)
+{
+    return SdfPath("/Stage/Set" + std::to_string(set) + "/Group" + std::to_string(group)
+                   + "/Leaf" + std::to_string(leaf));
+}
+
+double timeMs(const std::function<void()>& f)
+{
+    const auto                                      start = std::chrono::steady_clock::now();
+    f();
+    const std::chrono::duration<double, std::milli> elapsed
+        = std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+}
+
+} // namespace
+
+TEST(Selection, hierarchyQueries)
+{
+    Selection selection;
+    EXPECT_FALSE(selection.HasAncestorOrDescendantInclusive(SdfPath("/a")));
+
+    selection.Add({ SdfPath("/a/b"), {} });
+    selection.Add({ SdfPath("/a/b/c/d"), {} });
+    selection.Add({ SdfPath("/e"), {} });
+
+    EXPECT_TRUE(selection.IsFullySelected(SdfPath("/a/b")));
+    EXPECT_FALSE(selection.IsFullySelected(SdfPath("/a")));
+    EXPECT_FALSE(selection.IsFullySelected(SdfPath("/a/b/c")));
+
+    EXPECT_TRUE(selection.HasFullySelectedAncestorInclusive(SdfPath("/a/b/c")));
+    EXPECT_FALSE(selection.HasFullySelectedAncestorInclusive(SdfPath("/a/x")));
+    EXPECT_FALSE(
+        selection.HasFullySelectedAncestorInclusive(SdfPath("/a/b/c"), SdfPath("/a/b/c")));
+    EXPECT_EQ(
+        selection.FindFullySelectedAncestorsInclusive(SdfPath("/a/b/c/d/f")),
+        SdfPathVector({ SdfPath("/a/b"), SdfPath("/a/b/c/d") }));
+
+    EXPECT_TRUE(selection.HasDescendantInclusive(SdfPath("/a")));
+    EXPECT_TRUE(selection.HasDescendantInclusive(SdfPath("/a/b/c")));
+    EXPECT_FALSE(selection.HasDescendantInclusive(SdfPath("/a/x")));
+
+    // An ancestor which is not the closest preceding path in sorted order.
+    EXPECT_TRUE(selection.HasAncestorOrDescendantInclusive(SdfPath("/a/b/z")));
+    EXPECT_FALSE(selection.HasAncestorOrDescendantInclusive(SdfPath("/b")));
+
+    // Removing a path keeps the ancestors which still have selected descendants.
+    EXPECT_TRUE(selection.Remove({ SdfPath("/a/b"), {} }));
+    EXPECT_FALSE(selection.HasFullySelectedAncestorInclusive(SdfPath("/a/b/c")));
+    EXPECT_TRUE(selection.HasDescendantInclusive(SdfPath("/a/b")));
+
+    selection.RemoveHierarchy(SdfPath("/a"));
+    EXPECT_FALSE(selection.HasDescendantInclusive(SdfPath("/a")));
+    EXPECT_TRUE(selection.HasDescendantInclusive(SdfPath("/e")));
+    EXPECT_EQ(selection.GetFullySelectedPaths(), SdfPathVector({ SdfPath("/e") }));
+
+    selection.Remove({ SdfPath("/e"), {} });
+    EXPECT_TRUE(selection.IsEmpty());
+    EXPECT_FALSE(selection.HasDescendantInclusive(SdfPath::AbsoluteRootPath()));
+}
+
+TEST(Selection, benchmark)
+{
+    PrimSelections primSelections;
+    for (int set = 0; set < kNbSets; ++set) {
+        for (int group = 0; group < kNbGroups; ++group) {
+            for (int leaf = 0; leaf < kNbLeaves; ++leaf) {
+                primSelections.push_back({ leafPath(set, group, leaf), {} });
+            }
+        }
+    }
+
+    Selection  selection;
+    const double replaceMs = timeMs([&]() { selection.Replace(primSelections); });
+    EXPECT_EQ(selection.GetFullySelectedPaths().size(), primSelections.size());
+
+    // Query every selected prim, as the wireframe highlight and isolate select
+    // scene indices do, and a child of each of them.
+    size_t       nbAncestors = 0;
+    const double ancestorsMs = timeMs([&]() {
+        for (const auto& primSelection : primSelections) {
+            const SdfPath child = primSelection.primPath.AppendChild(TfToken("Mesh"));
+            nbAncestors += selection.HasFullySelectedAncestorInclusive(child) ? 1 : 0;
+            nbAncestors += selection.FindFullySelectedAncestorsInclusive(child).size();
+        }
+    });
+    EXPECT_EQ(nbAncestors, 2 * primSelections.size());
+
+    size_t       nbRelated = 0;
+    const double descendantsMs = timeMs([&]() {
+        for (int set = 0; set < kNbSets; ++set) {
+            for (int group = 0; group < kNbGroups; ++group) {
+                nbRelated += selection.HasAncestorOrDescendantInclusive(
+                                 SdfPath("/Stage/Set" + std::to_string(set) + "/Group"
+                                         + std::to_string(group)))
+                    ? 1
+                    : 0;
+            }
+        }
+    });
+    EXPECT_EQ(nbRelated, size_t(kNbSets * kNbGroups));
+
+    const double removeMs = timeMs([&]() {
+        for (int set = 0; set < kNbSets; set += 2) {
+            selection.RemoveHierarchy(SdfPath("/Stage/Set" + std::to_string(set)));
+        }
+    });
+    EXPECT_EQ(selection.GetFullySelectedPaths().size(), primSelections.size() / 2);
+    EXPECT_FALSE(selection.HasDescendantInclusive(SdfPath("/Stage/Set0")));
+    EXPECT_TRUE(selection.HasDescendantInclusive(SdfPath("/Stage/Set1")));
+
+    // Timings are reported, not asserted on, as they depend on the machine.
+    std::cout << "Selection of " << primSelections.size() << " paths : replace " << replaceMs
+              << " ms, " << 2 * primSelections.size() << " ancestor queries " << ancestorsMs
+              << " ms, " << kNbSets * kNbGroups << " ancestor or descendant queries "
+              << descendantsMs << " ms, remove half " << removeMs << " ms" << std::endl;
+}
+
+TEST(Selection, findChangedPaths)
+{
+    const SdfPath a("/a"), b("/b"), c("/c"), d("/d");
+
+    Selection from;
+    from.Add({ a, {} });
+    from.Add({ b, {} });
+    from.Add({ c, { { SdfPath("/instancer"), 0, { 1 } } } });
+
+    Selection to;
+    to.Add({ b, {} });
+    to.Add({ c, { { SdfPath("/instancer"), 0, { 2 } } } });
+    to.Add({ d, {} });
+
+    // b is unchanged, the instances selected under c have changed.
+    EXPECT_EQ(Selection::FindChangedPaths(from, to), SdfPathVector({ a, c, d }));
+    EXPECT_EQ(Selection::FindChangedPaths(to, from), SdfPathVector({ a, c, d }));
+    EXPECT_TRUE(Selection::FindChangedPaths(from, from).empty());
+    EXPECT_EQ(Selection::FindChangedPaths(Selection(), to), to.GetFullySelectedPaths());
+}
+
+TEST(Selection, replaceNotificationsBenchmark)
+{
+    // Shift-add one object to a 20k objects selection.
+    constexpr int  kNbSelected = 20000;
+    PrimSelections primSelections;
+    for (int i = 0; i < kNbSelected; ++i) {
+        primSelections.push_back({ leafPath(i / 1000, 0, i % 1000), {} });
+    }
+    Selection from;
+    from.Replace(primSelections);
+    primSelections.push_back({ SdfPath("/Stage/Added"), {} });
+    Selection to;
+    to.Replace(primSelections);
+
+    // Dirtying the previous and the new selection entirely, as replacing the
+    // selection used to, versus dirtying only the changed paths.
+    const size_t nbFullNotifications
+        = from.GetFullySelectedPaths().size() + to.GetFullySelectedPaths().size();
+    SdfPathVector changedPaths;
+    const double  diffMs
+        = timeMs([&]() { changedPaths = Selection::FindChangedPaths(from, to); });
+    EXPECT_EQ(changedPaths, SdfPathVector({ SdfPath("/Stage/Added") }));
+
+    std::cout << "Shift-add to a selection of " << kNbSelected << " paths : "
+              << nbFullNotifications << " dirtied prims for a full replace, "
+              << changedPaths.size() << " for a differential replace (" << diffMs << " ms)"
+              << std::endl;
+}